@@ -0,0 +1,360 @@
+/***************************************************************
+**
+** NanoKit Benchmark Source File
+**
+** File         :  nanowin_bench.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - synthetic event storms through
+**                 the headless backend, reported as JSON
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (1280.0f)
+#define WINDOW_HEIGHT       (800.0f)
+#define TREE_FANOUT         (4U)        /* children per view in the generated trees */
+
+#define MOVE_COUNT          (4096U)
+#define MOVE_BURST          (8U)        /* moves arriving between two pumps, as from a fast mouse */
+#define CLICK_COUNT         (1024U)
+#define WHEEL_COUNT         (2048U)
+#define WHEEL_BURST         (8U)
+#define RESIZE_COUNT        (512U)
+#define RESIZE_BURST        (4U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    STORM_MOVES,
+    STORM_CLICKS,
+    STORM_WHEEL,
+    STORM_RESIZE,
+    STORM_COUNT
+} nkStorm_t;
+
+/* events waiting for the pump that dispatches them, with when they were injected */
+typedef struct
+{
+    double *injected;
+    double *latencies;
+    uint32_t pending;
+    uint32_t count;
+    uint32_t capacity;
+} nkLatencies_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const char *stormNames[STORM_COUNT] = { "moves", "clicks", "wheel", "resize" };
+static const uint32_t treeSizes[] = { 10U, 100U, 1000U, 10000U, 100000U };
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkView_t *CreateTree(uint32_t count);
+static void RunStorm(nkWindow_t *window, nkStorm_t storm, bool last);
+static void Inject(nkWindow_t *window, nkLatencies_t *latencies, nkEvent_t event);
+static void Pump(nkLatencies_t *latencies);
+static double GetPercentile(const double *sorted, uint32_t count, uint32_t percentile);
+static int CompareSamples(const void *a, const void *b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    uint32_t treeCount = sizeof(treeSizes) / sizeof(treeSizes[0]);
+
+    printf("{\n  \"backend\": \"headless\",\n  \"trees\": [\n");
+
+    for (uint32_t i = 0; i < treeCount; i++)
+    {
+        nkWindow_t window;
+        nkView_t *views = CreateTree(treeSizes[i]);
+
+        memset(&window, 0, sizeof(window));
+
+        if (views == NULL || !nkWindow_Create(&window, "nanowin_bench", WINDOW_WIDTH, WINDOW_HEIGHT))
+        {
+            fprintf(stderr, "Failed to set up a window with %u views!\n", treeSizes[i]);
+            free(views);
+            return EXIT_FAILURE;
+        }
+
+        window.rootView = &views[0];
+
+        nkWindow_PollEvents(); /* the first layout and frame, so the storms start from a settled window */
+
+        printf("    {\n      \"views\": %u,\n      \"storms\": [\n", treeSizes[i]);
+
+        for (uint32_t storm = 0; storm < STORM_COUNT; storm++)
+        {
+            RunStorm(&window, (nkStorm_t)storm, storm + 1U == STORM_COUNT);
+        }
+
+        printf("      ]\n    }%s\n", (i + 1U < treeCount) ? "," : "");
+
+        nkWindow_Destroy(&window);
+        free(views);
+    }
+
+    printf("  ]\n}\n");
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkView_t *CreateTree(uint32_t count)
+{
+    nkView_t *views = calloc(count, sizeof(nkView_t));
+
+    if (views == NULL)
+    {
+        return NULL;
+    }
+
+    views[0].frame = (nkRect_t){ 0.0f, 0.0f, WINDOW_WIDTH, WINDOW_HEIGHT };
+
+    /* breadth first, so the children of view p are TREE_FANOUT consecutive views and each
+       parent is filled in before its children. Each child takes a strip of its parent's frame */
+    for (uint32_t i = 1; i < count; i++)
+    {
+        nkView_t *parent = &views[(i - 1U) / TREE_FANOUT];
+        nkView_t *view = &views[i];
+        uint32_t index = (i - 1U) % TREE_FANOUT;
+        nkRect_t frame = parent->frame;
+
+        if (frame.width >= frame.height)
+        {
+            frame.width /= (float)TREE_FANOUT;
+            frame.x += frame.width * (float)index;
+        }
+        else
+        {
+            frame.height /= (float)TREE_FANOUT;
+            frame.y += frame.height * (float)index;
+        }
+
+        view->frame = frame;
+        view->parent = parent;
+
+        if (index == 0)
+        {
+            parent->child = view;
+        }
+        else
+        {
+            views[i - 1U].sibling = view;
+        }
+    }
+
+    return views;
+}
+
+static void RunStorm(nkWindow_t *window, nkStorm_t storm, bool last)
+{
+    uint32_t counts[STORM_COUNT] = { MOVE_COUNT, CLICK_COUNT * 2U, WHEEL_COUNT, RESIZE_COUNT };
+    nkLatencies_t latencies = { 0 };
+
+    latencies.capacity = counts[storm];
+    latencies.injected = malloc(latencies.capacity * sizeof(double));
+    latencies.latencies = malloc(latencies.capacity * sizeof(double));
+
+    if (latencies.injected == NULL || latencies.latencies == NULL)
+    {
+        fprintf(stderr, "Failed to allocate %u latency samples!\n", latencies.capacity);
+        exit(EXIT_FAILURE);
+    }
+
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* a fixed seed, so every run replays the same storm */
+    uint32_t seed = 0x2545F491U;
+    double start = nkWindow_GetTime();
+
+    switch (storm)
+    {
+        case STORM_MOVES:
+        {
+            /* a diagonal sweep back and forth across the window */
+            for (uint32_t i = 0; i < MOVE_COUNT; i++)
+            {
+                float t = (float)(i % 1024U) / 1023.0f;
+
+                Inject(window, &latencies, (nkEvent_t){
+                    .type = NK_EVENT_POINTER_MOVE,
+                    .pointer = { t * (WINDOW_WIDTH - 1.0f), t * (WINDOW_HEIGHT - 1.0f) }
+                });
+
+                if ((i + 1U) % MOVE_BURST == 0)
+                {
+                    Pump(&latencies);
+                }
+            }
+        } break;
+
+        case STORM_CLICKS:
+        {
+            /* each click lands somewhere new, pressed and released a pump apart */
+            for (uint32_t i = 0; i < CLICK_COUNT; i++)
+            {
+                seed = seed * 1664525U + 1013904223U;
+                float x = (float)(seed >> 16) / 65536.0f * WINDOW_WIDTH;
+                seed = seed * 1664525U + 1013904223U;
+                float y = (float)(seed >> 16) / 65536.0f * WINDOW_HEIGHT;
+
+                Inject(window, &latencies, (nkEvent_t){
+                    .type = NK_EVENT_POINTER_ACTION_BEGIN,
+                    .pointerAction = { NK_POINTER_ACTION_PRIMARY, x, y }
+                });
+                Pump(&latencies);
+
+                Inject(window, &latencies, (nkEvent_t){
+                    .type = NK_EVENT_POINTER_ACTION_END,
+                    .pointerAction = { NK_POINTER_ACTION_PRIMARY, x, y }
+                });
+                Pump(&latencies);
+            }
+        } break;
+
+        case STORM_WHEEL:
+        {
+            for (uint32_t i = 0; i < WHEEL_COUNT; i++)
+            {
+                Inject(window, &latencies, (nkEvent_t){
+                    .type = NK_EVENT_SCROLL,
+                    .scroll = { 0.0f, (i % 256U < 128U) ? 1.0f : -1.0f }
+                });
+
+                if ((i + 1U) % WHEEL_BURST == 0)
+                {
+                    Pump(&latencies);
+                }
+            }
+        } break;
+
+        case STORM_RESIZE:
+        {
+            /* dragging the corner out and back in a pixel at a time */
+            for (uint32_t i = 0; i < RESIZE_COUNT; i++)
+            {
+                float step = (float)((i < RESIZE_COUNT / 2U) ? i : RESIZE_COUNT - i);
+
+                Inject(window, &latencies, (nkEvent_t){
+                    .type = NK_EVENT_RESIZE,
+                    .resize = { WINDOW_WIDTH + step, WINDOW_HEIGHT + step }
+                });
+
+                if ((i + 1U) % RESIZE_BURST == 0)
+                {
+                    Pump(&latencies);
+                }
+            }
+        } break;
+
+        default:
+        {
+            /* no storm */
+        } break;
+    }
+
+    Pump(&latencies);
+
+    double seconds = nkWindow_GetTime() - start;
+
+    nkWindow_GetStats(window, &after);
+
+    qsort(latencies.latencies, latencies.count, sizeof(double), CompareSamples);
+
+    double events = (double)latencies.count;
+    double layouts = (double)(after.layoutsPerformed - before.layoutsPerformed);
+    double frames = (double)(after.framesRendered - before.framesRendered);
+
+    printf("        {\n");
+    printf("          \"storm\": \"%s\",\n", stormNames[storm]);
+    printf("          \"events\": %u,\n", latencies.count);
+    printf("          \"seconds\": %.6f,\n", seconds);
+    printf("          \"eventsPerSecond\": %.1f,\n", events / seconds);
+    printf("          \"layoutsPerSecond\": %.1f,\n", layouts / seconds);
+    printf("          \"framesPerSecond\": %.1f,\n", frames / seconds);
+    printf("          \"latencyMicroseconds\": { \"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f }\n",
+        GetPercentile(latencies.latencies, latencies.count, 50U) * 1e6,
+        GetPercentile(latencies.latencies, latencies.count, 95U) * 1e6,
+        GetPercentile(latencies.latencies, latencies.count, 99U) * 1e6
+    );
+    printf("        }%s\n", last ? "" : ",");
+
+    free(latencies.injected);
+    free(latencies.latencies);
+}
+
+static void Inject(nkWindow_t *window, nkLatencies_t *latencies, nkEvent_t event)
+{
+    latencies->injected[latencies->pending++] = nkWindow_GetTime();
+
+    nkWindow_InjectEvent(window, &event);
+}
+
+static void Pump(nkLatencies_t *latencies)
+{
+    nkWindow_PollEvents();
+
+    /* an event's latency runs from its injection to the end of the frame that showed it */
+    double now = nkWindow_GetTime();
+
+    for (uint32_t i = 0; i < latencies->pending; i++)
+    {
+        latencies->latencies[latencies->count++] = now - latencies->injected[i];
+    }
+
+    latencies->pending = 0;
+}
+
+static double GetPercentile(const double *sorted, uint32_t count, uint32_t percentile)
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+
+    /* nearest rank, as nkWindow_GetFrameStats */
+    return sorted[(count * percentile + 99U) / 100U - 1U];
+}
+
+static int CompareSamples(const void *a, const void *b)
+{
+    double left = *(const double *)a;
+    double right = *(const double *)b;
+
+    return (left > right) - (left < right);
+}
@@ -0,0 +1,668 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nanowin.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - headless backend
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanowin.h>
+#include <nanodraw.h>
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static bool initialized = false;
+
+/* false when no EGL implementation is usable, in which case only dispatch and layout run */
+static bool glAvailable = false;
+
+/* set by nkWindow_EnableInputThread, windows created afterwards queue injected events */
+static bool inputQueued = false;
+
+/* set by nkWindow_EnableRenderThreads, windows created afterwards render on a thread each */
+static bool renderThreaded = false;
+
+/* set by nkWindow_EnableSharedContexts, every window's context is in one share group */
+static bool contextsShared = false;
+
+static nkWindow_t *windowList = NULL;
+
+/* the window nkWindow_PollEvents visits next, stepped past a window nkWindow_Destroy unlinks meanwhile */
+static nkWindow_t *pollNext = NULL;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool ResizeFramebuffer(nkWindow_t *window, uint32_t width, uint32_t height);
+static void PaintWindow(nkWindow_t *window, nkWindowDamage_t *damage);
+static void ReadFramebuffer(nkWindow_t *window);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float height)
+{
+    /* setup EGL the first time this is run */
+    if (!initialized)
+    {
+        glAvailable = nkOffscreen_Init();
+
+        nkWakeup_Init();
+
+        initialized = true;
+    }
+
+    window->eglSurface = EGL_NO_SURFACE;
+    window->eglContext = EGL_NO_CONTEXT;
+    window->framebuffer = NULL;
+    window->framebufferWidth = 0;
+    window->framebufferHeight = 0;
+
+    if (!ResizeFramebuffer(window, (uint32_t)width, (uint32_t)height))
+    {
+        fprintf(stderr, "Failed to allocate a %.0f x %.0f framebuffer!\n", width, height);
+        return false;
+    }
+
+    if (glAvailable)
+    {
+        if (!nkOffscreen_CreateTarget(window, window->framebufferWidth, window->framebufferHeight))
+        {
+            return false;
+        }
+
+        if (contextsShared)
+        {
+            nkSharedDraw_Acquire(&window->drawContext);
+        }
+        else
+        {
+            nkDraw_CreateContext(&window->drawContext);
+        }
+    }
+
+    /* populate the window contents */
+    window->next = NULL;
+    window->destroyed = false;
+    window->title = title;
+    window->rootView = NULL;
+    window->hotView = NULL;
+    window->activeView = NULL;
+    window->delegate = NULL;
+    window->userData = NULL;
+    window->width = width;
+    window->height = height;
+    window->visibility = NK_WINDOW_VISIBILITY_VISIBLE;
+    window->focus = NK_WINDOW_FOCUS_FOCUSED;
+    window->cursorType = NK_CURSOR_ARROW; /* default cursor type */
+    window->backgroundColor = NK_COLOR_WHITE; /* default background color */
+    window->framebufferStale = false;
+    window->partialRedraw = glAvailable; /* the pbuffer keeps its contents between frames */
+    window->redrawRequested = true;
+    window->layoutDirty = true;
+    window->layoutSize = (nkSize_t){ 0.0f, 0.0f };
+    window->layoutGeneration = 0;
+    window->hotViewLayout = 0;
+    window->hotBounds = (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+    window->damage.full = true;
+    window->damage.count = 0;
+    window->swapInterval = NK_SWAP_INTERVAL_ON; /* left to the driver until set */
+    window->swapIntervalChanged = false;
+    window->maxFrameRate = 0.0f;
+    window->nextPresent = 0;
+    window->pointerActionState = 0;
+    memset(window->keyState, 0, sizeof(window->keyState));
+    memset(&window->frameTiming, 0, sizeof(window->frameTiming));
+    window->metrics = NULL;
+    window->pendingInput.type = NK_EVENT_NONE;
+    window->inputRing = inputQueued ? nkEventRing_Create() : NULL;
+    window->recording = NULL;
+    window->replay = NULL;
+    window->viewIndex = NULL;
+    window->renderThread = NULL;
+    window->postQueue = nkPostQueue_Create();
+
+    if (window->postQueue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate the posted event queue!\n");
+        return false;
+    }
+
+    if (renderThreaded && glAvailable)
+    {
+        /* the render thread takes the context over, so it cannot stay current here */
+        nkOffscreen_ReleaseCurrent();
+
+        window->renderThread = nkRenderThread_Create(window);
+
+        if (window->renderThread == NULL)
+        {
+            fprintf(stderr, "Failed to start a render thread, rendering inline.\n");
+        }
+    }
+
+    /* add this window to the linked list */
+    if (windowList == NULL)
+    {
+        windowList = window;
+    }
+    else
+    {
+        nkWindow_t *current = windowList;
+        while (current->next != NULL)
+        {
+            current = current->next;
+        }
+        current->next = window;
+    }
+
+    return true;
+}
+
+void nkWindow_SetTitle(nkWindow_t *window, const char *title)
+{
+    if (window == NULL || title == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->title = title; /* update the title in the window struct */
+}
+
+void nkWindow_SetSize(nkWindow_t *window, float width, float height)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_RESIZE,
+        .resize = { width, height }
+    };
+
+    /* the caller is the UI thread, the input ring belongs to the injecting thread */
+    nkWindow_ApplyEvent(window, &event);
+}
+
+void nkWindow_SetVisibility(nkWindow_t *window, nkWindowVisibility_t visibility)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_VISIBILITY_CHANGE,
+        .visibility = visibility
+    };
+
+    nkWindow_ApplyEvent(window, &event);
+}
+
+void nkWindow_SetFocus(nkWindow_t *window, nkWindowFocus_t focus)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_FOCUS_CHANGE,
+        .focus = focus
+    };
+
+    nkWindow_ApplyEvent(window, &event);
+}
+
+void nkWindow_SetCursor(nkWindow_t *window, nkCursorType_t cursorType)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->cursorType = cursorType; /* no cursor to show, just record it */
+}
+
+void nkWindow_Destroy(nkWindow_t *window)
+{
+    if (window == NULL || window->destroyed)
+    {
+        return; /* nothing to do */
+    }
+
+    window->destroyed = true;
+
+    const nkWindowDelegate_t *delegate = nkWindow_GetDelegate(window);
+
+    /* call the close callback if it exists */
+    if (delegate->closeCallback)
+    {
+        delegate->closeCallback(window);
+    }
+
+    /* remove from the linked list */
+    if (windowList == window)
+    {
+        windowList = window->next;
+    }
+    else
+    {
+        nkWindow_t *prev = windowList;
+        while (prev != NULL && prev->next != window)
+        {
+            prev = prev->next;
+        }
+
+        if (prev != NULL)
+        {
+            prev->next = window->next;
+        }
+    }
+
+    if (pollNext == window)
+    {
+        pollNext = window->next;
+    }
+
+    window->next = NULL;
+
+    /* hands the render target back before it is destroyed */
+    nkRenderThread_Destroy(window->renderThread);
+    window->renderThread = NULL;
+
+    if (glAvailable)
+    {
+        nkOffscreen_DestroyTarget(window);
+
+        if (contextsShared && nkSharedDraw_Release())
+        {
+            nkOffscreen_DestroyShareGroup();
+        }
+    }
+
+    free(window->framebuffer);
+    window->framebuffer = NULL;
+
+    nkEventRing_Destroy(window->inputRing);
+    window->inputRing = NULL;
+
+    nkPostQueue_Destroy(window->postQueue);
+    window->postQueue = NULL;
+
+    nkWindow_StopRecording(window);
+    nkWindow_StopReplay(window);
+
+    nkViewIndex_Destroy(window->viewIndex);
+    window->viewIndex = NULL;
+
+    nkWindow_DestroyMetrics(window);
+}
+
+void nkWindow_ScheduleFrame(nkWindow_t *window)
+{
+    (void)window;
+
+    /* painted on the next call to nkWindow_PollEvents */
+}
+
+bool nkWindow_IsPointerActionDown(nkWindow_t *window, nkPointerAction_t action)
+{
+    return nkWindow_TestPointerActionState(window, action);
+}
+
+bool nkWindow_IsKeyDown(nkWindow_t *window, uint32_t keycode)
+{
+    return nkWindow_TestKeyState(window, keycode);
+}
+
+void nkWindow_RedrawViews(nkWindow_t *window)
+{
+    if (window == NULL || window->rootView == NULL)
+    {
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Window contains no views");
+        return;
+    }
+
+    if (!glAvailable)
+    {
+        return; /* nothing to render with */
+    }
+
+    nkOffscreen_MakeCurrent(window);
+
+    nkView_RenderTree(window->rootView, &window->drawContext);
+}
+
+bool nkWindow_PollEvents(void)
+{
+    static bool firstRun = true;
+
+    if (firstRun)
+    {
+        firstRun = false;
+
+        for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+        {
+            nkWindow_LayoutViews(current);
+        }
+    }
+
+    /* timers due by now, before the frame so what they change is drawn in it */
+    nkWindow_ServiceTimers();
+
+    /* there is no platform queue, only what was injected and queued. A callback may destroy any window,
+       so the one after is kept where nkWindow_Destroy can step past it */
+    for (nkWindow_t *current = windowList; current != NULL; current = pollNext)
+    {
+        pollNext = current->next;
+
+        if (nkWindow_DrainInput(current))
+        {
+            pollNext = current->next; /* still listed, so this also reaches a window a callback created */
+        }
+    }
+
+    for (nkWindow_t *current = windowList; current != NULL; current = pollNext)
+    {
+        pollNext = current->next;
+
+        nkWindowDamage_t damage;
+
+        if (!nkWindow_BeginFrame(current, &damage))
+        {
+            continue;
+        }
+
+        if (current->renderThread == NULL)
+        {
+            PaintWindow(current, &damage);
+        }
+        else if (!nkRenderThread_Submit(current->renderThread, &damage))
+        {
+            nkWindow_RequestRedraw(current);
+        }
+    }
+
+    pollNext = NULL;
+
+    return windowList != NULL;
+}
+
+void nkWindow_WakeEventLoop(nkWindow_t *window)
+{
+    (void)window; /* one loop wakes for every window */
+
+    nkWakeup_Signal();
+}
+
+bool nkWindow_WaitEvents(double timeoutSeconds)
+{
+    /* wake for the next timer too */
+    timeoutSeconds = nkWindow_GetTimerTimeout(timeoutSeconds);
+
+    for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+    {
+        if (current->redrawRequested)
+        {
+            return nkWindow_PollEvents(); /* work is already waiting */
+        }
+    }
+
+    /* no platform to hear from, only injected events from another thread can arrive */
+    nkWakeup_Wait(-1, timeoutSeconds);
+
+    return nkWindow_PollEvents();
+}
+
+float nkWindow_GetRefreshRate(nkWindow_t *window)
+{
+    (void)window;
+
+    return 0.0f; /* no display */
+}
+
+bool nkWindow_EnableInputThread(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    /* there is no platform to read, the caller's thread acts as the input thread instead */
+    inputQueued = true;
+
+    return true;
+}
+
+bool nkWindow_EnableRenderThreads(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    renderThreaded = true;
+
+    return true;
+}
+
+bool nkWindow_EnableSharedContexts(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    contextsShared = true;
+    nkOffscreen_ShareContexts();
+
+    return true;
+}
+
+bool nkWindow_BindRenderThread(nkWindow_t *target)
+{
+    return nkOffscreen_MakeCurrent(target);
+}
+
+void nkWindow_PresentFrame(nkWindow_t *target, nkWindowDamage_t *damage)
+{
+    PaintWindow(target, damage);
+
+    /* the context is only current on this thread, so the read back cannot wait for nkWindow_GetFramebuffer */
+    ReadFramebuffer(target);
+}
+
+void nkWindow_UnbindRenderThread(nkWindow_t *window, nkWindow_t *target)
+{
+    nkOffscreen_ReleaseCurrent();
+
+    /* resizes replaced the pbuffer and the framebuffer on the copy */
+    window->drawContext = target->drawContext;
+    window->eglSurface = target->eglSurface;
+    window->eglContext = target->eglContext;
+    window->framebuffer = target->framebuffer;
+    window->framebufferWidth = target->framebufferWidth;
+    window->framebufferHeight = target->framebufferHeight;
+    window->framebufferStale = false;
+}
+
+void nkWindow_InjectEvent(nkWindow_t *window, const nkEvent_t *event)
+{
+    if (window == NULL || event == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkEvent_t copy = *event;
+
+    nkWindow_PostInput(window, &copy);
+
+    if (window->inputRing != NULL)
+    {
+        nkWakeup_Signal(); /* queued from another thread, which may be waiting in nkWindow_WaitEvents */
+    }
+}
+
+const uint8_t *nkWindow_GetFramebuffer(nkWindow_t *window, uint32_t *width, uint32_t *height)
+{
+    if (window == NULL)
+    {
+        return NULL;
+    }
+
+    if (window->renderThread != NULL)
+    {
+        /* the last frame was read back on the render thread, into its copy of the window */
+        window = nkRenderThread_Finish(window->renderThread);
+    }
+
+    if (window->framebufferStale && glAvailable)
+    {
+        ReadFramebuffer(window);
+    }
+
+    if (width != NULL)
+    {
+        *width = window->framebufferWidth;
+    }
+
+    if (height != NULL)
+    {
+        *height = window->framebufferHeight;
+    }
+
+    return window->framebuffer;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool ResizeFramebuffer(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    width = (width > 0) ? width : 1U;
+    height = (height > 0) ? height : 1U;
+
+    if (window->framebuffer != NULL && window->framebufferWidth == width && window->framebufferHeight == height)
+    {
+        return true; /* nothing to do */
+    }
+
+    uint8_t *framebuffer = realloc(window->framebuffer, (size_t)width * height * 4U);
+
+    if (framebuffer == NULL)
+    {
+        return false;
+    }
+
+    window->framebuffer = framebuffer;
+    window->framebufferWidth = width;
+    window->framebufferHeight = height;
+
+    /* the render target is created along with the context on the first call */
+    if (window->eglContext != EGL_NO_CONTEXT && !nkOffscreen_ResizeTarget(window, width, height))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static void PaintWindow(nkWindow_t *window, nkWindowDamage_t *damage)
+{
+    if (window->framebufferWidth != (uint32_t)window->width || window->framebufferHeight != (uint32_t)window->height)
+    {
+        damage->full = true; /* a new render target starts out empty */
+    }
+
+    if (!ResizeFramebuffer(window, (uint32_t)window->width, (uint32_t)window->height))
+    {
+        fprintf(stderr, "Failed to resize the framebuffer!\n");
+        return;
+    }
+
+    if (!glAvailable)
+    {
+        /* no GL, so the best we can present is the background color */
+        uint8_t r = (uint8_t)(window->backgroundColor.r * 255.0f);
+        uint8_t g = (uint8_t)(window->backgroundColor.g * 255.0f);
+        uint8_t b = (uint8_t)(window->backgroundColor.b * 255.0f);
+        uint8_t a = (uint8_t)(window->backgroundColor.a * 255.0f);
+
+        size_t pixelCount = (size_t)window->framebufferWidth * window->framebufferHeight;
+
+        for (size_t i = 0; i < pixelCount; i++)
+        {
+            window->framebuffer[i * 4U + 0U] = r;
+            window->framebuffer[i * 4U + 1U] = g;
+            window->framebuffer[i * 4U + 2U] = b;
+            window->framebuffer[i * 4U + 3U] = a;
+        }
+
+        NK_STATS_ADD(window, framesRendered, 1U);
+
+        nkWindow_PaceFrame(window);
+
+        nkWindow_FinishFrame(window, nkWindow_GetTicks());
+
+        return;
+    }
+
+    nkOffscreen_MakeCurrent(window);
+
+    nkWindow_RenderFrame(window, damage);
+
+    /* there is no display to wait for, so the cap is all that paces frames */
+    nkWindow_PaceFrame(window);
+
+    /* the read back is left to nkWindow_GetFramebuffer, so presenting is only the flush */
+    uint64_t presentStart = nkWindow_GetTicks();
+
+    glFlush();
+
+    nkWindow_FinishFrame(window, presentStart);
+
+    window->framebufferStale = true;
+}
+
+static void ReadFramebuffer(nkWindow_t *window)
+{
+    nkOffscreen_ReadPixels(
+        window,
+        0, 0,
+        window->framebufferWidth,
+        window->framebufferHeight,
+        GL_RGBA,
+        window->framebuffer,
+        (size_t)window->framebufferWidth * 4U
+    );
+
+    window->framebufferStale = false;
+}
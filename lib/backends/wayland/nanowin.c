@@ -0,0 +1,1574 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nanowin.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - Wayland backend
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanowin.h>
+#include <nanodraw.h>
+
+#include "nanowin_internal.h"
+
+#include <xdg-shell-client-protocol.h>
+
+#include <wayland-cursor.h>
+#include <xkbcommon/xkbcommon.h>
+#include <linux/input-event-codes.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define SEAT_VERSION            (5U)    /* first version with wl_pointer.frame */
+#define COMPOSITOR_VERSION      (4U)    /* first version with wl_surface.damage_buffer */
+
+#define CURSOR_SIZE             (24)
+
+#define AXIS_UNITS_PER_STEP     (10.0f) /* wl_pointer.axis units for one wheel notch */
+
+#define OUTPUT_VERSION          (2U)    /* first version with wl_output.done */
+#define MAX_OUTPUTS             (8U)
+
+static const char *cursorNames[NK_CURSOR_SIZENS_VALUE + 1] =
+{
+    [NK_CURSOR_ARROW_VALUE]     = "left_ptr",
+    [NK_CURSOR_IBEAM_VALUE]     = "xterm",
+    [NK_CURSOR_HAND_VALUE]      = "hand2",
+    [NK_CURSOR_CROSSHAIR_VALUE] = "crosshair",
+    [NK_CURSOR_SIZEALL_VALUE]   = "fleur",
+    [NK_CURSOR_SIZENWSE_VALUE]  = "bottom_right_corner",
+    [NK_CURSOR_SIZENESW_VALUE]  = "bottom_left_corner",
+    [NK_CURSOR_SIZEWE_VALUE]    = "sb_h_double_arrow",
+    [NK_CURSOR_SIZENS_VALUE]    = "sb_v_double_arrow",
+};
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    struct wl_output *handle;
+    int32_t refresh;            /* of the current mode, in mHz */
+} nkWaylandOutput_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static bool initialized = false;
+static bool glAvailable = false;
+
+/* set by nkWindow_EnableSharedContexts, every window's context is in one share group */
+static bool contextsShared = false;
+static bool quitRequested = false;
+
+static struct wl_display *display = NULL;
+static struct wl_registry *registry = NULL;
+static struct wl_compositor *compositor = NULL;
+static struct wl_shm *shm = NULL;
+static struct xdg_wm_base *wmBase = NULL;
+static struct wl_seat *seat = NULL;
+static struct wl_pointer *pointer = NULL;
+static struct wl_keyboard *keyboard = NULL;
+static uint32_t seatVersion = 0;
+
+static struct wl_cursor_theme *cursorTheme = NULL;
+static struct wl_surface *cursorSurface = NULL;
+
+static struct xkb_context *xkbContext = NULL;
+static struct xkb_keymap *xkbKeymap = NULL;
+static struct xkb_state *xkbState = NULL;
+
+/* pointer state is accumulated between wl_pointer.frame events and dispatched once */
+static nkWindow_t *pointerWindow = NULL;
+static uint32_t pointerSerial = 0;
+static float pointerX = 0.0f;
+static float pointerY = 0.0f;
+static bool pointerMoved = false;
+static float pointerAxisX = 0.0f;
+static float pointerAxisY = 0.0f;
+static double pointerTime = 0.0;       /* of the first motion or axis event in the frame, 0 if none */
+
+static nkWindow_t *keyboardWindow = NULL;
+
+/* for nkWindow_GetRefreshRate */
+static nkWaylandOutput_t outputs[MAX_OUTPUTS];
+static uint32_t outputCount = 0;
+
+/* compositor timestamps, in milliseconds, onto our clock */
+static nkEventClock_t eventClock = {0};
+
+static nkWindow_t *windowList = NULL;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool InitWayland(void);
+
+static nkWindow_t *FindWindow(struct wl_surface *surface);
+static void RemoveWindow(nkWindow_t *window);
+
+static bool CreateBuffers(nkWindow_t *window, uint32_t width, uint32_t height);
+static void DestroyBuffers(nkWindow_t *window);
+static bool CanPaint(nkWindow_t *window);
+static void PaintWindow(nkWindow_t *window);
+static void ApplyCursor(nkWindow_t *window);
+static void FlushPointerFrame(void);
+static double GetEventTime(uint32_t time);
+
+static void RegistryGlobal(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version);
+static void RegistryGlobalRemove(void *data, struct wl_registry *registry, uint32_t name);
+static void WmBasePing(void *data, struct xdg_wm_base *wmBase, uint32_t serial);
+static void SeatCapabilities(void *data, struct wl_seat *seat, uint32_t capabilities);
+static void SeatName(void *data, struct wl_seat *seat, const char *name);
+
+static void XdgSurfaceConfigure(void *data, struct xdg_surface *xdgSurface, uint32_t serial);
+static void XdgToplevelConfigure(void *data, struct xdg_toplevel *xdgToplevel, int32_t width, int32_t height, struct wl_array *states);
+static void XdgToplevelClose(void *data, struct xdg_toplevel *xdgToplevel);
+static void BufferRelease(void *data, struct wl_buffer *buffer);
+static void FrameDone(void *data, struct wl_callback *callback, uint32_t time);
+static void SurfaceEnter(void *data, struct wl_surface *surface, struct wl_output *output);
+static void SurfaceLeave(void *data, struct wl_surface *surface, struct wl_output *output);
+
+static void OutputGeometry(void *data, struct wl_output *output, int32_t x, int32_t y, int32_t physicalWidth, int32_t physicalHeight, int32_t subpixel, const char *make, const char *model, int32_t transform);
+static void OutputMode(void *data, struct wl_output *output, uint32_t flags, int32_t width, int32_t height, int32_t refresh);
+static void OutputDone(void *data, struct wl_output *output);
+static void OutputScale(void *data, struct wl_output *output, int32_t factor);
+
+static void PointerEnter(void *data, struct wl_pointer *pointer, uint32_t serial, struct wl_surface *surface, wl_fixed_t x, wl_fixed_t y);
+static void PointerLeave(void *data, struct wl_pointer *pointer, uint32_t serial, struct wl_surface *surface);
+static void PointerMotion(void *data, struct wl_pointer *pointer, uint32_t time, wl_fixed_t x, wl_fixed_t y);
+static void PointerButton(void *data, struct wl_pointer *pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state);
+static void PointerAxis(void *data, struct wl_pointer *pointer, uint32_t time, uint32_t axis, wl_fixed_t value);
+static void PointerFrame(void *data, struct wl_pointer *pointer);
+static void PointerAxisSource(void *data, struct wl_pointer *pointer, uint32_t source);
+static void PointerAxisStop(void *data, struct wl_pointer *pointer, uint32_t time, uint32_t axis);
+static void PointerAxisDiscrete(void *data, struct wl_pointer *pointer, uint32_t axis, int32_t discrete);
+
+static void KeyboardKeymap(void *data, struct wl_keyboard *keyboard, uint32_t format, int32_t fd, uint32_t size);
+static void KeyboardEnter(void *data, struct wl_keyboard *keyboard, uint32_t serial, struct wl_surface *surface, struct wl_array *keys);
+static void KeyboardLeave(void *data, struct wl_keyboard *keyboard, uint32_t serial, struct wl_surface *surface);
+static void KeyboardKey(void *data, struct wl_keyboard *keyboard, uint32_t serial, uint32_t time, uint32_t key, uint32_t state);
+static void KeyboardModifiers(void *data, struct wl_keyboard *keyboard, uint32_t serial, uint32_t depressed, uint32_t latched, uint32_t locked, uint32_t group);
+static void KeyboardRepeatInfo(void *data, struct wl_keyboard *keyboard, int32_t rate, int32_t delay);
+
+/***************************************************************
+** MARK: LISTENERS
+***************************************************************/
+
+static const struct wl_registry_listener registryListener = {
+    .global = RegistryGlobal,
+    .global_remove = RegistryGlobalRemove
+};
+
+static const struct xdg_wm_base_listener wmBaseListener = {
+    .ping = WmBasePing
+};
+
+static const struct wl_seat_listener seatListener = {
+    .capabilities = SeatCapabilities,
+    .name = SeatName
+};
+
+static const struct xdg_surface_listener xdgSurfaceListener = {
+    .configure = XdgSurfaceConfigure
+};
+
+static const struct xdg_toplevel_listener xdgToplevelListener = {
+    .configure = XdgToplevelConfigure,
+    .close = XdgToplevelClose
+};
+
+static const struct wl_buffer_listener bufferListener = {
+    .release = BufferRelease
+};
+
+static const struct wl_callback_listener frameListener = {
+    .done = FrameDone
+};
+
+static const struct wl_surface_listener surfaceListener = {
+    .enter = SurfaceEnter,
+    .leave = SurfaceLeave
+};
+
+static const struct wl_output_listener outputListener = {
+    .geometry = OutputGeometry,
+    .mode = OutputMode,
+    .done = OutputDone,
+    .scale = OutputScale
+};
+
+static const struct wl_pointer_listener pointerListener = {
+    .enter = PointerEnter,
+    .leave = PointerLeave,
+    .motion = PointerMotion,
+    .button = PointerButton,
+    .axis = PointerAxis,
+    .frame = PointerFrame,
+    .axis_source = PointerAxisSource,
+    .axis_stop = PointerAxisStop,
+    .axis_discrete = PointerAxisDiscrete
+};
+
+static const struct wl_keyboard_listener keyboardListener = {
+    .keymap = KeyboardKeymap,
+    .enter = KeyboardEnter,
+    .leave = KeyboardLeave,
+    .key = KeyboardKey,
+    .modifiers = KeyboardModifiers,
+    .repeat_info = KeyboardRepeatInfo
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float height)
+{
+    /* setup Wayland the first time this is run */
+    if (!initialized)
+    {
+        if (!InitWayland())
+        {
+            fprintf(stderr, "Failed to connect to the Wayland compositor!\n");
+            return false;
+        }
+
+        glAvailable = nkOffscreen_Init();
+
+        nkWakeup_Init();
+
+        initialized = true;
+    }
+
+    memset(window->buffers, 0, sizeof(window->buffers));
+    window->shmPool = NULL;
+    window->shmData = NULL;
+    window->shmSize = 0;
+    window->frameCallback = NULL;
+    window->eglSurface = EGL_NO_SURFACE;
+    window->eglContext = EGL_NO_CONTEXT;
+
+    if (!CreateBuffers(window, (uint32_t)width, (uint32_t)height))
+    {
+        fprintf(stderr, "Failed to create the wl_shm buffers!\n");
+        return false;
+    }
+
+    if (glAvailable)
+    {
+        if (!nkOffscreen_CreateTarget(window, window->bufferWidth, window->bufferHeight))
+        {
+            return false;
+        }
+
+        if (contextsShared)
+        {
+            nkSharedDraw_Acquire(&window->drawContext);
+        }
+        else
+        {
+            nkDraw_CreateContext(&window->drawContext);
+        }
+    }
+
+    window->surface = wl_compositor_create_surface(compositor);
+    window->output = NULL;
+    wl_surface_add_listener(window->surface, &surfaceListener, window);
+    window->xdgSurface = xdg_wm_base_get_xdg_surface(wmBase, window->surface);
+    window->xdgToplevel = xdg_surface_get_toplevel(window->xdgSurface);
+
+    xdg_surface_add_listener(window->xdgSurface, &xdgSurfaceListener, window);
+    xdg_toplevel_add_listener(window->xdgToplevel, &xdgToplevelListener, window);
+
+    /* populate the window contents */
+    window->next = NULL;
+    window->destroyed = false;
+    window->title = title;
+    window->width = width;
+    window->height = height;
+    window->pendingWidth = width;
+    window->pendingHeight = height;
+    window->visibility = NK_WINDOW_VISIBILITY_VISIBLE;
+    window->pendingVisibility = NK_WINDOW_VISIBILITY_VISIBLE;
+    window->focus = NK_WINDOW_FOCUS_UNFOCUSED;
+    window->cursorType = NK_CURSOR_ARROW; /* default cursor type */
+    window->backgroundColor = NK_COLOR_WHITE; /* default background color */
+    window->configured = false;
+    window->closeRequested = false;
+    window->partialRedraw = glAvailable; /* the pbuffer keeps its contents between frames */
+    window->redrawRequested = true;
+    window->layoutDirty = true;
+    window->layoutSize = (nkSize_t){ 0.0f, 0.0f };
+    window->layoutGeneration = 0;
+    window->hotViewLayout = 0;
+    window->hotBounds = (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+    window->damage.full = true;
+    window->damage.count = 0;
+    window->swapInterval = NK_SWAP_INTERVAL_ON; /* left to the driver until set */
+    window->swapIntervalChanged = false;
+    window->maxFrameRate = 0.0f;
+    window->nextPresent = 0;
+    window->pointerActionState = 0;
+    memset(window->keyState, 0, sizeof(window->keyState));
+    memset(&window->frameTiming, 0, sizeof(window->frameTiming));
+    window->metrics = NULL;
+    window->pendingInput.type = NK_EVENT_NONE;
+    window->inputRing = NULL;
+    window->recording = NULL;
+    window->replay = NULL;
+    window->viewIndex = NULL;
+    window->renderThread = NULL;
+    window->postQueue = nkPostQueue_Create();
+
+    if (window->postQueue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate the posted event queue!\n");
+        return false;
+    }
+
+    nkWindow_SetTitle(window, title);
+
+    /* the first commit carries no buffer, the compositor answers with a configure */
+    wl_surface_commit(window->surface);
+
+    /* add this window to the linked list */
+    if (windowList == NULL)
+    {
+        windowList = window;
+    }
+    else
+    {
+        nkWindow_t *current = windowList;
+        while (current->next != NULL)
+        {
+            current = current->next;
+        }
+        current->next = window;
+    }
+
+    wl_display_roundtrip(display);
+
+    return true;
+}
+
+void nkWindow_SetTitle(nkWindow_t *window, const char *title)
+{
+    if (window == NULL || title == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    xdg_toplevel_set_title(window->xdgToplevel, title);
+
+    window->title = title; /* update the title in the window struct */
+}
+
+void nkWindow_SetSize(nkWindow_t *window, float width, float height)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* a floating toplevel picks its own size, the next commit makes it so */
+    window->pendingWidth = width;
+    window->pendingHeight = height;
+
+    if (!CreateBuffers(window, (uint32_t)width, (uint32_t)height))
+    {
+        fprintf(stderr, "Failed to resize the wl_shm buffers!\n");
+        return;
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_RESIZE,
+        .resize = { width, height }
+    };
+
+    nkWindow_PostInput(window, &event);
+}
+
+void nkWindow_SetVisibility(nkWindow_t *window, nkWindowVisibility_t visibility)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* set the window visibility */
+    switch (visibility)
+    {
+        case NK_WINDOW_VISIBILITY_VISIBLE:
+        {
+            xdg_toplevel_unset_fullscreen(window->xdgToplevel);
+            xdg_toplevel_unset_maximized(window->xdgToplevel);
+
+            if (window->visibility == NK_WINDOW_VISIBILITY_HIDDEN)
+            {
+                /* remap with an empty commit, the configure that follows brings the first frame */
+                wl_surface_commit(window->surface);
+            }
+        } break;
+
+        case NK_WINDOW_VISIBILITY_HIDDEN:
+        {
+            /* a null buffer unmaps the surface */
+            wl_surface_attach(window->surface, NULL, 0, 0);
+            wl_surface_commit(window->surface);
+
+            window->configured = false;
+        } break;
+
+        case NK_WINDOW_VISIBILITY_MINIMIZED:
+        {
+            xdg_toplevel_set_minimized(window->xdgToplevel);
+        } break;
+
+        case NK_WINDOW_VISIBILITY_MAXIMIZED:
+        {
+            xdg_toplevel_set_maximized(window->xdgToplevel);
+        } break;
+
+        case NK_WINDOW_VISIBILITY_FULLSCREEN:
+        {
+            xdg_toplevel_set_fullscreen(window->xdgToplevel, NULL);
+        } break;
+
+        default:
+        {
+            return; /* nothing to do */
+        }
+    }
+
+    wl_display_flush(display);
+
+    window->visibility = visibility; /* update the visibility in the window struct */
+}
+
+void nkWindow_SetFocus(nkWindow_t *window, nkWindowFocus_t focus)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* focus belongs to the compositor on Wayland, it is reported through wl_keyboard */
+}
+
+void nkWindow_SetCursor(nkWindow_t *window, nkCursorType_t cursorType)
+{
+    if (window == NULL || (uint32_t)cursorType > NK_CURSOR_SIZENS_VALUE)
+    {
+        return; /* nothing to do */
+    }
+
+    window->cursorType = cursorType;
+
+    if (pointerWindow == window)
+    {
+        ApplyCursor(window);
+    }
+}
+
+void nkWindow_Destroy(nkWindow_t *window)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->destroyed = true;
+
+    const nkWindowDelegate_t *delegate = nkWindow_GetDelegate(window);
+
+    /* call the close callback if it exists */
+    if (delegate->closeCallback)
+    {
+        delegate->closeCallback(window);
+    }
+
+    if (pointerWindow == window)
+    {
+        pointerWindow = NULL;
+    }
+
+    if (keyboardWindow == window)
+    {
+        keyboardWindow = NULL;
+    }
+
+    if (glAvailable)
+    {
+        nkOffscreen_DestroyTarget(window);
+
+        if (contextsShared && nkSharedDraw_Release())
+        {
+            nkOffscreen_DestroyShareGroup();
+        }
+    }
+
+    if (window->frameCallback != NULL)
+    {
+        wl_callback_destroy(window->frameCallback);
+        window->frameCallback = NULL;
+    }
+
+    DestroyBuffers(window);
+
+    xdg_toplevel_destroy(window->xdgToplevel);
+    xdg_surface_destroy(window->xdgSurface);
+    wl_surface_destroy(window->surface);
+
+    wl_display_flush(display);
+
+    nkPostQueue_Destroy(window->postQueue);
+    window->postQueue = NULL;
+
+    nkWindow_StopRecording(window);
+    nkWindow_StopReplay(window);
+
+    nkViewIndex_Destroy(window->viewIndex);
+    window->viewIndex = NULL;
+
+    nkWindow_DestroyMetrics(window);
+
+    RemoveWindow(window);
+}
+
+void nkWindow_ScheduleFrame(nkWindow_t *window)
+{
+    /* painted when the compositor next asks for a frame */
+}
+
+bool nkWindow_IsPointerActionDown(nkWindow_t *window, nkPointerAction_t action)
+{
+    return nkWindow_TestPointerActionState(window, action);
+}
+
+bool nkWindow_IsKeyDown(nkWindow_t *window, uint32_t keycode)
+{
+    return nkWindow_TestKeyState(window, keycode);
+}
+
+void nkWindow_RedrawViews(nkWindow_t *window)
+{
+    if (window == NULL || window->rootView == NULL)
+    {
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Window contains no views");
+        return;
+    }
+
+    if (!glAvailable)
+    {
+        return; /* nothing to render with */
+    }
+
+    nkOffscreen_MakeCurrent(window);
+
+    nkView_RenderTree(window->rootView, &window->drawContext);
+}
+
+bool nkWindow_PollEvents(void)
+{
+    static bool firstRun = true;
+
+    if (firstRun)
+    {
+        firstRun = false;
+
+        for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+        {
+            nkWindow_LayoutViews(current);
+        }
+    }
+
+    /* read whatever is on the socket without blocking, then dispatch it */
+    while (wl_display_prepare_read(display) != 0)
+    {
+        wl_display_dispatch_pending(display);
+    }
+
+    wl_display_flush(display);
+
+    struct pollfd pollDescriptor = {
+        .fd = wl_display_get_fd(display),
+        .events = POLLIN
+    };
+
+    if (poll(&pollDescriptor, 1, 0) > 0)
+    {
+        wl_display_read_events(display);
+    }
+    else
+    {
+        wl_display_cancel_read(display);
+    }
+
+    wl_display_dispatch_pending(display);
+
+    if (wl_display_get_error(display) != 0)
+    {
+        fprintf(stderr, "Lost the connection to the Wayland compositor!\n");
+        return false;
+    }
+
+    /* timers due by now, before the frame so what they change is drawn in it */
+    nkWindow_ServiceTimers();
+
+    /* windows are closed outside of their own listeners, after the motion held back for merging */
+    nkWindow_t *current = windowList;
+    while (current != NULL)
+    {
+        nkWindow_t *next = current->next;
+
+        nkWindow_DrainInput(current);
+
+        if (current->closeRequested)
+        {
+            nkWindow_Destroy(current);
+        }
+
+        current = next;
+    }
+
+    if (quitRequested)
+    {
+        return false;
+    }
+
+    /* paint only windows whose previous frame the compositor has already consumed */
+    for (current = windowList; current != NULL; current = current->next)
+    {
+        if (CanPaint(current))
+        {
+            PaintWindow(current);
+        }
+    }
+
+    wl_display_flush(display);
+
+    return true;
+}
+
+void nkWindow_WakeEventLoop(nkWindow_t *window)
+{
+    nkWakeup_Signal();
+}
+
+bool nkWindow_WaitEvents(double timeoutSeconds)
+{
+    /* wake for the next timer too */
+    timeoutSeconds = nkWindow_GetTimerTimeout(timeoutSeconds);
+
+    for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+    {
+        if (CanPaint(current) || current->closeRequested)
+        {
+            return nkWindow_PollEvents(); /* work is already waiting */
+        }
+    }
+
+    /* a window waiting on its frame callback or a buffer is woken by the compositor's done or release event */
+    while (wl_display_prepare_read(display) != 0)
+    {
+        wl_display_dispatch_pending(display);
+    }
+
+    wl_display_flush(display);
+
+    if (nkWakeup_Wait(wl_display_get_fd(display), timeoutSeconds))
+    {
+        wl_display_read_events(display);
+    }
+    else
+    {
+        wl_display_cancel_read(display);
+    }
+
+    return nkWindow_PollEvents();
+}
+
+float nkWindow_GetRefreshRate(nkWindow_t *window)
+{
+    if (window == NULL || outputCount == 0)
+    {
+        return 0.0f;
+    }
+
+    /* until the surface enters an output, the first one is the best guess */
+    int32_t refresh = outputs[0].refresh;
+
+    for (uint32_t i = 0; i < outputCount; i++)
+    {
+        if (outputs[i].handle == window->output)
+        {
+            refresh = outputs[i].refresh;
+        }
+    }
+
+    return (float)refresh / 1000.0f;
+}
+
+bool nkWindow_EnableInputThread(void)
+{
+    /* listeners run on the thread that dispatches the display, which is always the caller of nkWindow_PollEvents */
+    return false;
+}
+
+bool nkWindow_EnableSharedContexts(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    contextsShared = true;
+    nkOffscreen_ShareContexts();
+
+    return true;
+}
+
+bool nkWindow_EnableRenderThreads(void)
+{
+    /* frames are read back into shm buffers attached from the display thread, so they stay on it */
+    return false;
+}
+
+bool nkWindow_BindRenderThread(nkWindow_t *target)
+{
+    return false; /* never called, there are no render threads */
+}
+
+void nkWindow_PresentFrame(nkWindow_t *target, nkWindowDamage_t *damage)
+{
+    /* never called, there are no render threads */
+}
+
+void nkWindow_UnbindRenderThread(nkWindow_t *window, nkWindow_t *target)
+{
+    /* never called, there are no render threads */
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool InitWayland(void)
+{
+    display = wl_display_connect(NULL);
+
+    if (display == NULL)
+    {
+        return false;
+    }
+
+    registry = wl_display_get_registry(display);
+    wl_registry_add_listener(registry, &registryListener, NULL);
+
+    /* one roundtrip for the globals, one for the seat capabilities */
+    wl_display_roundtrip(display);
+    wl_display_roundtrip(display);
+
+    if (compositor == NULL || shm == NULL || wmBase == NULL)
+    {
+        fprintf(stderr, "The compositor lacks wl_compositor, wl_shm or xdg_wm_base!\n");
+        return false;
+    }
+
+    xkbContext = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+
+    cursorTheme = wl_cursor_theme_load(NULL, CURSOR_SIZE, shm);
+    cursorSurface = wl_compositor_create_surface(compositor);
+
+    return true;
+}
+
+static nkWindow_t *FindWindow(struct wl_surface *surface)
+{
+    for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+    {
+        if (current->surface == surface)
+        {
+            return current;
+        }
+    }
+
+    return NULL;
+}
+
+static void RemoveWindow(nkWindow_t *window)
+{
+    if (windowList == window && window->next == NULL)
+    {
+        quitRequested = true; /* quit if this is the last */
+    }
+
+    if (windowList == window)
+    {
+        windowList = window->next; /* remove from head */
+    }
+    else
+    {
+        nkWindow_t *prev = windowList;
+        while (prev != NULL && prev->next != window)
+        {
+            prev = prev->next;
+        }
+
+        if (prev != NULL)
+        {
+            prev->next = window->next; /* remove from middle or end */
+        }
+    }
+
+    window->next = NULL;
+}
+
+static bool CreateBuffers(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    width = (width > 0) ? width : 1U;
+    height = (height > 0) ? height : 1U;
+
+    if (window->shmPool != NULL && window->bufferWidth == width && window->bufferHeight == height)
+    {
+        return true; /* nothing to do */
+    }
+
+    DestroyBuffers(window);
+
+    uint32_t stride = width * 4U;
+    size_t bufferSize = (size_t)stride * height;
+    size_t poolSize = bufferSize * NK_WAYLAND_BUFFER_COUNT;
+
+    int fd = memfd_create("nanowin-shm", MFD_CLOEXEC);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (ftruncate(fd, (off_t)poolSize) < 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    uint8_t *data = mmap(NULL, poolSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (data == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    window->shmPool = wl_shm_create_pool(shm, fd, (int32_t)poolSize);
+    window->shmData = data;
+    window->shmSize = poolSize;
+    window->bufferWidth = width;
+    window->bufferHeight = height;
+
+    close(fd); /* the compositor holds its own reference */
+
+    for (uint32_t i = 0; i < NK_WAYLAND_BUFFER_COUNT; i++)
+    {
+        window->buffers[i].handle = wl_shm_pool_create_buffer(
+            window->shmPool,
+            (int32_t)(bufferSize * i),
+            (int32_t)width,
+            (int32_t)height,
+            (int32_t)stride,
+            WL_SHM_FORMAT_ARGB8888
+        );
+
+        window->buffers[i].pixels = data + bufferSize * i;
+        window->buffers[i].busy = false;
+
+        wl_buffer_add_listener(window->buffers[i].handle, &bufferListener, &window->buffers[i].busy);
+    }
+
+    if (window->eglContext != EGL_NO_CONTEXT && !nkOffscreen_ResizeTarget(window, width, height))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static void DestroyBuffers(nkWindow_t *window)
+{
+    /* buffers the compositor still holds stay valid on its side, it keeps its own mapping */
+    for (uint32_t i = 0; i < NK_WAYLAND_BUFFER_COUNT; i++)
+    {
+        if (window->buffers[i].handle != NULL)
+        {
+            wl_buffer_destroy(window->buffers[i].handle);
+        }
+
+        window->buffers[i].handle = NULL;
+        window->buffers[i].pixels = NULL;
+        window->buffers[i].busy = false;
+    }
+
+    if (window->shmPool != NULL)
+    {
+        wl_shm_pool_destroy(window->shmPool);
+        window->shmPool = NULL;
+    }
+
+    if (window->shmData != NULL)
+    {
+        munmap(window->shmData, window->shmSize);
+        window->shmData = NULL;
+        window->shmSize = 0;
+    }
+}
+
+static bool CanPaint(nkWindow_t *window)
+{
+    if (!window->redrawRequested || !window->configured || window->frameCallback != NULL)
+    {
+        return false;
+    }
+
+    /* with the swap interval off nothing else holds frames back, so a busy buffer must not spin the loop */
+    for (uint32_t i = 0; i < NK_WAYLAND_BUFFER_COUNT; i++)
+    {
+        if (!window->buffers[i].busy)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void PaintWindow(nkWindow_t *window)
+{
+    /* never draw into a buffer the compositor may still be reading */
+    uint32_t index = NK_WAYLAND_BUFFER_COUNT;
+
+    for (uint32_t i = 0; i < NK_WAYLAND_BUFFER_COUNT; i++)
+    {
+        if (!window->buffers[i].busy)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == NK_WAYLAND_BUFFER_COUNT)
+    {
+        return; /* all in flight, stay dirty until one is released */
+    }
+
+    nkWindowDamage_t damage;
+
+    if (!nkWindow_BeginFrame(window, &damage))
+    {
+        return; /* woken only to deliver input, nothing changed */
+    }
+
+    uint8_t *pixels = window->buffers[index].pixels;
+    size_t stride = (size_t)window->bufferWidth * 4U;
+    uint64_t presentStart;
+
+    if (glAvailable)
+    {
+        nkOffscreen_MakeCurrent(window);
+
+        nkWindow_RenderFrame(window, &damage);
+
+        nkWindow_PaceFrame(window);
+
+        presentStart = nkWindow_GetTicks();
+
+        /* the pbuffer always holds the whole frame, and the free buffer may be several frames old,
+           so it is read back in full. WL_SHM_FORMAT_ARGB8888 is BGRA in memory on little endian hosts */
+        nkOffscreen_ReadPixels(window, 0, 0, window->bufferWidth, window->bufferHeight, GL_BGRA, pixels, stride);
+    }
+    else
+    {
+        uint32_t color =
+            ((uint32_t)(window->backgroundColor.a * 255.0f) << 24) |
+            ((uint32_t)(window->backgroundColor.r * 255.0f) << 16) |
+            ((uint32_t)(window->backgroundColor.g * 255.0f) << 8) |
+            ((uint32_t)(window->backgroundColor.b * 255.0f));
+
+        uint32_t *pixel = (uint32_t *)pixels;
+        size_t pixelCount = (size_t)window->bufferWidth * window->bufferHeight;
+
+        for (size_t i = 0; i < pixelCount; i++)
+        {
+            pixel[i] = color;
+        }
+
+        NK_STATS_ADD(window, framesRendered, 1U);
+
+        damage.full = true;
+
+        nkWindow_PaceFrame(window);
+
+        presentStart = nkWindow_GetTicks();
+    }
+
+    wl_surface_attach(window->surface, window->buffers[index].handle, 0, 0);
+
+    if (damage.full || !window->partialRedraw)
+    {
+        wl_surface_damage_buffer(window->surface, 0, 0, INT32_MAX, INT32_MAX);
+    }
+    else
+    {
+        /* the compositor only has to recomposite what changed */
+        for (uint32_t i = 0; i < damage.count; i++)
+        {
+            nkRect_t rect = damage.rects[i];
+
+            wl_surface_damage_buffer(
+                window->surface,
+                (int32_t)rect.x,
+                (int32_t)rect.y,
+                (int32_t)(rect.width + 1.0f),
+                (int32_t)(rect.height + 1.0f)
+            );
+        }
+    }
+
+    /* ask to be told when the compositor wants the next frame. With the swap interval off the next frame
+       goes out as soon as it is drawn into a free buffer, and the compositor shows the newest it has */
+    if (window->swapInterval != NK_SWAP_INTERVAL_OFF)
+    {
+        window->frameCallback = wl_surface_frame(window->surface);
+        wl_callback_add_listener(window->frameCallback, &frameListener, window);
+    }
+
+    wl_surface_commit(window->surface);
+
+    window->buffers[index].busy = true;
+
+    nkWindow_FinishFrame(window, presentStart);
+}
+
+static void ApplyCursor(nkWindow_t *window)
+{
+    if (pointer == NULL || cursorTheme == NULL)
+    {
+        return;
+    }
+
+    struct wl_cursor *cursor = wl_cursor_theme_get_cursor(cursorTheme, cursorNames[window->cursorType]);
+
+    if (cursor == NULL || cursor->image_count == 0)
+    {
+        return; /* not in this theme */
+    }
+
+    struct wl_cursor_image *image = cursor->images[0];
+
+    wl_pointer_set_cursor(pointer, pointerSerial, cursorSurface, (int32_t)image->hotspot_x, (int32_t)image->hotspot_y);
+    wl_surface_attach(cursorSurface, wl_cursor_image_get_buffer(image), 0, 0);
+    wl_surface_damage_buffer(cursorSurface, 0, 0, (int32_t)image->width, (int32_t)image->height);
+    wl_surface_commit(cursorSurface);
+}
+
+static void FlushPointerFrame(void)
+{
+    double timestamp = pointerTime;
+
+    pointerTime = 0.0;
+
+    if (pointerMoved)
+    {
+        pointerMoved = false;
+
+        nkEvent_t event = {
+            .type = NK_EVENT_POINTER_MOVE,
+            .timestamp = timestamp,
+            .pointer = { pointerX, pointerY }
+        };
+
+        nkWindow_PostInput(pointerWindow, &event);
+    }
+
+    if (pointerAxisX != 0.0f || pointerAxisY != 0.0f)
+    {
+        nkEvent_t event = {
+            .type = NK_EVENT_SCROLL,
+            .timestamp = timestamp,
+            .scroll = { pointerAxisX, pointerAxisY }
+        };
+
+        pointerAxisX = 0.0f;
+        pointerAxisY = 0.0f;
+
+        nkWindow_PostInput(pointerWindow, &event);
+    }
+}
+
+static double GetEventTime(uint32_t time)
+{
+    return nkEventClock_Convert(&eventClock, (double)time / 1000.0);
+}
+
+static void RegistryGlobal(void *data, struct wl_registry *registry, uint32_t name, const char *interface, uint32_t version)
+{
+    if (strcmp(interface, wl_compositor_interface.name) == 0 && version >= COMPOSITOR_VERSION)
+    {
+        compositor = wl_registry_bind(registry, name, &wl_compositor_interface, COMPOSITOR_VERSION);
+    }
+    else if (strcmp(interface, wl_shm_interface.name) == 0)
+    {
+        shm = wl_registry_bind(registry, name, &wl_shm_interface, 1);
+    }
+    else if (strcmp(interface, xdg_wm_base_interface.name) == 0)
+    {
+        wmBase = wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(wmBase, &wmBaseListener, NULL);
+    }
+    else if (strcmp(interface, wl_output_interface.name) == 0 && version >= OUTPUT_VERSION && outputCount < MAX_OUTPUTS)
+    {
+        outputs[outputCount].handle = wl_registry_bind(registry, name, &wl_output_interface, OUTPUT_VERSION);
+        outputs[outputCount].refresh = 0;
+        wl_output_add_listener(outputs[outputCount].handle, &outputListener, &outputs[outputCount]);
+        outputCount++;
+    }
+    else if (strcmp(interface, wl_seat_interface.name) == 0 && seat == NULL)
+    {
+        seatVersion = (version < SEAT_VERSION) ? version : SEAT_VERSION;
+        seat = wl_registry_bind(registry, name, &wl_seat_interface, seatVersion);
+        wl_seat_add_listener(seat, &seatListener, NULL);
+    }
+}
+
+static void RegistryGlobalRemove(void *data, struct wl_registry *registry, uint32_t name)
+{
+    /* nothing we bind is expected to go away */
+}
+
+static void WmBasePing(void *data, struct xdg_wm_base *wmBase, uint32_t serial)
+{
+    xdg_wm_base_pong(wmBase, serial);
+}
+
+static void SeatCapabilities(void *data, struct wl_seat *seat, uint32_t capabilities)
+{
+    if ((capabilities & WL_SEAT_CAPABILITY_POINTER) && pointer == NULL)
+    {
+        pointer = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(pointer, &pointerListener, NULL);
+    }
+    else if (!(capabilities & WL_SEAT_CAPABILITY_POINTER) && pointer != NULL)
+    {
+        wl_pointer_destroy(pointer);
+        pointer = NULL;
+    }
+
+    if ((capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && keyboard == NULL)
+    {
+        keyboard = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(keyboard, &keyboardListener, NULL);
+    }
+    else if (!(capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && keyboard != NULL)
+    {
+        wl_keyboard_destroy(keyboard);
+        keyboard = NULL;
+    }
+}
+
+static void SeatName(void *data, struct wl_seat *seat, const char *name)
+{
+    /* not needed */
+}
+
+static void XdgSurfaceConfigure(void *data, struct xdg_surface *xdgSurface, uint32_t serial)
+{
+    nkWindow_t *window = (nkWindow_t *)data;
+
+    xdg_surface_ack_configure(xdgSurface, serial);
+
+    if (window->pendingWidth != window->width || window->pendingHeight != window->height)
+    {
+        if (CreateBuffers(window, (uint32_t)window->pendingWidth, (uint32_t)window->pendingHeight))
+        {
+            nkEvent_t event = {
+                .type = NK_EVENT_RESIZE,
+                .resize = { window->pendingWidth, window->pendingHeight }
+            };
+
+            nkWindow_PostInput(window, &event);
+        }
+    }
+
+    if (window->pendingVisibility != window->visibility)
+    {
+        nkEvent_t event = {
+            .type = NK_EVENT_VISIBILITY_CHANGE,
+            .visibility = window->pendingVisibility
+        };
+
+        nkWindow_PostInput(window, &event);
+    }
+
+    /* every configure must be answered with a commit */
+    window->configured = true;
+    nkWindow_RequestRedraw(window);
+}
+
+static void XdgToplevelConfigure(void *data, struct xdg_toplevel *xdgToplevel, int32_t width, int32_t height, struct wl_array *states)
+{
+    nkWindow_t *window = (nkWindow_t *)data;
+
+    /* zero means the client should pick, so keep the current size */
+    if (width > 0 && height > 0)
+    {
+        window->pendingWidth = (float)width;
+        window->pendingHeight = (float)height;
+    }
+
+    window->pendingVisibility = NK_WINDOW_VISIBILITY_VISIBLE;
+
+    uint32_t *state;
+    wl_array_for_each(state, states)
+    {
+        if (*state == XDG_TOPLEVEL_STATE_FULLSCREEN)
+        {
+            window->pendingVisibility = NK_WINDOW_VISIBILITY_FULLSCREEN;
+        }
+        else if (*state == XDG_TOPLEVEL_STATE_MAXIMIZED && window->pendingVisibility != NK_WINDOW_VISIBILITY_FULLSCREEN)
+        {
+            window->pendingVisibility = NK_WINDOW_VISIBILITY_MAXIMIZED;
+        }
+    }
+}
+
+static void XdgToplevelClose(void *data, struct xdg_toplevel *xdgToplevel)
+{
+    nkWindow_t *window = (nkWindow_t *)data;
+
+    window->closeRequested = true;
+}
+
+static void BufferRelease(void *data, struct wl_buffer *buffer)
+{
+    bool *busy = (bool *)data;
+
+    *busy = false;
+}
+
+static void FrameDone(void *data, struct wl_callback *callback, uint32_t time)
+{
+    nkWindow_t *window = (nkWindow_t *)data;
+
+    wl_callback_destroy(callback);
+    window->frameCallback = NULL;
+}
+
+static void SurfaceEnter(void *data, struct wl_surface *surface, struct wl_output *output)
+{
+    nkWindow_t *window = (nkWindow_t *)data;
+
+    window->output = output;
+}
+
+static void SurfaceLeave(void *data, struct wl_surface *surface, struct wl_output *output)
+{
+    nkWindow_t *window = (nkWindow_t *)data;
+
+    if (window->output == output)
+    {
+        window->output = NULL;
+    }
+}
+
+static void OutputGeometry(void *data, struct wl_output *output, int32_t x, int32_t y, int32_t physicalWidth, int32_t physicalHeight, int32_t subpixel, const char *make, const char *model, int32_t transform)
+{
+    /* not needed */
+}
+
+static void OutputMode(void *data, struct wl_output *output, uint32_t flags, int32_t width, int32_t height, int32_t refresh)
+{
+    if (flags & WL_OUTPUT_MODE_CURRENT)
+    {
+        nkWaylandOutput_t *entry = (nkWaylandOutput_t *)data;
+
+        entry->refresh = refresh;
+    }
+}
+
+static void OutputDone(void *data, struct wl_output *output)
+{
+    /* not needed */
+}
+
+static void OutputScale(void *data, struct wl_output *output, int32_t factor)
+{
+    /* not needed */
+}
+
+static void PointerEnter(void *data, struct wl_pointer *pointer, uint32_t serial, struct wl_surface *surface, wl_fixed_t x, wl_fixed_t y)
+{
+    pointerWindow = FindWindow(surface);
+    pointerSerial = serial;
+    pointerX = (float)wl_fixed_to_double(x);
+    pointerY = (float)wl_fixed_to_double(y);
+    pointerMoved = true;
+
+    if (pointerWindow != NULL)
+    {
+        ApplyCursor(pointerWindow);
+    }
+
+    if (seatVersion < SEAT_VERSION)
+    {
+        FlushPointerFrame();
+    }
+}
+
+static void PointerLeave(void *data, struct wl_pointer *pointer, uint32_t serial, struct wl_surface *surface)
+{
+    FlushPointerFrame();
+
+    nkEvent_t event = { .type = NK_EVENT_POINTER_LEAVE };
+
+    nkWindow_PostInput(pointerWindow, &event);
+
+    pointerWindow = NULL;
+}
+
+static void PointerMotion(void *data, struct wl_pointer *pointer, uint32_t time, wl_fixed_t x, wl_fixed_t y)
+{
+    pointerX = (float)wl_fixed_to_double(x);
+    pointerY = (float)wl_fixed_to_double(y);
+    pointerMoved = true;
+
+    if (pointerTime == 0.0)
+    {
+        pointerTime = GetEventTime(time);
+    }
+
+    if (seatVersion < SEAT_VERSION)
+    {
+        FlushPointerFrame();
+    }
+}
+
+static void PointerButton(void *data, struct wl_pointer *pointer, uint32_t serial, uint32_t time, uint32_t button, uint32_t state)
+{
+    nkPointerAction_t action;
+
+    switch (button)
+    {
+        case BTN_LEFT: action = NK_POINTER_ACTION_PRIMARY; break;
+        case BTN_RIGHT: action = NK_POINTER_ACTION_SECONDARY; break;
+        case BTN_MIDDLE: action = NK_POINTER_ACTION_TERTIARY; break;
+        case BTN_SIDE: action = NK_POINTER_ACTION_EXTENDED_1; break;
+        case BTN_EXTRA: action = NK_POINTER_ACTION_EXTENDED_2; break;
+
+        default:
+        {
+            return; /* unknown button */
+        }
+    }
+
+    /* the press must land where the pointer is, so deliver any pending motion first */
+    FlushPointerFrame();
+
+    pointerSerial = serial;
+
+    nkEvent_t event = {
+        .type = (state == WL_POINTER_BUTTON_STATE_PRESSED) ? NK_EVENT_POINTER_ACTION_BEGIN : NK_EVENT_POINTER_ACTION_END,
+        .timestamp = GetEventTime(time),
+        .pointerAction = { action, pointerX, pointerY }
+    };
+
+    nkWindow_PostInput(pointerWindow, &event);
+}
+
+static void PointerAxis(void *data, struct wl_pointer *pointer, uint32_t time, uint32_t axis, wl_fixed_t value)
+{
+    /* Wayland scrolls positive towards the bottom right, nanowin positive away from the user */
+    float steps = -(float)wl_fixed_to_double(value) / AXIS_UNITS_PER_STEP;
+
+    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
+    {
+        pointerAxisY += steps;
+    }
+    else
+    {
+        pointerAxisX += steps;
+    }
+
+    if (pointerTime == 0.0)
+    {
+        pointerTime = GetEventTime(time);
+    }
+
+    if (seatVersion < SEAT_VERSION)
+    {
+        FlushPointerFrame();
+    }
+}
+
+static void PointerFrame(void *data, struct wl_pointer *pointer)
+{
+    FlushPointerFrame();
+}
+
+static void PointerAxisSource(void *data, struct wl_pointer *pointer, uint32_t source)
+{
+    /* not needed */
+}
+
+static void PointerAxisStop(void *data, struct wl_pointer *pointer, uint32_t time, uint32_t axis)
+{
+    /* not needed */
+}
+
+static void PointerAxisDiscrete(void *data, struct wl_pointer *pointer, uint32_t axis, int32_t discrete)
+{
+    /* the continuous value from wl_pointer.axis is used instead */
+}
+
+static void KeyboardKeymap(void *data, struct wl_keyboard *keyboard, uint32_t format, int32_t fd, uint32_t size)
+{
+    if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1 || xkbContext == NULL)
+    {
+        close(fd);
+        return;
+    }
+
+    char *keymapString = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (keymapString == MAP_FAILED)
+    {
+        return;
+    }
+
+    struct xkb_keymap *keymap = xkb_keymap_new_from_string(xkbContext, keymapString, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    munmap(keymapString, size);
+
+    if (keymap == NULL)
+    {
+        return;
+    }
+
+    xkb_state_unref(xkbState);
+    xkb_keymap_unref(xkbKeymap);
+
+    xkbKeymap = keymap;
+    xkbState = xkb_state_new(xkbKeymap);
+}
+
+static void KeyboardEnter(void *data, struct wl_keyboard *keyboard, uint32_t serial, struct wl_surface *surface, struct wl_array *keys)
+{
+    keyboardWindow = FindWindow(surface);
+
+    if (keyboardWindow == NULL)
+    {
+        return;
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_FOCUS_CHANGE,
+        .focus = NK_WINDOW_FOCUS_FOCUSED
+    };
+
+    nkWindow_PostInput(keyboardWindow, &event);
+}
+
+static void KeyboardLeave(void *data, struct wl_keyboard *keyboard, uint32_t serial, struct wl_surface *surface)
+{
+    nkWindow_t *window = FindWindow(surface);
+
+    keyboardWindow = NULL;
+
+    if (window == NULL)
+    {
+        return;
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_FOCUS_CHANGE,
+        .focus = NK_WINDOW_FOCUS_UNFOCUSED
+    };
+
+    nkWindow_PostInput(window, &event);
+}
+
+static void KeyboardKey(void *data, struct wl_keyboard *keyboard, uint32_t serial, uint32_t time, uint32_t key, uint32_t state)
+{
+    if (keyboardWindow == NULL || xkbState == NULL)
+    {
+        return;
+    }
+
+    /* evdev scancodes are offset by 8 in XKB */
+    xkb_keycode_t xkbKeycode = key + 8U;
+    bool pressed = (state == WL_KEYBOARD_KEY_STATE_PRESSED);
+    double timestamp = GetEventTime(time);
+
+    nkEvent_t event = {
+        .type = pressed ? NK_EVENT_KEY_DOWN : NK_EVENT_KEY_UP,
+        .timestamp = timestamp,
+        .key = { nkKeycode_FromKeysym(xkb_state_key_get_one_sym(xkbState, xkbKeycode)) }
+    };
+
+    nkWindow_PostInput(keyboardWindow, &event);
+
+    if (!pressed)
+    {
+        return;
+    }
+
+    uint32_t codepoint = xkb_state_key_get_utf32(xkbState, xkbKeycode);
+
+    /* filter out control keys such as delete and backspace */
+    if (codepoint > 0x1F && codepoint != 0x7F)
+    {
+        nkEvent_t codepointEvent = {
+            .type = NK_EVENT_CODEPOINT_INPUT,
+            .timestamp = timestamp,
+            .codepoint = { codepoint }
+        };
+
+        nkWindow_PostInput(keyboardWindow, &codepointEvent);
+    }
+}
+
+static void KeyboardModifiers(void *data, struct wl_keyboard *keyboard, uint32_t serial, uint32_t depressed, uint32_t latched, uint32_t locked, uint32_t group)
+{
+    if (xkbState != NULL)
+    {
+        xkb_state_update_mask(xkbState, depressed, latched, locked, 0, 0, group);
+    }
+}
+
+static void KeyboardRepeatInfo(void *data, struct wl_keyboard *keyboard, int32_t rate, int32_t delay)
+{
+    /* key repeat is client side on Wayland and is not synthesized yet */
+}
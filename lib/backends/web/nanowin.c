@@ -18,15 +18,24 @@
 #include <nanowin.h>
 #include <nanodraw.h>
 
+#include "nanowin_internal.h"
+
+#include <emscripten/threading.h>
+#include <emscripten/eventloop.h>
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
 
+#define FRAME_INTERVAL_MIN      (2.0)   /* ms, closer animation frames than this are not the display's */
+#define FRAME_INTERVAL_CREEP    (0.1)   /* share of a later interval the refresh estimate moves by */
+
 /***************************************************************
 ** MARK: TYPEDEFS
 ***************************************************************/
@@ -45,6 +54,12 @@ static EmscriptenMouseEvent mouseEvent;
 static EmscriptenWheelEvent wheelEvent;
 static EmscriptenKeyboardEvent keyboardEvent;
 
+static nkEventClock_t eventClock = {0}; /* browser event times, in milliseconds, onto our clock */
+
+/* the browser does not say how often the display refreshes, so it is estimated from animation frame times */
+static double lastAnimationFrame = 0.0;
+static double animationFrameInterval = 0.0;
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
@@ -59,9 +74,12 @@ static EM_BOOL TouchCallback(int eventType, const EmscriptenTouchEvent* e, void*
 static EM_BOOL KeyCallback(int eventType, const EmscriptenKeyboardEvent* e, void* userData);
 static EM_BOOL ResizeCallback(int eventType, const EmscriptenUiEvent* e, void* userData);
 static EM_BOOL DrawCallback(double time, void* userData);
+static void TimeoutCallback(void* userData);
+static EM_BOOL DrawFrame(nkWindow_t *window);
 
 static void MeasureWindow(nkWindow_t *window);
 static void ArrangeWindow(nkWindow_t *window);
+static double GetEventTime(double timestamp);
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
@@ -77,7 +95,7 @@ bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float h
         initialized = true;
     }
 
-    printf("Creating window '%s' with size %.2f x %.2f\n", title, width, height);
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_INFO, "window", "Create");
 
     nkDraw_CreateContext(&window->drawContext);
 
@@ -86,12 +104,43 @@ bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float h
 
     /* populate the window contents */
     window->next = NULL;
+    window->destroyed = false;
     window->title = title;
     window->width = width;
     window->height = height;
     window->visibility = NK_WINDOW_VISIBILITY_VISIBLE;
     window->focus = NK_WINDOW_FOCUS_FOCUSED;
     window->backgroundColor = NK_COLOR_WHITE; /* default background color */
+    window->pointerActionState = 0;
+    memset(window->keyState, 0, sizeof(window->keyState));
+    memset(&window->frameTiming, 0, sizeof(window->frameTiming));
+    window->metrics = NULL;
+    window->pendingInput.type = NK_EVENT_NONE;
+    window->redrawRequested = false;
+    window->layoutDirty = true;
+    window->layoutSize = (nkSize_t){ 0.0f, 0.0f };
+    window->layoutGeneration = 0;
+    window->hotViewLayout = 0;
+    window->hotBounds = (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+    window->damage.full = true;
+    window->damage.count = 0;
+    window->swapInterval = NK_SWAP_INTERVAL_ON; /* left to the driver until set */
+    window->swapIntervalChanged = false;
+    window->maxFrameRate = 0.0f;
+    window->nextPresent = 0;
+    window->partialRedraw = true; /* see preserveDrawingBuffer */
+    window->inputRing = NULL;
+    window->recording = NULL;
+    window->replay = NULL;
+    window->viewIndex = NULL;
+    window->renderThread = NULL;
+    window->postQueue = nkPostQueue_Create();
+
+    if (window->postQueue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate the posted event queue!\n");
+        return false;
+    }
 
     return true;
 }
@@ -150,57 +199,130 @@ void nkWindow_Destroy(nkWindow_t *window)
         return; /* nothing to do */
     }
 
+    window->destroyed = true;
+
+    nkPostQueue_Destroy(window->postQueue);
+    window->postQueue = NULL;
+
+    nkWindow_StopRecording(window);
+    nkWindow_StopReplay(window);
+
+    nkViewIndex_Destroy(window->viewIndex);
+    window->viewIndex = NULL;
+
+    nkWindow_DestroyMetrics(window);
 }
 
-void nkWindow_RequestRedraw(nkWindow_t *window)
+void nkWindow_ScheduleFrame(nkWindow_t *window)
 {
-    if (window == NULL)
+    /* only the first request since the last frame gets here, so one callback per frame */
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_DEBUG, "window", "ScheduleFrame");
+
+    if (window->swapInterval == NK_SWAP_INTERVAL_OFF)
     {
-        return; /* nothing to do */
+        /* the browser still composites at the display's rate, but our frames no longer wait for it */
+        emscripten_set_timeout(TimeoutCallback, nkWindow_GetPaceDelay(window) * 1000.0, window);
+    }
+    else
+    {
+        /* animation frames are the browser's vsync, there is no adaptive mode to choose */
+        emscripten_request_animation_frame(DrawCallback, window);
     }
-
-    printf("Requesting redraw for window '%s'\n", window->title);
-    emscripten_request_animation_frame(DrawCallback, window);
 }
 
 bool nkWindow_IsPointerActionDown(nkWindow_t *window, nkPointerAction_t action)
 {
-    return false;
+    return nkWindow_TestPointerActionState(window, action);
 }
 
 bool nkWindow_IsKeyDown(nkWindow_t *window, uint32_t keycode)
 {
-    return false;
+    return nkWindow_TestKeyState(window, keycode);
 }
 
 void nkWindow_RedrawViews(nkWindow_t *window)
 {
     if (window == NULL || window->rootView == NULL)
     {
-        printf("Window contains no views!\n");
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Window contains no views");
         return;
     }
 
     nkView_RenderTree(window->rootView, &window->drawContext);
 }
 
-void nkWindow_LayoutViews(nkWindow_t *window)
+bool nkWindow_PollEvents(void)
 {
-    if (window == NULL || window->rootView == NULL)
+    static bool firstRun = true;
+
+    if (firstRun && windowHandle != NULL)
     {
-        printf("Window contains no views!\n");
-        return;
+        firstRun = false;
+
+        nkWindow_LayoutViews(windowHandle);
+        nkWindow_RequestRedraw(windowHandle);
     }
 
-    nkView_LayoutTree(window->rootView, (nkSize_t){window->width, window->height}, &window->drawContext);
+    ResizeCallback(0, NULL, NULL); // Trigger resize to ensure window size is updated
+    return false;
 }
 
-bool nkWindow_PollEvents(void)
+void nkWindow_WakeEventLoop(nkWindow_t *window)
 {
-    ResizeCallback(0, NULL, NULL); // Trigger resize to ensure window size is updated
+    /* posted events are delivered with the next animation frame. Scheduling one is only safe on the
+       main thread, a worker's event waits for a frame requested by something else */
+    if (emscripten_is_main_runtime_thread())
+    {
+        nkWindow_RequestFrame(window);
+    }
+}
+
+bool nkWindow_WaitEvents(double timeoutSeconds)
+{
+    /* the browser owns the loop and nothing may block it, events arrive through its callbacks */
+    (void)timeoutSeconds;
+
+    return nkWindow_PollEvents();
+}
+
+float nkWindow_GetRefreshRate(nkWindow_t *window)
+{
+    return (animationFrameInterval > 0.0) ? (float)(1000.0 / animationFrameInterval) : 0.0f;
+}
+
+bool nkWindow_EnableInputThread(void)
+{
+    /* the browser delivers events on the main thread, between animation frames */
+    return false;
+}
+
+bool nkWindow_EnableSharedContexts(void)
+{
+    /* there is only the one canvas, and so the one context */
     return false;
 }
 
+bool nkWindow_EnableRenderThreads(void)
+{
+    /* the canvas' WebGL context belongs to the main thread */
+    return false;
+}
+
+bool nkWindow_BindRenderThread(nkWindow_t *target)
+{
+    return false; /* never called, there are no render threads */
+}
+
+void nkWindow_PresentFrame(nkWindow_t *target, nkWindowDamage_t *damage)
+{
+    /* never called, there are no render threads */
+}
+
+void nkWindow_UnbindRenderThread(nkWindow_t *window, nkWindow_t *target)
+{
+    /* never called, there are no render threads */
+}
+
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
@@ -208,13 +330,14 @@ bool nkWindow_PollEvents(void)
 static void InitWeb(void)
 {
     /* create a canvas */
-    printf("Initializing Web backend...\n");
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_INFO, "window", "InitWeb");
 
 
     emscripten_webgl_init_context_attributes(&webglAttributes);
     webglAttributes.majorVersion = 2;
     webglAttributes.minorVersion = 0;
     webglAttributes.enableExtensionsByDefault = true;
+    webglAttributes.preserveDrawingBuffer = true; /* keeps the last frame, so only damage needs drawing */
     //webglAttributes.explicitSwapControl = 0; // Let browser handle it
     //webglAttributes.renderViaOffscreenBackBuffer = 0; // Avoid unnecessary buffering
 
@@ -224,10 +347,6 @@ static void InitWeb(void)
         fprintf(stderr, "Failed to create WebGL context!\n");
         return;
     }
-    else 
-    {
-        printf("WebGL context created successfully.\n");
-    }
 
     emscripten_webgl_make_context_current(webglContext);
 
@@ -246,7 +365,8 @@ static void InitWeb(void)
 
 static EM_BOOL MouseCallback(int eventType, const EmscriptenMouseEvent* e, void* userData)
 {
-    printf("Mouse event: %d at (%d, %d)\n", eventType, e->targetX, e->targetY);
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_DEBUG, "input", "Mouse");
+
     if (windowHandle == NULL)
     {
         return false; /* no window to handle events for */
@@ -260,61 +380,44 @@ static EM_BOOL MouseCallback(int eventType, const EmscriptenMouseEvent* e, void*
     switch (eventType)
     {
         case EMSCRIPTEN_EVENT_MOUSEDOWN:
-        {
-
-            if (window->pointerActionBeginCallback)
-            {
-                window->pointerActionBeginCallback(window, NK_POINTER_ACTION_PRIMARY, (float)e->targetX, (float)e->targetY);
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_PRIMARY, 
-                POINTER_EVENT_BEGIN,
-                x, 
-                y, 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-
-        } break;
-
         case EMSCRIPTEN_EVENT_MOUSEUP:
         {
+            nkPointerAction_t action;
 
-            if (window->pointerActionEndCallback)
+            /* MouseEvent.button numbers the middle button before the right one */
+            switch (e->button)
             {
-                window->pointerActionEndCallback(window, NK_POINTER_ACTION_PRIMARY, (float)e->targetX, (float)e->targetY);
+                case 0: action = NK_POINTER_ACTION_PRIMARY; break;
+                case 1: action = NK_POINTER_ACTION_TERTIARY; break;
+                case 2: action = NK_POINTER_ACTION_SECONDARY; break;
+                case 3: action = NK_POINTER_ACTION_EXTENDED_1; break;
+                case 4: action = NK_POINTER_ACTION_EXTENDED_2; break;
+
+                default:
+                {
+                    return false; /* unknown button */
+                }
             }
 
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_PRIMARY, 
-                POINTER_EVENT_END,
-                x, 
-                y, 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
+            nkEvent_t event = {
+                .type = (eventType == EMSCRIPTEN_EVENT_MOUSEDOWN) ? NK_EVENT_POINTER_ACTION_BEGIN : NK_EVENT_POINTER_ACTION_END,
+                .timestamp = GetEventTime(e->timestamp),
+                .pointerAction = { action, x, y }
+            };
 
-            nkWindow_RequestRedraw(window);
+            nkWindow_PostInput(window, &event);
 
         } break;
 
         case EMSCRIPTEN_EVENT_MOUSEMOVE:
         {
-            if (window->pointerMoveCallback)
-            {
-                window->pointerMoveCallback(window, x, y);
-            }
-
-            nkView_ProcessPointerMovement(window->rootView, x, y, &window->hotView, window->activeView, window->activeAction);
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_MOVE,
+                .timestamp = GetEventTime(e->timestamp),
+                .pointer = { x, y }
+            };
 
-            nkWindow_RequestRedraw(window);
+            nkWindow_PostInput(window, &event);
 
         } break;
 
@@ -330,35 +433,28 @@ static EM_BOOL MouseCallback(int eventType, const EmscriptenMouseEvent* e, void*
 
 static EM_BOOL WheelEventCallback(int eventType, const EmscriptenWheelEvent* e, void* userData)
 {   
-    printf("Wheel event: %d with delta (%f, %f)\n", eventType, e->deltaX, e->deltaY);
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_DEBUG, "input", "Wheel");
 
     if (windowHandle == NULL)
     {
         return false; /* no window to handle events for */
     }
 
-    float deltaX = -1.0f * (float)e->deltaX / 100.0f;
-    float deltaY = -1.0f * (float)e->deltaY / 100.0f;
+    nkEvent_t event = {
+        .type = NK_EVENT_SCROLL,
+        .timestamp = GetEventTime(e->mouse.timestamp),
+        .scroll = { -1.0f * (float)e->deltaX / 100.0f, -1.0f * (float)e->deltaY / 100.0f }
+    };
 
-    if (windowHandle->scrollCallback)
-    {
-        windowHandle->scrollCallback(windowHandle, deltaX, deltaY);
-    }
-
-    nkView_ProcessScroll(
-        windowHandle->rootView, 
-        deltaY, 
-        windowHandle->hotView
-    );
-
-    nkWindow_RequestRedraw(windowHandle);
+    nkWindow_PostInput(windowHandle, &event);
 
     return true;
 }
 
 static EM_BOOL TouchCallback(int eventType, const EmscriptenTouchEvent* e, void* userData)
 {
-    printf("Touch event: %d at (%d, %d)\n", eventType, e->touches[0].targetX, e->touches[0].targetY);
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_DEBUG, "input", "Touch");
+
     if (windowHandle == NULL)
     {
         return false; /* no window to handle events for */
@@ -374,65 +470,46 @@ static EM_BOOL TouchCallback(int eventType, const EmscriptenTouchEvent* e, void*
     {
         case EMSCRIPTEN_EVENT_TOUCHSTART:
         {
-            if (window->pointerMoveCallback)
-            {
-                window->pointerMoveCallback(window, x, y);
-            }
-
-            nkView_ProcessPointerMovement(window->rootView, x, y, &window->hotView, window->activeView, window->activeAction);
+            /* there is no hover before a touch, so move there first to find the hot view */
+            nkEvent_t moveEvent = {
+                .type = NK_EVENT_POINTER_MOVE,
+                .timestamp = GetEventTime(e->timestamp),
+                .pointer = { x, y }
+            };
 
-            if (window->pointerActionBeginCallback)
-            {
-                window->pointerActionBeginCallback(window, NK_POINTER_ACTION_PRIMARY, (float)e->touches[0].targetX, (float)e->touches[0].targetY);
-            }
+            nkWindow_PostInput(window, &moveEvent);
 
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_PRIMARY, 
-                POINTER_EVENT_BEGIN,
-                x, 
-                y, 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_ACTION_BEGIN,
+                .timestamp = GetEventTime(e->timestamp),
+                .pointerAction = { NK_POINTER_ACTION_PRIMARY, x, y }
+            };
 
-            nkWindow_RequestRedraw(window);
+            nkWindow_PostInput(window, &event);
 
         } break;
 
         case EMSCRIPTEN_EVENT_TOUCHEND:
         {
-            if (window->pointerActionEndCallback)
-            {
-                window->pointerActionEndCallback(window, NK_POINTER_ACTION_PRIMARY, (float)e->touches[0].targetX, (float)e->touches[0].targetY);
-            }
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_ACTION_END,
+                .timestamp = GetEventTime(e->timestamp),
+                .pointerAction = { NK_POINTER_ACTION_PRIMARY, x, y }
+            };
 
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_PRIMARY, 
-                POINTER_EVENT_END,
-                x, 
-                y, 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
+            nkWindow_PostInput(window, &event);
             
         } break;
 
         case EMSCRIPTEN_EVENT_TOUCHMOVE:
         {
-            if (window->pointerMoveCallback)
-            {
-                window->pointerMoveCallback(window, (float)e->touches[0].targetX, (float)e->touches[0].targetY);
-            }
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_MOVE,
+                .timestamp = GetEventTime(e->timestamp),
+                .pointer = { x, y }
+            };
 
-            nkView_ProcessPointerMovement(window->rootView, x, y, &window->hotView, window->activeView, window->activeAction);
-
-            nkWindow_RequestRedraw(window);
+            nkWindow_PostInput(window, &event);
 
         } break;
 
@@ -453,29 +530,40 @@ static EM_BOOL MouseLeaveCallback(int eventType, const EmscriptenMouseEvent* e,
         return false; /* no window to handle events for */
     }
 
-    nkWindow_t *window = windowHandle;
-
-    /* set origin to -1, -1 */
-    nkView_ProcessPointerAction(
-        window->rootView, 
-        window->activeAction, 
-        POINTER_EVENT_CANCEL,
-        -1.0f, 
-        -1.0f,
-        window->hotView, 
-        &window->activeView, 
-        &window->activeAction
-    );
+    nkEvent_t event = {
+        .type = NK_EVENT_POINTER_LEAVE,
+        .timestamp = GetEventTime(e->timestamp)
+    };
 
-    nkView_ProcessPointerMovement(window->rootView, -1.0f, -1.0f, &window->hotView, window->activeView, window->activeAction);
-
-    nkWindow_RequestRedraw(window);
+    nkWindow_PostInput(windowHandle, &event);
 
+    return true;
 }
 
 static EM_BOOL KeyCallback(int eventType, const EmscriptenKeyboardEvent* e, void* userData)
 {
+    if (windowHandle == NULL)
+    {
+        return false; /* no window to handle events for */
+    }
 
+    /* code names the physical key, so the keycode does not change with the layout */
+    uint32_t keycode = nkKeycode_FromCode(e->code);
+
+    if (keycode == 0)
+    {
+        return false; /* leave keys without a keycode to the browser */
+    }
+
+    nkEvent_t event = {
+        .type = (eventType == EMSCRIPTEN_EVENT_KEYDOWN) ? NK_EVENT_KEY_DOWN : NK_EVENT_KEY_UP,
+        .timestamp = GetEventTime(e->timestamp),
+        .key = { keycode }
+    };
+
+    nkWindow_PostInput(windowHandle, &event);
+
+    return true;
 }
 
 static EM_BOOL ResizeCallback(int eventType, const EmscriptenUiEvent* e, void* userData)
@@ -495,20 +583,13 @@ static EM_BOOL ResizeCallback(int eventType, const EmscriptenUiEvent* e, void* u
     float cssWidth = (float)EM_ASM_DOUBLE({ return window.innerWidth; });
     float cssHeight = (float)EM_ASM_DOUBLE({ return window.innerHeight; });
 
-    float width = (cssWidth * pixelRatio);
-    float height = (cssHeight * pixelRatio);
-
-    windowHandle->width = (float)width;
-    windowHandle->height = (float)height;
+    /* the dispatcher ignores a size that has not changed */
+    nkEvent_t event = {
+        .type = NK_EVENT_RESIZE,
+        .resize = { cssWidth * pixelRatio, cssHeight * pixelRatio }
+    };
 
-    if (windowHandle->resizeCallback)
-    {
-        windowHandle->resizeCallback(windowHandle, width, height);
-    }    
-
-    nkWindow_LayoutViews(windowHandle); 
-    
-    emscripten_request_animation_frame(DrawCallback, windowHandle);
+    nkWindow_PostInput(windowHandle, &event);
 
     return true;
 }
@@ -521,6 +602,49 @@ static EM_BOOL DrawCallback(double time, void* userData)
     {
         return false; /* nothing to render */
     }
+
+    double interval = time - lastAnimationFrame;
+    lastAnimationFrame = time;
+
+    if (interval >= FRAME_INTERVAL_MIN)
+    {
+        /* frames skipped while idle only make intervals longer, so a shorter one is taken at once */
+        if (animationFrameInterval == 0.0 || interval < animationFrameInterval * 0.75)
+        {
+            animationFrameInterval = interval;
+        }
+        else if (interval < animationFrameInterval * 1.5)
+        {
+            animationFrameInterval += (interval - animationFrameInterval) * FRAME_INTERVAL_CREEP;
+        }
+    }
+
+    /* under a frame rate cap, pass over the animation frames that come well before the deadline */
+    if (nkWindow_GetPaceDelay(window) * 1000.0 > animationFrameInterval * 0.5)
+    {
+        emscripten_request_animation_frame(DrawCallback, window);
+        return false;
+    }
+
+    return DrawFrame(window);
+}
+
+static void TimeoutCallback(void* userData)
+{
+    DrawFrame((nkWindow_t *)userData);
+}
+
+static EM_BOOL DrawFrame(nkWindow_t *window)
+{
+    /* motion and scroll since the last frame arrive as one event each */
+    nkWindow_DrainInput(window);
+
+    nkWindowDamage_t damage;
+
+    if (!nkWindow_BeginFrame(window, &damage))
+    {
+        return false; /* nothing to render */
+    }
     
     int canvasWidth;
     int canvasHeight;
@@ -533,29 +657,22 @@ static EM_BOOL DrawCallback(double time, void* userData)
     {
         /* If not, resize the canvas drawing buffer now, before we draw. */
         emscripten_set_canvas_element_size("#canvas", (int)window->width, (int)window->height);
-    }
-
-    glClearColor(
-        window->backgroundColor.r, 
-        window->backgroundColor.g, 
-        window->backgroundColor.b, 
-        window->backgroundColor.a
-    );
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    glViewport(0, 0, (int)window->width, (int)window->height);
-
-    nkDraw_Begin(&window->drawContext, window->width, window->height);
+        damage.full = true; /* resizing clears the drawing buffer */
+    }
 
-    nkWindow_RedrawViews(window); // Redraw the views in the window
+    nkWindow_RenderFrame(window, &damage);
 
-    if (window->drawCallback)
-    {
-        window->drawCallback(window);
-    }
+    /* only moves the deadline on, the wait was in getting here */
+    nkWindow_PaceFrame(window);
 
-    nkDraw_End(&window->drawContext);
+    /* the browser presents after this returns, out of our sight */
+    nkWindow_FinishFrame(window, nkWindow_GetTicks());
 
     return true;
-}   
\ No newline at end of file
+}   
+
+static double GetEventTime(double timestamp)
+{
+    return nkEventClock_Convert(&eventClock, timestamp / 1000.0);
+}
@@ -18,10 +18,14 @@
 #include <nanowin.h>
 #include <nanodraw.h>
 
+#include "nanowin_internal.h"
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
@@ -49,11 +53,28 @@
 #define WGL_DOUBLE_BUFFER_ARB               (0x2011U)
 #define WGL_PIXEL_TYPE_ARB                  (0x2013U)
 #define WGL_COLOR_BITS_ARB                  (0x2014U)
+#define WGL_SWAP_METHOD_ARB                 (0x2007U)
 #define WGL_DEPTH_BITS_ARB                  (0x2022U)
 #define WGL_STENCIL_BITS_ARB                (0x2023U)
 #define WGL_FULL_ACCELERATION_ARB           (0x2027U)
+#define WGL_SWAP_COPY_ARB                   (0x2029U)
 #define WGL_TYPE_RGBA_ARB                   (0x202BU)
 
+/* preferred, a back buffer that keeps its contents across swaps can redraw just the damage */
+const int preservedPixelFormatAttribs[] = 
+{
+    WGL_DRAW_TO_WINDOW_ARB,     GL_TRUE,
+    WGL_SUPPORT_OPENGL_ARB,     GL_TRUE,
+    WGL_DOUBLE_BUFFER_ARB,      GL_TRUE,
+    WGL_SWAP_METHOD_ARB,        WGL_SWAP_COPY_ARB,
+    WGL_ACCELERATION_ARB,       WGL_FULL_ACCELERATION_ARB,
+    WGL_PIXEL_TYPE_ARB,         WGL_TYPE_RGBA_ARB,
+    WGL_COLOR_BITS_ARB,         32,
+    WGL_DEPTH_BITS_ARB,         24,
+    WGL_STENCIL_BITS_ARB,       8,
+    0
+};
+
 const int pixelFormatAttribs[] = 
 {
     WGL_DRAW_TO_WINDOW_ARB,     GL_TRUE,
@@ -83,6 +104,8 @@ const wchar_t *WINDOW_CLASS_NAME = L"NanoKitWindowClass";
 
 typedef HGLRC WINAPI wglCreateContextAttribsARB_t(HDC hdc, HGLRC hShareContext, const int *attribList);
 typedef BOOL WINAPI wglChoosePixelFormatARB_t(HDC hdc, const int *piAttribIList, const FLOAT *pfAttribFList, UINT nMaxFormats, int *piFormats, UINT *nNumFormats);
+typedef BOOL WINAPI wglSwapIntervalEXT_t(int interval);
+typedef const char *WINAPI wglGetExtensionsStringEXT_t(void);
 
 /***************************************************************
 ** MARK: STATIC VARIABLES
@@ -92,6 +115,10 @@ static bool initialized = false;
 
 static wglCreateContextAttribsARB_t *wglCreateContextAttribsARB;
 static wglChoosePixelFormatARB_t* wglChoosePixelFormatARB;
+static wglSwapIntervalEXT_t *wglSwapIntervalEXT;
+
+/* WGL_EXT_swap_control_tear, a negative interval swaps a late frame at once instead of waiting a refresh */
+static bool swapTearSupported = false;
 
 static WNDCLASS windowClass;
 
@@ -99,9 +126,19 @@ static nkWindow_t *windowList = NULL;
 
 static HGLRC currentGlrc = NULL;
 
+/* set by nkWindow_EnableRenderThreads, windows created afterwards render and swap on a thread each */
+static bool renderThreaded = false;
+
+/* set by nkWindow_EnableSharedContexts, every context then shares objects with shareGlrc, the first
+   context in the group. Window contexts are never deleted, so it outlives the window that made it */
+static bool contextsShared = false;
+static HGLRC shareGlrc = NULL;
+
 static uint16_t highUnicodeSurrogate = 0;
 
-static LARGE_INTEGER frequency = {0}; /* for high precision timing */
+static HANDLE waitTimer = NULL; /* ends nkWindow_WaitEvents at the next timer deadline */
+
+static nkEventClock_t eventClock = {0}; /* message times, in milliseconds, onto our clock */
 
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
@@ -111,11 +148,13 @@ static void InitWin32(void);
 static bool InitOpenGL();
 
 static LPWSTR CreateWideString(const char* str);
+static void PresentWindow(nkWindow_t *window);
+static void ReleaseWindow(nkWindow_t *window);
 
 static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
-static uint32_t GetNkKeycodeFromWin32(WPARAM wParam);
-static WPARAM GetWin32KeycodeFromNk(WPARAM wParam);
+static void PostPointerAction(nkWindow_t *window, nkPointerAction_t action, bool begin, LPARAM lParam);
+static double GetEventTime(void);
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
@@ -175,8 +214,13 @@ bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float h
     HDC gldc = GetDC(hwnd);
 
     int pixelFormat;
-    UINT numFormats;
-    wglChoosePixelFormatARB(gldc, pixelFormatAttribs, 0, 1, &pixelFormat, &numFormats);
+    UINT numFormats = 0;
+    wglChoosePixelFormatARB(gldc, preservedPixelFormatAttribs, 0, 1, &pixelFormat, &numFormats);
+
+    if (!numFormats)
+    {
+        wglChoosePixelFormatARB(gldc, pixelFormatAttribs, 0, 1, &pixelFormat, &numFormats);
+    }
 
     if (!numFormats) 
     {
@@ -193,13 +237,18 @@ bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float h
         return 0;
     }
 
-    HGLRC glrc = wglCreateContextAttribsARB(gldc, 0, gl33Attribs);
+    HGLRC glrc = wglCreateContextAttribsARB(gldc, contextsShared ? shareGlrc : 0, gl33Attribs);
     if (!glrc) 
     {
         fprintf(stderr, "Failed to create OpenGL 3.3 context.");
         return 0;
     }
 
+    if (contextsShared && shareGlrc == NULL)
+    {
+        shareGlrc = glrc;
+    }
+
     if (!wglMakeCurrent(gldc, glrc)) 
     {
         fprintf(stderr, "Failed to activate OpenGL 3.3 rendering context.");
@@ -214,12 +263,20 @@ bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float h
         return false;
     }
 
-    nkDraw_CreateContext(&window->drawContext);
+    if (contextsShared)
+    {
+        nkSharedDraw_Acquire(&window->drawContext);
+    }
+    else
+    {
+        nkDraw_CreateContext(&window->drawContext);
+    }
 
     ShowWindow(hwnd, SW_SHOW);
 
     /* populate the window contents */
     window->next = NULL;
+    window->destroyed = false;
     window->title = title;
     window->width = width;
     window->height = height;
@@ -229,8 +286,52 @@ bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float h
     window->instanceHandle = instance;
     window->drawingContext = gldc;
     window->glRenderContext = glrc;
+    window->partialRedraw = (pfd.dwFlags & PFD_SWAP_COPY) != 0; /* the swap method is only a hint */
     window->cursorType = (uintptr_t)IDC_ARROW; /* default cursor type */
     window->backgroundColor = NK_COLOR_WHITE; /* default background color */
+    window->pointerActionState = 0;
+    memset(window->keyState, 0, sizeof(window->keyState));
+    memset(&window->frameTiming, 0, sizeof(window->frameTiming));
+    window->metrics = NULL;
+    window->pendingInput.type = NK_EVENT_NONE;
+    window->redrawRequested = false;
+    window->layoutDirty = true;
+    window->layoutSize = (nkSize_t){ 0.0f, 0.0f };
+    window->layoutGeneration = 0;
+    window->hotViewLayout = 0;
+    window->hotBounds = (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+    window->damage.full = true;
+    window->damage.count = 0;
+    window->swapInterval = NK_SWAP_INTERVAL_ON; /* left to the driver until set */
+    window->swapIntervalChanged = false;
+    window->maxFrameRate = 0.0f;
+    window->nextPresent = 0;
+    window->inputRing = NULL;
+    window->recording = NULL;
+    window->replay = NULL;
+    window->viewIndex = NULL;
+    window->renderThread = NULL;
+    window->postQueue = nkPostQueue_Create();
+
+    if (window->postQueue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate the posted event queue!\n");
+        return false;
+    }
+
+    if (renderThreaded)
+    {
+        /* a context can only be current on one thread, and the render thread takes this one over */
+        wglMakeCurrent(NULL, NULL);
+        currentGlrc = NULL;
+
+        window->renderThread = nkRenderThread_Create(window);
+
+        if (window->renderThread == NULL)
+        {
+            fprintf(stderr, "Failed to start a render thread, rendering inline.\n");
+        }
+    }
 
     /* add this window to the linked list */
     if (windowList == NULL)
@@ -275,24 +376,32 @@ void nkWindow_SetSize(nkWindow_t *window, float width, float height)
         return; /* nothing to do */
     }
 
-    /* set the window size */
+    /* width and height are the client area, as in nkWindow_Create */
+    RECT desiredClientRect;
+    desiredClientRect.left = 0;
+    desiredClientRect.top = 0;
+    desiredClientRect.right = (LONG)width;
+    desiredClientRect.bottom = (LONG)height;
+
+    AdjustWindowRect(&desiredClientRect, WS_OVERLAPPEDWINDOW, FALSE);
+
+    nkEvent_t event = {
+        .type = NK_EVENT_RESIZE,
+        .resize = { width, height }
+    };
+
+    /* resized, laid out, damaged and recorded as any resize. The WM_SIZE that SetWindowPos sends then
+       reports the same client size and is skipped, unless the system held the window to another size */
+    nkWindow_ApplyEvent(window, &event);
+
     SetWindowPos(
         window->windowHandle, 
         NULL, 
         0, 0, 
-        (int)width, (int)height, 
+        desiredClientRect.right - desiredClientRect.left, 
+        desiredClientRect.bottom - desiredClientRect.top, 
         SWP_NOZORDER | SWP_NOMOVE
     );
-
-    /* update the width and height in the window struct */
-    window->width = width;
-    window->height = height;
-
-    /* call the resize callback if it exists */
-    if (window->resizeCallback)
-    {
-        window->resizeCallback(window, width, height);
-    }
 }
 
 void nkWindow_SetVisibility(nkWindow_t *window, nkWindowVisibility_t visibility)
@@ -401,85 +510,38 @@ void nkWindow_Destroy(nkWindow_t *window)
         return; /* nothing to do */
     }
 
-    /* call the close callback if it exists */
-    if (window->closeCallback)
-    {
-        window->closeCallback(window);
-    }
+    ReleaseWindow(window);
 
-    /* destroy the window */
+    /* unlinked by now, so its WM_DESTROY does not find it and release it twice */
     DestroyWindow(window->windowHandle);
 }
 
-void nkWindow_RequestRedraw(nkWindow_t *window)
+void nkWindow_ScheduleFrame(nkWindow_t *window)
 {
-    if (window == NULL)
-    {
-        return; /* nothing to do */
-    }
-
     /* request a redraw by invalidating the window */
     InvalidateRect(window->windowHandle, NULL, TRUE);
 }
 
 bool nkWindow_IsPointerActionDown(nkWindow_t *window, nkPointerAction_t action)
 {
-    switch (action)
-    {
-        case NK_POINTER_ACTION_PRIMARY:
-        {
-            return (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0; /* check if the left mouse button is down */
-        } break;
-
-        case NK_POINTER_ACTION_SECONDARY:
-        {
-            return (GetAsyncKeyState(VK_RBUTTON) & 0x8000) != 0; /* check if the right mouse button is down */
-        } break;
-
-        case NK_POINTER_ACTION_TERTIARY:
-        {
-            return (GetAsyncKeyState(VK_MBUTTON) & 0x8000) != 0; /* check if the middle mouse button is down */
-        } break;
-
-        case NK_POINTER_ACTION_EXTENDED_1:
-        {
-            return (GetAsyncKeyState(VK_XBUTTON1) & 0x8000) != 0; /* check if the first extended button is down */
-        } break;
-
-        case NK_POINTER_ACTION_EXTENDED_2:
-        {
-            return (GetAsyncKeyState(VK_XBUTTON2) & 0x8000) != 0; /* check if the second extended button is down */
-        } break;
-
-        default:
-        {
-            return false; /* invalid action */
-        } break;
-    }
+    return nkWindow_TestPointerActionState(window, action);
 }
 
 bool nkWindow_IsKeyDown(nkWindow_t *window, uint32_t keycode)
 {
-    WPARAM wParam = GetWin32KeycodeFromNk(keycode);
-    if (wParam != 0)
-    {
-        return (GetAsyncKeyState((int)wParam) & 0x8000) != 0; /* check if the key is down */
-    }
-    else
-    {
-        return false; /* invalid keycode */
-    }
+    return nkWindow_TestKeyState(window, keycode);
 }
 
 void nkWindow_RedrawViews(nkWindow_t *window)
 {
     if (window == NULL || window->rootView == NULL)
     {
-        printf("Window contains no views!\n");
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Window contains no views");
         return;
     }
 
-    if (currentGlrc != window->glRenderContext)
+    /* on a render thread its context is always current */
+    if (window->renderThread == NULL && currentGlrc != window->glRenderContext)
     {
         wglMakeCurrent(window->drawingContext, window->glRenderContext);
         currentGlrc = window->glRenderContext;
@@ -488,17 +550,6 @@ void nkWindow_RedrawViews(nkWindow_t *window)
     nkView_RenderTree(window->rootView, &window->drawContext);
 }
 
-void nkWindow_LayoutViews(nkWindow_t *window)
-{
-    if (window == NULL || window->rootView == NULL)
-    {
-        printf("Window contains no views!\n");
-        return;
-    }
-
-    nkView_LayoutTree(window->rootView, (nkSize_t){window->width, window->height}, &window->drawContext);
-}
-
 bool nkWindow_PollEvents(void)
 {
     
@@ -512,14 +563,20 @@ bool nkWindow_PollEvents(void)
 
         while (current != NULL)
         {
-            if (currentGlrc != current->glRenderContext)
+            nkWindow_LayoutViews(current);
+
+            /* a render thread draws the first frame from the first WM_PAINT */
+            if (current->renderThread == NULL)
             {
-                wglMakeCurrent(current->drawingContext, current->glRenderContext);
-                currentGlrc = current->glRenderContext;
+                if (currentGlrc != current->glRenderContext)
+                {
+                    wglMakeCurrent(current->drawingContext, current->glRenderContext);
+                    currentGlrc = current->glRenderContext;
+                }
+
+                nkWindow_RedrawViews(current);
             }
 
-            nkWindow_LayoutViews(current);
-            nkWindow_RedrawViews(current);
             current = current->next;
         }
     }
@@ -541,9 +598,135 @@ bool nkWindow_PollEvents(void)
         DispatchMessage(&msg);
     }
 
+    /* timers due by now, before the frame so what they change is drawn in it */
+    nkWindow_ServiceTimers();
+
+    /* deliver the motion held back for merging */
+    nkWindow_t *current = windowList;
+    while (current != NULL)
+    {
+        nkWindow_t *next = current->next;
+
+        nkWindow_DrainInput(current);
+
+        current = next;
+    }
+
+    return true;
+}
+
+void nkWindow_WakeEventLoop(nkWindow_t *window)
+{
+    /* any message wakes MsgWaitForMultipleObjectsEx, and the pump then drains the queue */
+    PostMessage(window->windowHandle, WM_NULL, 0, 0);
+}
+
+bool nkWindow_WaitEvents(double timeoutSeconds)
+{
+    /* wake for the next timer too */
+    timeoutSeconds = nkWindow_GetTimerTimeout(timeoutSeconds);
+
+    /* MWMO_INPUTAVAILABLE also returns for messages already queued but not yet read,
+       and a redraw we requested is a pending WM_PAINT, so it wakes this too */
+    if (timeoutSeconds < 0.0 || waitTimer == NULL)
+    {
+        /* rounded up, so the wait does not end just before the timer it is for and spin on a 0 ms timeout */
+        DWORD timeout = (timeoutSeconds < 0.0) ? INFINITE : (DWORD)ceil(timeoutSeconds * 1000.0);
+
+        MsgWaitForMultipleObjectsEx(0, NULL, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+    }
+    else
+    {
+        /* a waitable timer keeps the deadline to 100ns, a wait timeout only to the scheduler tick.
+           A negative due time is relative, and zero has already passed */
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -(LONGLONG)(timeoutSeconds * 1e7);
+
+        SetWaitableTimer(waitTimer, &dueTime, 0, NULL, NULL, FALSE);
+        MsgWaitForMultipleObjectsEx(1, &waitTimer, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        CancelWaitableTimer(waitTimer);
+    }
+
+    return nkWindow_PollEvents();
+}
+
+float nkWindow_GetRefreshRate(nkWindow_t *window)
+{
+    if (window == NULL)
+    {
+        return 0.0f;
+    }
+
+    MONITORINFOEXW monitorInfo;
+    monitorInfo.cbSize = sizeof(monitorInfo);
+
+    if (!GetMonitorInfoW(MonitorFromWindow(window->windowHandle, MONITOR_DEFAULTTONEAREST), (MONITORINFO *)&monitorInfo))
+    {
+        return 0.0f;
+    }
+
+    DEVMODEW mode;
+    memset(&mode, 0, sizeof(mode));
+    mode.dmSize = sizeof(mode);
+
+    /* 0 and 1 stand for the hardware's default rate, which is not reported */
+    if (!EnumDisplaySettingsW(monitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &mode) || mode.dmDisplayFrequency <= 1)
+    {
+        return 0.0f;
+    }
+
+    return (float)mode.dmDisplayFrequency;
+}
+
+bool nkWindow_EnableInputThread(void)
+{
+    /* a window's messages only reach the thread that created it, and the modal
+       size and move loops need layout to run inside WindowProc, so input stays inline */
+    return false;
+}
+
+bool nkWindow_EnableSharedContexts(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    contextsShared = true;
+
+    return true;
+}
+
+bool nkWindow_EnableRenderThreads(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    renderThreaded = true;
+
     return true;
 }
 
+bool nkWindow_BindRenderThread(nkWindow_t *target)
+{
+    return wglMakeCurrent(target->drawingContext, target->glRenderContext) == TRUE;
+}
+
+void nkWindow_PresentFrame(nkWindow_t *target, nkWindowDamage_t *damage)
+{
+    nkWindow_RenderFrame(target, damage);
+    PresentWindow(target);
+}
+
+void nkWindow_UnbindRenderThread(nkWindow_t *window, nkWindow_t *target)
+{
+    wglMakeCurrent(NULL, NULL);
+
+    window->drawContext = target->drawContext;
+}
+
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
@@ -556,11 +739,100 @@ static LPWSTR CreateWideString(const char* str)
     return wstr;
 }
 
+static void PresentWindow(nkWindow_t *window)
+{
+    if (window->swapIntervalChanged && wglSwapIntervalEXT != NULL)
+    {
+        int interval = (window->swapInterval == NK_SWAP_INTERVAL_OFF) ? 0 : 1;
+
+        if (window->swapInterval == NK_SWAP_INTERVAL_ADAPTIVE && swapTearSupported)
+        {
+            interval = -1;
+        }
+
+        /* applies to the context current on this thread, which is the window's */
+        wglSwapIntervalEXT(interval);
+    }
+
+    window->swapIntervalChanged = false;
+
+    nkWindow_PaceFrame(window);
+
+    uint64_t presentStart = nkWindow_GetTicks();
+    SwapBuffers(window->drawingContext);
+    nkWindow_FinishFrame(window, presentStart);
+}
+
+static void ReleaseWindow(nkWindow_t *window)
+{
+    window->destroyed = true;
+
+    const nkWindowDelegate_t *delegate = nkWindow_GetDelegate(window);
+
+    /* call the close callback if it exists */
+    if (delegate->closeCallback)
+    {
+        delegate->closeCallback(window);
+    }
+
+    /* the render thread draws to the window's DC, which goes with the window, so it has to stop first */
+    nkRenderThread_Destroy(window->renderThread);
+    window->renderThread = NULL;
+
+    if (windowList == window && window->next == NULL)
+    {
+        windowList = NULL;
+        PostQuitMessage(0); /* quit if this is the last */
+    }
+    else if (windowList == window)
+    {
+        windowList = window->next; /* remove from head */
+    }
+    else
+    {
+        nkWindow_t *prev = windowList;
+        while (prev->next != window && prev->next != NULL)
+        {
+            prev = prev->next;
+        }
+
+        if (prev->next == window)
+        {
+            prev->next = window->next; /* remove from middle or end */
+        }
+    }
+
+    window->next = NULL;
+
+    if (contextsShared && nkSharedDraw_Release())
+    {
+        shareGlrc = NULL; /* the next window starts a new group */
+    }
+
+    nkPostQueue_Destroy(window->postQueue);
+    window->postQueue = NULL;
+
+    /* flushes and closes a recording the user ended by closing the window */
+    nkWindow_StopRecording(window);
+    nkWindow_StopReplay(window);
+
+    nkViewIndex_Destroy(window->viewIndex);
+    window->viewIndex = NULL;
+
+    nkWindow_DestroyMetrics(window);
+}
+
 static void InitWin32()
 {
     SetConsoleOutputCP(CP_UTF8);
 
-    QueryPerformanceFrequency(&frequency); /* get the frequency for high precision timing */
+    /* high resolution timers are Windows 10 1803 and later, older systems get the default resolution */
+    waitTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+    if (waitTimer == NULL)
+    {
+        waitTimer = CreateWaitableTimerW(NULL, FALSE, NULL);
+    }
 
     windowClass.style = CS_HREDRAW | CS_VREDRAW | CS_OWNDC;
     windowClass.lpfnWndProc = WindowProc;
@@ -655,6 +927,15 @@ static bool InitOpenGL()
 
     wglCreateContextAttribsARB = (wglCreateContextAttribsARB_t*)wglGetProcAddress("wglCreateContextAttribsARB");
     wglChoosePixelFormatARB = (wglChoosePixelFormatARB_t*)wglGetProcAddress("wglChoosePixelFormatARB");
+    wglSwapIntervalEXT = (wglSwapIntervalEXT_t*)wglGetProcAddress("wglSwapIntervalEXT");
+
+    wglGetExtensionsStringEXT_t *wglGetExtensionsStringEXT = (wglGetExtensionsStringEXT_t*)wglGetProcAddress("wglGetExtensionsStringEXT");
+
+    if (wglGetExtensionsStringEXT != NULL)
+    {
+        const char *extensions = wglGetExtensionsStringEXT();
+        swapTearSupported = (extensions != NULL && strstr(extensions, "WGL_EXT_swap_control_tear") != NULL);
+    }
 
     wglMakeCurrent(tempDc, 0);
     wglDeleteContext(tempContext);
@@ -704,10 +985,13 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     uint32_t codepoint = ((highUnicodeSurrogate - 0xD800) << 10) | (u16Codepoint - 0xDC00);
                     codepoint += 0x10000; /* adjust to full Unicode codepoint range */
 
-                    if (window->codepointInputCallback)
-                    {
-                        window->codepointInputCallback(window, codepoint);
-                    }
+                    nkEvent_t event = {
+                        .type = NK_EVENT_CODEPOINT_INPUT,
+                        .timestamp = GetEventTime(),
+                        .codepoint = { codepoint }
+                    };
+
+                    nkWindow_PostInput(window, &event);
 
                     highUnicodeSurrogate = 0; /* reset the high surrogate */
                 }
@@ -715,32 +999,41 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             else
             {
                 /* handle as a single codepoint, filtering out control keys such as delete and backspace */
-                if (window->codepointInputCallback && u16Codepoint > 0x1F)
+                if (u16Codepoint > 0x1F && u16Codepoint != 0x7F)
                 {
-                    window->codepointInputCallback(window, u16Codepoint);
+                    nkEvent_t event = {
+                        .type = NK_EVENT_CODEPOINT_INPUT,
+                        .timestamp = GetEventTime(),
+                        .codepoint = { u16Codepoint }
+                    };
+
+                    nkWindow_PostInput(window, &event);
                 }
             }
         } break;
 
         case WM_SIZE:
         {
-            nkWindowVisibility_t prevVisibility = window->visibility;
+            nkEvent_t visibilityEvent = {
+                .type = NK_EVENT_VISIBILITY_CHANGE,
+                .visibility = window->visibility
+            };
 
             switch (wParam)
             {
                 case SIZE_MINIMIZED:
                 {
-                    window->visibility = NK_WINDOW_VISIBILITY_MINIMIZED;
+                    visibilityEvent.visibility = NK_WINDOW_VISIBILITY_MINIMIZED;
                 } break;
 
                 case SIZE_MAXIMIZED:
                 {
-                    window->visibility = NK_WINDOW_VISIBILITY_MAXIMIZED;
+                    visibilityEvent.visibility = NK_WINDOW_VISIBILITY_MAXIMIZED;
                 } break;
                     
                 case SIZE_RESTORED:
                 {
-                    window->visibility = NK_WINDOW_VISIBILITY_VISIBLE;
+                    visibilityEvent.visibility = NK_WINDOW_VISIBILITY_VISIBLE;
                 } break;
 
                 default:
@@ -749,89 +1042,64 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 } break;
             }
 
-            if (window->visibilityChangeCallback && window->visibility != prevVisibility)
-            {
-                window->visibilityChangeCallback(window, window->visibility);
-            }
-
-            float width = LOWORD(lParam);
-            float height = HIWORD(lParam);
+            nkWindow_PostInput(window, &visibilityEvent);
 
-            window->width = width;
-            window->height = height;
+            nkEvent_t resizeEvent = {
+                .type = NK_EVENT_RESIZE,
+                .resize = { (float)LOWORD(lParam), (float)HIWORD(lParam) }
+            };
 
-            if (window->resizeCallback)
-            {
-                window->resizeCallback(window, width, height);
-            }
-
-            nkWindow_LayoutViews(window); 
+            nkWindow_PostInput(window, &resizeEvent);
 
         } break;
 
         case WM_DESTROY:
         {
-            if (window->closeCallback)
-            {
-                window->closeCallback(window);
-            }
-
-            if (windowList == window && window->next == NULL)
-            {
-                PostQuitMessage(0); /* quit if this is the last */
-            }
-            else if (windowList == window)
-            {
-                windowList = window->next; /* remove from head */
-            }
-            else
-            {
-                nkWindow_t *prev = windowList;
-                while (prev->next != window && prev->next != NULL)
-                {
-                    prev = prev->next;
-                }
-
-                if (prev->next == window)
-                {
-                    prev->next = window->next; /* remove from middle or end */
-                }
-            }
+            /* closed from the title bar, so nkWindow_Destroy was never called */
+            ReleaseWindow(window);
         } break;
 
         case WM_PAINT:
         {
-            if (currentGlrc != window->glRenderContext)
+            /* WM_PAINT can come before the pump ends, so deliver held back motion first */
+            nkWindow_DrainInput(window);
+
+            if (window->renderThread == NULL && currentGlrc != window->glRenderContext)
             {
                 wglMakeCurrent(window->drawingContext, window->glRenderContext);
                 currentGlrc = window->glRenderContext;
             }
 
-            BeginPaint(hwnd, &window->paintStruct);
-
-            glClearColor(
-                window->backgroundColor.r, 
-                window->backgroundColor.g, 
-                window->backgroundColor.b, 
-                window->backgroundColor.a
-            );
-            glClear(GL_COLOR_BUFFER_BIT);
-
-            glViewport(0, 0, (int)window->width, (int)window->height);
+            PAINTSTRUCT paintStruct; /* only needed between BeginPaint and EndPaint */
+            BeginPaint(hwnd, &paintStruct);
 
-            nkDraw_Begin(&window->drawContext, window->width, window->height);
+            bool requested = window->redrawRequested;
 
-            nkWindow_RedrawViews(window); // Redraw the views in the window
+            nkWindowDamage_t damage;
+            bool changed = nkWindow_BeginFrame(window, &damage);
 
-            if (window->drawCallback)
+            if (!requested)
             {
-                window->drawCallback(window);
+                /* invalidated by the system rather than by us, so nothing we drew can be trusted */
+                damage.full = true;
+                changed = true;
             }
 
-            nkDraw_End(&window->drawContext);
+            if (changed && window->renderThread != NULL)
+            {
+                /* drawn and swapped on the render thread, the paint only hands it the frame */
+                if (!nkRenderThread_Submit(window->renderThread, &damage))
+                {
+                    nkWindow_RequestRedraw(window);
+                }
+            }
+            else if (changed)
+            {
+                nkWindow_RenderFrame(window, &damage);
+                PresentWindow(window);
+            }
 
-            SwapBuffers(window->drawingContext);
-            EndPaint(hwnd, &window->paintStruct);
+            EndPaint(hwnd, &paintStruct);
             
         } break;    
         
@@ -847,27 +1115,19 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
         case WM_ACTIVATE:
         {
-            if (LOWORD(wParam) == WA_ACTIVE || LOWORD(wParam) == WA_CLICKACTIVE)
-            {
-                if (window->focusChangeCallback)
-                {
-                    window->focusChangeCallback(window, NK_WINDOW_FOCUS_FOCUSED);
-                }
-            }
-            else
-            {
-                if (window->focusChangeCallback)
-                {
-                    window->focusChangeCallback(window, NK_WINDOW_FOCUS_UNFOCUSED);
-                }
-            }
+            bool active = (LOWORD(wParam) == WA_ACTIVE || LOWORD(wParam) == WA_CLICKACTIVE);
+
+            nkEvent_t event = {
+                .type = NK_EVENT_FOCUS_CHANGE,
+                .focus = active ? NK_WINDOW_FOCUS_FOCUSED : NK_WINDOW_FOCUS_UNFOCUSED
+            };
+
+            nkWindow_PostInput(window, &event);
+
         } break;
 
         case WM_MOUSEMOVE:
         {
-            float x = (float)GET_X_LPARAM(lParam);
-            float y = (float)GET_Y_LPARAM(lParam);
-
             /* Request WM_MOUSELEAVE */
             TRACKMOUSEEVENT tme;
             tme.cbSize = sizeof(tme);
@@ -875,214 +1135,66 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             tme.hwndTrack = hwnd;
             TrackMouseEvent(&tme);
 
-            if (window->pointerMoveCallback)
-            {
-                window->pointerMoveCallback(window, x, y);
-            }
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_MOVE,
+                .timestamp = GetEventTime(),
+                .pointer = { (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam) }
+            };
 
-            nkView_ProcessPointerMovement(window->rootView, x, y, &window->hotView, window->activeView, window->activeAction);
-
-            nkWindow_RequestRedraw(window);
+            nkWindow_PostInput(window, &event);
 
         } break;
 
         case WM_MOUSELEAVE:
         {   
-            
-            /* set origin to -1, -1 */
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                window->activeAction, 
-                POINTER_EVENT_CANCEL,
-                -1.0f, 
-                -1.0f,
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkView_ProcessPointerMovement(window->rootView, -1.0f, -1.0f, &window->hotView, window->activeView, window->activeAction);
-        
-            nkWindow_RequestRedraw(window);
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_LEAVE,
+                .timestamp = GetEventTime()
+            };
+
+            nkWindow_PostInput(window, &event);
 
         } break;
 
         case WM_LBUTTONDOWN:
         {
-            if (window->pointerActionBeginCallback)
-            {
-                window->pointerActionBeginCallback(window, NK_POINTER_ACTION_PRIMARY, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_PRIMARY, 
-                POINTER_EVENT_BEGIN,
-                (float)GET_X_LPARAM(lParam), 
-                (float)GET_Y_LPARAM(lParam), 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-
+            PostPointerAction(window, NK_POINTER_ACTION_PRIMARY, true, lParam);
         } break;
 
         case WM_LBUTTONUP:
         {
-            if (window->pointerActionEndCallback)
-            {
-                window->pointerActionEndCallback(window, NK_POINTER_ACTION_PRIMARY, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_PRIMARY, 
-                POINTER_EVENT_END,
-                (float)GET_X_LPARAM(lParam), 
-                (float)GET_Y_LPARAM(lParam), 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-            
+            PostPointerAction(window, NK_POINTER_ACTION_PRIMARY, false, lParam);
         } break;
 
         case WM_RBUTTONDOWN:
         {
-            if (window->pointerActionBeginCallback)
-            {
-                window->pointerActionBeginCallback(window, NK_POINTER_ACTION_SECONDARY, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_SECONDARY, 
-                POINTER_EVENT_BEGIN,
-                (float)GET_X_LPARAM(lParam), 
-                (float)GET_Y_LPARAM(lParam), 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-
+            PostPointerAction(window, NK_POINTER_ACTION_SECONDARY, true, lParam);
         } break;
 
         case WM_RBUTTONUP:
         {
-            if (window->pointerActionEndCallback)
-            {
-                window->pointerActionEndCallback(window, NK_POINTER_ACTION_SECONDARY, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_SECONDARY, 
-                POINTER_EVENT_END,
-                (float)GET_X_LPARAM(lParam), 
-                (float)GET_Y_LPARAM(lParam), 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-
+            PostPointerAction(window, NK_POINTER_ACTION_SECONDARY, false, lParam);
         } break;
 
         case WM_MBUTTONDOWN:
         {
-            if (window->pointerActionBeginCallback)
-            {
-                window->pointerActionBeginCallback(window, NK_POINTER_ACTION_TERTIARY, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_TERTIARY, 
-                POINTER_EVENT_BEGIN,
-                (float)GET_X_LPARAM(lParam), 
-                (float)GET_Y_LPARAM(lParam), 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-
+            PostPointerAction(window, NK_POINTER_ACTION_TERTIARY, true, lParam);
         } break;
 
         case WM_MBUTTONUP:
         {
-            if (window->pointerActionEndCallback)
-            {
-                window->pointerActionEndCallback(window, NK_POINTER_ACTION_TERTIARY, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-            }
-
-            nkView_ProcessPointerAction(
-                window->rootView, 
-                NK_POINTER_ACTION_TERTIARY, 
-                POINTER_EVENT_END,
-                (float)GET_X_LPARAM(lParam), 
-                (float)GET_Y_LPARAM(lParam), 
-                window->hotView, 
-                &window->activeView, 
-                &window->activeAction
-            );
-
-            nkWindow_RequestRedraw(window);
-
+            PostPointerAction(window, NK_POINTER_ACTION_TERTIARY, false, lParam);
         } break;
 
         case WM_XBUTTONDOWN:
         {
             if (GET_XBUTTON_WPARAM(wParam) == XBUTTON1)
             {
-                if (window->pointerActionBeginCallback)
-                {
-                    window->pointerActionBeginCallback(window, NK_POINTER_ACTION_EXTENDED_1, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-                }
-
-                nkView_ProcessPointerAction(
-                    window->rootView, 
-                    NK_POINTER_ACTION_EXTENDED_1, 
-                    POINTER_EVENT_BEGIN,
-                    (float)GET_X_LPARAM(lParam), 
-                    (float)GET_Y_LPARAM(lParam), 
-                    window->hotView, 
-                    &window->activeView, 
-                    &window->activeAction
-                );
-
-                nkWindow_RequestRedraw(window);
-
-
-
+                PostPointerAction(window, NK_POINTER_ACTION_EXTENDED_1, true, lParam);
             }
             else if (GET_XBUTTON_WPARAM(wParam) == XBUTTON2)
             {
-                if (window->pointerActionBeginCallback)
-                {
-                    window->pointerActionBeginCallback(window, NK_POINTER_ACTION_EXTENDED_2, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-                }
-
-                 nkView_ProcessPointerAction(
-                    window->rootView, 
-                    NK_POINTER_ACTION_EXTENDED_2, 
-                    POINTER_EVENT_BEGIN,
-                    (float)GET_X_LPARAM(lParam), 
-                    (float)GET_Y_LPARAM(lParam), 
-                    window->hotView, 
-                    &window->activeView, 
-                    &window->activeAction
-                );
-
-                nkWindow_RequestRedraw(window);
+                PostPointerAction(window, NK_POINTER_ACTION_EXTENDED_2, true, lParam);
             }
         } break;
 
@@ -1090,81 +1202,48 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
         {
             if (GET_XBUTTON_WPARAM(wParam) == XBUTTON1)
             {
-                if (window->pointerActionEndCallback)
-                {
-                    window->pointerActionEndCallback(window, NK_POINTER_ACTION_EXTENDED_1, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-                }
-
-                nkView_ProcessPointerAction(
-                    window->rootView, 
-                    NK_POINTER_ACTION_EXTENDED_1, 
-                    POINTER_EVENT_END,
-                    (float)GET_X_LPARAM(lParam), 
-                    (float)GET_Y_LPARAM(lParam), 
-                    window->hotView, 
-                    &window->activeView, 
-                    &window->activeAction
-                );
-
-                nkWindow_RequestRedraw(window);
+                PostPointerAction(window, NK_POINTER_ACTION_EXTENDED_1, false, lParam);
             }
             else if (GET_XBUTTON_WPARAM(wParam) == XBUTTON2)
             {
-                if (window->pointerActionEndCallback)
-                {
-                    window->pointerActionEndCallback(window, NK_POINTER_ACTION_EXTENDED_2, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam));
-                }
-
-                nkView_ProcessPointerAction(
-                    window->rootView, 
-                    NK_POINTER_ACTION_EXTENDED_2, 
-                    POINTER_EVENT_END,
-                    (float)GET_X_LPARAM(lParam), 
-                    (float)GET_Y_LPARAM(lParam), 
-                    window->hotView, 
-                    &window->activeView, 
-                    &window->activeAction
-                );
-
-                nkWindow_RequestRedraw(window);
+                PostPointerAction(window, NK_POINTER_ACTION_EXTENDED_2, false, lParam);
             }
         } break;
 
         case WM_MOUSEWHEEL:
         {
-            float deltaX = 0.0f;
-            float deltaY = (float)GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA;
+            nkEvent_t event = {
+                .type = NK_EVENT_SCROLL,
+                .timestamp = GetEventTime(),
+                .scroll = { 0.0f, (float)GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA }
+            };
 
-            if (window->scrollCallback)
-            {
-                window->scrollCallback(window, deltaX, deltaY);
-            }
-
-            nkView_ProcessScroll(
-                window->rootView, 
-                deltaY, 
-                window->hotView
-            );
+            nkWindow_PostInput(window, &event);
 
-            nkWindow_RequestRedraw(window);
         } break;
 
         case WM_KEYDOWN:
         {
-            uint32_t keycode = GetNkKeycodeFromWin32(wParam);
-            if (window->keyDownCallback)
-            {
-                window->keyDownCallback(window, keycode);
-            }
+            nkEvent_t event = {
+                .type = NK_EVENT_KEY_DOWN,
+                .timestamp = GetEventTime(),
+                .key = { nkKeycode_FromVirtualKey((uint32_t)wParam) }
+            };
+
+            nkWindow_PostInput(window, &event);
+
         } break;
 
         case WM_KEYUP:
         {
-            uint32_t keycode = GetNkKeycodeFromWin32(wParam);
-            if (window->keyUpCallback)
-            {
-                window->keyUpCallback(window, keycode);
-            }
+            nkEvent_t event = {
+                .type = NK_EVENT_KEY_UP,
+                .timestamp = GetEventTime(),
+                .key = { nkKeycode_FromVirtualKey((uint32_t)wParam) }
+            };
+
+            nkWindow_PostInput(window, &event);
+
         } break;
         
         default: 
@@ -1176,133 +1255,30 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
     return DefWindowProc(hwnd, uMsg, wParam, lParam);  
 }
 
-static uint32_t GetNkKeycodeFromWin32(WPARAM wParam)
+static void PostPointerAction(nkWindow_t *window, nkPointerAction_t action, bool begin, LPARAM lParam)
 {
-    switch (wParam)
+    nkEvent_t event = {
+        .type = begin ? NK_EVENT_POINTER_ACTION_BEGIN : NK_EVENT_POINTER_ACTION_END,
+        .timestamp = GetEventTime(),
+        .pointerAction = { action, (float)GET_X_LPARAM(lParam), (float)GET_Y_LPARAM(lParam) }
+    };
+
+    /* captured while any button is down, so a release outside the window still arrives */
+    if (begin)
     {
-        case VK_SPACE: return NK_KEYCODE_SPACE;
-        case VK_BACK: return NK_KEYCODE_BACKSPACE;
-        case VK_TAB: return NK_KEYCODE_TAB;
-        case VK_CLEAR: return NK_KEYCODE_CLEAR;
-        case VK_RETURN: return NK_KEYCODE_RETURN;
-        case VK_PAUSE: return NK_KEYCODE_PAUSE;
-        case VK_ESCAPE: return NK_KEYCODE_ESCAPE;
-        case VK_DELETE: return NK_KEYCODE_DELETE;
-
-        case VK_SHIFT: return NK_KEYCODE_SHIFT;
-        case VK_CONTROL: return NK_KEYCODE_CONTROL;
-        case VK_LWIN: return NK_KEYCODE_META;
-        case VK_RWIN: return NK_KEYCODE_META;
-        case VK_MENU: return NK_KEYCODE_ALT;
-
-        case VK_PRIOR: return NK_KEYCODE_PAGE_UP;
-        case VK_NEXT: return NK_KEYCODE_PAGE_DOWN;
-        case VK_END: return NK_KEYCODE_END;
-        case VK_HOME: return NK_KEYCODE_HOME;
-        case VK_LEFT: return NK_KEYCODE_LEFT;
-        case VK_UP: return NK_KEYCODE_UP;
-        case VK_RIGHT: return NK_KEYCODE_RIGHT;
-        case VK_DOWN: return NK_KEYCODE_DOWN;
-
-        case VK_SELECT: return NK_KEYCODE_SELECT;
-        case VK_PRINT: return NK_KEYCODE_PRINT;
-        case VK_EXECUTE: return NK_KEYCODE_EXECUTE;
-        case VK_INSERT: return NK_KEYCODE_INSERT;
-        case VK_HELP: return NK_KEYCODE_HELP;
-
-        case VK_F1: return NK_KEYCODE_F1;
-        case VK_F2: return NK_KEYCODE_F2;
-        case VK_F3: return NK_KEYCODE_F3;
-        case VK_F4: return NK_KEYCODE_F4;
-        case VK_F5: return NK_KEYCODE_F5;
-        case VK_F6: return NK_KEYCODE_F6;
-        case VK_F7: return NK_KEYCODE_F7;
-        case VK_F8: return NK_KEYCODE_F8;
-        case VK_F9: return NK_KEYCODE_F9;
-        case VK_F10: return NK_KEYCODE_F10;
-        case VK_F11: return NK_KEYCODE_F11;
-        case VK_F12: return NK_KEYCODE_F12;
-        case VK_F13: return NK_KEYCODE_F13;
-        case VK_F14: return NK_KEYCODE_F14;
-        case VK_F15: return NK_KEYCODE_F15;
-        case VK_F16: return NK_KEYCODE_F16;
-        case VK_F17: return NK_KEYCODE_F17;
-        case VK_F18: return NK_KEYCODE_F18;
-        case VK_F19: return NK_KEYCODE_F19;
-        case VK_F20: return NK_KEYCODE_F20;
-        case VK_F21: return NK_KEYCODE_F21;
-        case VK_F22: return NK_KEYCODE_F22;
-        case VK_F23: return NK_KEYCODE_F23;
-        case VK_F24: return NK_KEYCODE_F24;
+        SetCapture(window->windowHandle);
+    }
 
-        default:
-        {
-            return 0;
-        } break;
+    nkWindow_PostInput(window, &event);
+
+    if (!begin && window->pointerActionState == 0)
+    {
+        ReleaseCapture();
     }
 }
 
-static WPARAM GetWin32KeycodeFromNk(WPARAM wParam)
+static double GetEventTime(void)
 {
-    switch (wParam)
-    {
-        case NK_KEYCODE_SPACE: return VK_SPACE;
-        case NK_KEYCODE_BACKSPACE: return VK_BACK;
-        case NK_KEYCODE_TAB: return VK_TAB;
-        case NK_KEYCODE_CLEAR: return VK_CLEAR;
-        case NK_KEYCODE_RETURN: return VK_RETURN;
-        case NK_KEYCODE_PAUSE: return VK_PAUSE;
-        case NK_KEYCODE_ESCAPE: return VK_ESCAPE;
-        case NK_KEYCODE_DELETE: return VK_DELETE;
-
-        case NK_KEYCODE_SHIFT: return VK_SHIFT;
-        case NK_KEYCODE_CONTROL: return VK_CONTROL;
-        case NK_KEYCODE_META: return VK_LWIN;
-        case NK_KEYCODE_ALT: return VK_MENU;
-
-        case NK_KEYCODE_PAGE_UP: return VK_PRIOR;
-        case NK_KEYCODE_PAGE_DOWN: return VK_NEXT;
-        case NK_KEYCODE_END: return VK_END;
-        case NK_KEYCODE_HOME: return VK_HOME;
-        case NK_KEYCODE_LEFT: return VK_LEFT;
-        case NK_KEYCODE_UP: return VK_UP;
-        case NK_KEYCODE_RIGHT: return VK_RIGHT;
-        case NK_KEYCODE_DOWN: return VK_DOWN;
-
-        case NK_KEYCODE_SELECT: return VK_SELECT;
-        case NK_KEYCODE_PRINT: return VK_PRINT;
-        case NK_KEYCODE_EXECUTE: return VK_EXECUTE;
-        case NK_KEYCODE_INSERT: return VK_INSERT;
-        case NK_KEYCODE_HELP: return VK_HELP;
-
-        case NK_KEYCODE_F1: return VK_F1;
-        case NK_KEYCODE_F2: return VK_F2;
-        case NK_KEYCODE_F3: return VK_F3;
-        case NK_KEYCODE_F4: return VK_F4;
-        case NK_KEYCODE_F5: return VK_F5;
-        case NK_KEYCODE_F6: return VK_F6;
-        case NK_KEYCODE_F7: return VK_F7;
-        case NK_KEYCODE_F8: return VK_F8;
-        case NK_KEYCODE_F9: return VK_F9;
-        case NK_KEYCODE_F10: return VK_F10;
-        case NK_KEYCODE_F11: return VK_F11;
-        case NK_KEYCODE_F12: return VK_F12;
-        case NK_KEYCODE_F13: return VK_F13;
-        case NK_KEYCODE_F14: return VK_F14;
-        case NK_KEYCODE_F15: return VK_F15;
-        case NK_KEYCODE_F16: return VK_F16;
-        case NK_KEYCODE_F17: return VK_F17;
-        case NK_KEYCODE_F18: return VK_F18;
-        case NK_KEYCODE_F19: return VK_F19;
-        case NK_KEYCODE_F20: return VK_F20;
-        case NK_KEYCODE_F21: return VK_F21;
-        case NK_KEYCODE_F22: return VK_F22;
-        case NK_KEYCODE_F23: return VK_F23;
-        case NK_KEYCODE_F24: return VK_F24;
-
-        default:
-        {
-            return 0; /* unknown keycode */
-        } break;
-    }
-}
\ No newline at end of file
+    /* when the message being handled was posted, wrapping every 49.7 days */
+    return nkEventClock_Convert(&eventClock, (double)(DWORD)GetMessageTime() / 1000.0);
+}
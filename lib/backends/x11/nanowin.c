@@ -0,0 +1,1727 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  nanowin.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - X11 backend
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanowin.h>
+#include <nanodraw.h>
+
+#include "nanowin_internal.h"
+
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <X11/cursorfont.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/Xrandr.h>
+#include <EGL/eglext.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+#include <pthread.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_EVENT_MASK   (ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | \
+                             PointerMotionMask | LeaveWindowMask | StructureNotifyMask | FocusChangeMask)
+
+#define NET_WM_STATE_ADD    (1L)
+
+/* preferred, a surface that keeps its contents across swaps can redraw just the damage */
+static const EGLint preservedConfigAttribs[] =
+{
+    EGL_SURFACE_TYPE,       EGL_WINDOW_BIT | EGL_SWAP_BEHAVIOR_PRESERVED_BIT,
+    EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+    EGL_RED_SIZE,           8,
+    EGL_GREEN_SIZE,         8,
+    EGL_BLUE_SIZE,          8,
+    EGL_ALPHA_SIZE,         8,
+    EGL_DEPTH_SIZE,         24,
+    EGL_STENCIL_SIZE,       8,
+    EGL_NONE
+};
+
+static const EGLint configAttribs[] =
+{
+    EGL_SURFACE_TYPE,       EGL_WINDOW_BIT,
+    EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+    EGL_RED_SIZE,           8,
+    EGL_GREEN_SIZE,         8,
+    EGL_BLUE_SIZE,          8,
+    EGL_ALPHA_SIZE,         8,
+    EGL_DEPTH_SIZE,         24,
+    EGL_STENCIL_SIZE,       8,
+    EGL_NONE
+};
+
+/* the software rasterizer's name from eglGetDisplayDriverName (EGL_MESA_query_driver) */
+#define SOFTWARE_DRIVER_NAME    "swrast"
+
+static const EGLint gl33Attribs[] =
+{
+    EGL_CONTEXT_MAJOR_VERSION,          3,
+    EGL_CONTEXT_MINOR_VERSION,          3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+};
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static bool initialized = false;
+static bool glLoaded = false;
+static bool quitRequested = false;
+
+static Display *display = NULL;
+static XIM inputMethod = NULL;
+
+static Atom wmDeleteWindow;
+static Atom wmProtocols;
+static Atom netWmName;
+static Atom netWmState;
+static Atom netWmStateMaximizedHorz;
+static Atom netWmStateMaximizedVert;
+static Atom netWmStateFullscreen;
+static Atom utf8String;
+
+static EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+static EGLConfig eglConfig = NULL;
+
+/* per thread, a window with a render thread has its context current there instead */
+static _Thread_local EGLContext currentContext = EGL_NO_CONTEXT;
+
+static Cursor cursorCache[NK_CURSOR_SIZENS_VALUE + 1] = {0};
+
+static nkWindow_t *windowList = NULL;
+
+/* with an input thread, it holds inputMutex while it looks up windows and queues their events */
+static bool inputThreaded = false;
+static pthread_t inputThread;
+static pthread_mutex_t inputMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* set by nkWindow_EnableRenderThreads, windows created afterwards render and swap on a thread each */
+static bool renderThreaded = false;
+
+/* set by nkWindow_EnableSharedContexts. Every context then shares objects with shareRoot, which is
+   never made current and only exists so the group outlives whichever window created it */
+static bool contextsShared = false;
+static EGLContext shareRoot = EGL_NO_CONTEXT;
+
+/* set when the server cannot take EGL window surfaces, or only through the software rasterizer, which
+   copies every frame whole. Windows then render into offscreen pbuffers and put just the damaged
+   rectangles to the server from CPU memory, through a shared memory segment if MIT-SHM is there */
+static bool softwarePresent = false;
+static bool shmAvailable = false;
+static XVisualInfo softwareVisual;
+
+/* set by the error handler installed while a segment is attached, a remote server cannot map it */
+static bool shmAttachFailed = false;
+
+/* server timestamps, in milliseconds, onto our clock. Only touched by whichever thread reads events */
+static nkEventClock_t eventClock = {0};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool InitX11(void);
+static bool InitEGL(void);
+static bool InitSoftwarePresent(void);
+static bool GetWindowVisual(XVisualInfo *visualInfo);
+
+static bool MakeCurrent(nkWindow_t *window);
+static void ReleaseCurrent(void);
+static void PaintWindow(nkWindow_t *window, const nkWindowDamage_t *damage);
+static void PaintSoftware(nkWindow_t *window, const nkWindowDamage_t *damage);
+static float GetModeRefreshRate(const XRRScreenResources *resources, RRMode mode);
+static void PutImageRect(nkWindow_t *window, int x, int y, int width, int height);
+static bool CreateImage(nkWindow_t *window, uint32_t width, uint32_t height);
+static void DestroyImage(nkWindow_t *window);
+static int ShmAttachErrorHandler(Display *errorDisplay, XErrorEvent *error);
+static void RemoveWindow(nkWindow_t *window);
+static void *InputThreadMain(void *argument);
+
+static void ProcessEvent(XEvent *xevent);
+static void ProcessButton(nkWindow_t *window, const XButtonEvent *xbutton, bool pressed);
+static void ProcessKey(nkWindow_t *window, XKeyEvent *xkey, bool pressed);
+static double GetEventTime(Time time);
+static void SetNetWmState(nkWindow_t *window, Atom first, Atom second);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkWindow_Create(nkWindow_t *window, const char *title, float width, float height)
+{
+    /* setup X11 the first time this is run */
+    if (!initialized)
+    {
+        /* Xlib must be made thread safe before anything else touches it */
+        if ((inputThreaded || renderThreaded) && !XInitThreads())
+        {
+            inputThreaded = false;
+            renderThreaded = false;
+        }
+
+        if (!InitX11())
+        {
+            fprintf(stderr, "Failed to open the X11 display!\n");
+            return false;
+        }
+
+        /* without EGL on the server's side, GL can still render offscreen */
+        if (!InitEGL())
+        {
+            softwarePresent = true;
+        }
+
+        if (softwarePresent && !InitSoftwarePresent())
+        {
+            fprintf(stderr, "Failed to initialize EGL");
+            return false;
+        }
+
+        nkWakeup_Init();
+
+        if (inputThreaded)
+        {
+            if (pthread_create(&inputThread, NULL, InputThreadMain, NULL) == 0)
+            {
+                pthread_detach(inputThread);
+            }
+            else
+            {
+                fprintf(stderr, "Failed to start the input thread, reading events inline.\n");
+                inputThreaded = false;
+            }
+        }
+
+        initialized = true;
+    }
+
+    XVisualInfo visualInfo;
+
+    if (!GetWindowVisual(&visualInfo))
+    {
+        fprintf(stderr, "Failed to find an X11 visual for the EGL config!\n");
+        return false;
+    }
+
+    Window root = RootWindow(display, visualInfo.screen);
+
+    XSetWindowAttributes attributes = {0};
+    attributes.colormap = XCreateColormap(display, root, visualInfo.visual, AllocNone);
+    attributes.event_mask = WINDOW_EVENT_MASK;
+    attributes.background_pixmap = None;
+    attributes.border_pixel = 0;
+
+    Window xwindow = XCreateWindow(
+        display,
+        root,
+        0, 0,
+        (unsigned int)width, (unsigned int)height,
+        0,
+        visualInfo.depth,
+        InputOutput,
+        visualInfo.visual,
+        CWColormap | CWEventMask | CWBackPixmap | CWBorderPixel,
+        &attributes
+    );
+
+    if (!xwindow)
+    {
+        fprintf(stderr, "Failed to create an X11 Window!\n");
+        return false;
+    }
+
+    XSetWMProtocols(display, xwindow, &wmDeleteWindow, 1);
+
+    window->windowHandle = xwindow;
+    window->inputContext = NULL;
+
+    if (inputMethod != NULL)
+    {
+        window->inputContext = XCreateIC(
+            inputMethod,
+            XNInputStyle, XIMPreeditNothing | XIMStatusNothing,
+            XNClientWindow, xwindow,
+            XNFocusWindow, xwindow,
+            NULL
+        );
+    }
+
+    window->image = NULL;
+
+    if (softwarePresent)
+    {
+        uint32_t targetWidth = (width >= 1.0f) ? (uint32_t)width : 1U;
+        uint32_t targetHeight = (height >= 1.0f) ? (uint32_t)height : 1U;
+
+        if (!nkOffscreen_CreateTarget(window, targetWidth, targetHeight) || !CreateImage(window, targetWidth, targetHeight))
+        {
+            fprintf(stderr, "Failed to create a software render target.");
+            return false;
+        }
+
+        window->partialRedraw = true; /* the pbuffer keeps its contents between frames */
+    }
+    else
+    {
+        window->eglSurface = eglCreateWindowSurface(eglDisplay, eglConfig, (EGLNativeWindowType)xwindow, NULL);
+
+        if (window->eglSurface == EGL_NO_SURFACE)
+        {
+            fprintf(stderr, "Failed to create an EGL window surface.");
+            return false;
+        }
+
+        /* otherwise the back buffer is undefined after a swap and every frame is drawn in full */
+        window->partialRedraw = eglSurfaceAttrib(eglDisplay, window->eglSurface, EGL_SWAP_BEHAVIOR, EGL_BUFFER_PRESERVED) == EGL_TRUE;
+
+        if (contextsShared && shareRoot == EGL_NO_CONTEXT)
+        {
+            shareRoot = eglCreateContext(eglDisplay, eglConfig, EGL_NO_CONTEXT, gl33Attribs);
+        }
+
+        window->eglContext = eglCreateContext(eglDisplay, eglConfig, shareRoot, gl33Attribs);
+
+        if (window->eglContext == EGL_NO_CONTEXT)
+        {
+            fprintf(stderr, "Failed to create OpenGL 3.3 context.");
+            return false;
+        }
+    }
+
+    if (!MakeCurrent(window))
+    {
+        fprintf(stderr, "Failed to activate OpenGL 3.3 rendering context.");
+        return false;
+    }
+
+    if (!glLoaded)
+    {
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+        {
+            fprintf(stderr, "Failed to initialize GLAD for OpenGL 3.3.");
+            return false;
+        }
+
+        glLoaded = true;
+    }
+
+    if (contextsShared)
+    {
+        nkSharedDraw_Acquire(&window->drawContext);
+    }
+    else
+    {
+        nkDraw_CreateContext(&window->drawContext);
+    }
+
+    /* populate the window contents */
+    window->next = NULL;
+    window->destroyed = false;
+    window->title = title;
+    window->width = width;
+    window->height = height;
+    window->visibility = NK_WINDOW_VISIBILITY_VISIBLE;
+    window->focus = NK_WINDOW_FOCUS_FOCUSED;
+    window->cursorType = NK_CURSOR_ARROW; /* default cursor type */
+    window->backgroundColor = NK_COLOR_WHITE; /* default background color */
+    window->redrawRequested = true;
+    window->layoutDirty = true;
+    window->layoutSize = (nkSize_t){ 0.0f, 0.0f };
+    window->layoutGeneration = 0;
+    window->hotViewLayout = 0;
+    window->hotBounds = (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+    window->damage.full = true;
+    window->damage.count = 0;
+    window->swapInterval = NK_SWAP_INTERVAL_ON; /* left to the driver until set */
+    window->swapIntervalChanged = false;
+    window->maxFrameRate = 0.0f;
+    window->nextPresent = 0;
+    window->pointerActionState = 0;
+    memset(window->keyState, 0, sizeof(window->keyState));
+    memset(&window->frameTiming, 0, sizeof(window->frameTiming));
+    window->metrics = NULL;
+    window->pendingInput.type = NK_EVENT_NONE;
+    window->inputRing = inputThreaded ? nkEventRing_Create() : NULL;
+    window->recording = NULL;
+    window->replay = NULL;
+    window->viewIndex = NULL;
+    window->renderThread = NULL;
+    window->postQueue = nkPostQueue_Create();
+
+    if (window->postQueue == NULL)
+    {
+        fprintf(stderr, "Failed to allocate the posted event queue!\n");
+        return false;
+    }
+
+    nkWindow_SetTitle(window, title);
+
+    if (renderThreaded)
+    {
+        /* the render thread takes the context over, so it cannot stay current here */
+        ReleaseCurrent();
+
+        window->renderThread = nkRenderThread_Create(window);
+
+        if (window->renderThread == NULL)
+        {
+            fprintf(stderr, "Failed to start a render thread, rendering inline.\n");
+        }
+    }
+
+    /* add this window to the linked list before mapping it, so the input thread sees its first events */
+    pthread_mutex_lock(&inputMutex);
+
+    if (windowList == NULL)
+    {
+        windowList = window;
+    }
+    else
+    {
+        nkWindow_t *current = windowList;
+        while (current->next != NULL)
+        {
+            current = current->next;
+        }
+        current->next = window;
+    }
+
+    pthread_mutex_unlock(&inputMutex);
+
+    XMapWindow(display, xwindow);
+    XFlush(display);
+
+    return true;
+}
+
+void nkWindow_SetTitle(nkWindow_t *window, const char *title)
+{
+    if (window == NULL || title == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* set both the legacy and the UTF-8 aware title */
+    XStoreName(display, window->windowHandle, title);
+
+    XChangeProperty(
+        display,
+        window->windowHandle,
+        netWmName,
+        utf8String,
+        8,
+        PropModeReplace,
+        (const unsigned char *)title,
+        (int)strlen(title)
+    );
+
+    window->title = title; /* update the title in the window struct */
+}
+
+void nkWindow_SetSize(nkWindow_t *window, float width, float height)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* set the window size, the resulting ConfigureNotify updates the struct and lays out */
+    XResizeWindow(display, window->windowHandle, (unsigned int)width, (unsigned int)height);
+    XFlush(display);
+}
+
+void nkWindow_SetVisibility(nkWindow_t *window, nkWindowVisibility_t visibility)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* set the window visibility */
+    switch (visibility)
+    {
+        case NK_WINDOW_VISIBILITY_VISIBLE:
+        {
+            XMapRaised(display, window->windowHandle);
+        } break;
+
+        case NK_WINDOW_VISIBILITY_HIDDEN:
+        {
+            XUnmapWindow(display, window->windowHandle);
+        } break;
+
+        case NK_WINDOW_VISIBILITY_MINIMIZED:
+        {
+            XIconifyWindow(display, window->windowHandle, DefaultScreen(display));
+        } break;
+
+        case NK_WINDOW_VISIBILITY_MAXIMIZED:
+        {
+            SetNetWmState(window, netWmStateMaximizedHorz, netWmStateMaximizedVert);
+        } break;
+
+        case NK_WINDOW_VISIBILITY_FULLSCREEN:
+        {
+            SetNetWmState(window, netWmStateFullscreen, 0);
+        } break;
+
+        default:
+        {
+            return; /* nothing to do */
+        }
+    }
+
+    XFlush(display);
+
+    window->visibility = visibility; /* update the visibility in the window struct */
+}
+
+void nkWindow_SetFocus(nkWindow_t *window, nkWindowFocus_t focus)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    /* set the window focus */
+    switch (focus)
+    {
+        case NK_WINDOW_FOCUS_FOCUSED:
+        {
+            XRaiseWindow(display, window->windowHandle);
+            XSetInputFocus(display, window->windowHandle, RevertToParent, CurrentTime);
+            XFlush(display);
+        } break;
+
+        default:
+        {
+            /* unfocus is left to the window manager */
+            return;
+        } break;
+    }
+
+    window->focus = focus; /* update the focus in the window struct */
+}
+
+void nkWindow_SetCursor(nkWindow_t *window, nkCursorType_t cursorType)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    unsigned int shape;
+
+    /* set the window cursor */
+    switch (cursorType)
+    {
+        case NK_CURSOR_ARROW:       shape = XC_left_ptr; break;
+        case NK_CURSOR_IBEAM:       shape = XC_xterm; break;
+        case NK_CURSOR_HAND:        shape = XC_hand2; break;
+        case NK_CURSOR_CROSSHAIR:   shape = XC_crosshair; break;
+        case NK_CURSOR_SIZEALL:     shape = XC_fleur; break;
+        case NK_CURSOR_SIZENWSE:    shape = XC_bottom_right_corner; break;
+        case NK_CURSOR_SIZENESW:    shape = XC_bottom_left_corner; break;
+        case NK_CURSOR_SIZEWE:      shape = XC_sb_h_double_arrow; break;
+        case NK_CURSOR_SIZENS:      shape = XC_sb_v_double_arrow; break;
+
+        default:
+        {
+            return; /* invalid cursor */
+        } break;
+    }
+
+    if (cursorCache[cursorType] == 0)
+    {
+        cursorCache[cursorType] = XCreateFontCursor(display, shape);
+    }
+
+    XDefineCursor(display, window->windowHandle, cursorCache[cursorType]);
+
+    window->cursorType = cursorType;
+}
+
+void nkWindow_Destroy(nkWindow_t *window)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->destroyed = true;
+
+    const nkWindowDelegate_t *delegate = nkWindow_GetDelegate(window);
+
+    /* call the close callback if it exists */
+    if (delegate->closeCallback)
+    {
+        delegate->closeCallback(window);
+    }
+
+    /* the context has to be released by the thread it is current on before it can go */
+    nkRenderThread_Destroy(window->renderThread);
+    window->renderThread = NULL;
+
+    if (softwarePresent)
+    {
+        DestroyImage(window);
+        nkOffscreen_DestroyTarget(window);
+
+        if (contextsShared && nkSharedDraw_Release())
+        {
+            nkOffscreen_DestroyShareGroup();
+        }
+    }
+    else
+    {
+        if (currentContext == window->eglContext)
+        {
+            ReleaseCurrent();
+        }
+
+        eglDestroySurface(eglDisplay, window->eglSurface);
+        eglDestroyContext(eglDisplay, window->eglContext);
+
+        if (contextsShared && nkSharedDraw_Release() && shareRoot != EGL_NO_CONTEXT)
+        {
+            eglDestroyContext(eglDisplay, shareRoot);
+            shareRoot = EGL_NO_CONTEXT;
+        }
+    }
+
+    /* the input thread may be translating an event for this window */
+    pthread_mutex_lock(&inputMutex);
+
+    RemoveWindow(window);
+
+    if (window->inputContext != NULL)
+    {
+        XDestroyIC(window->inputContext);
+    }
+
+    nkEventRing_Destroy(window->inputRing);
+    window->inputRing = NULL;
+
+    nkPostQueue_Destroy(window->postQueue);
+    window->postQueue = NULL;
+
+    nkWindow_StopRecording(window);
+    nkWindow_StopReplay(window);
+
+    nkViewIndex_Destroy(window->viewIndex);
+    window->viewIndex = NULL;
+
+    nkWindow_DestroyMetrics(window);
+
+    pthread_mutex_unlock(&inputMutex);
+
+    /* destroy the window */
+    XDestroyWindow(display, window->windowHandle);
+    XFlush(display);
+}
+
+void nkWindow_ScheduleFrame(nkWindow_t *window)
+{
+    (void)window;
+
+    /* painted once the event queue has been drained */
+}
+
+bool nkWindow_IsPointerActionDown(nkWindow_t *window, nkPointerAction_t action)
+{
+    return nkWindow_TestPointerActionState(window, action);
+}
+
+bool nkWindow_IsKeyDown(nkWindow_t *window, uint32_t keycode)
+{
+    return nkWindow_TestKeyState(window, keycode);
+}
+
+void nkWindow_RedrawViews(nkWindow_t *window)
+{
+    if (window == NULL || window->rootView == NULL)
+    {
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Window contains no views");
+        return;
+    }
+
+    MakeCurrent(window);
+
+    nkView_RenderTree(window->rootView, &window->drawContext);
+}
+
+bool nkWindow_PollEvents(void)
+{
+    static bool firstRun = true;
+
+    if (firstRun)
+    {
+        firstRun = false;
+
+        for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+        {
+            nkWindow_LayoutViews(current);
+            nkWindow_RequestRedraw(current);
+        }
+    }
+
+    if (!inputThreaded)
+    {
+        XEvent xevent;
+
+        /* XPending flushes and reads what is on the socket, but never blocks */
+        while (!quitRequested && XPending(display) > 0)
+        {
+            XNextEvent(display, &xevent);
+            ProcessEvent(&xevent);
+        }
+    }
+
+    /* timers due by now, before the frame so what they change is drawn in it */
+    nkWindow_ServiceTimers();
+
+    /* dispatch what the input thread queued, and the motion held back for merging */
+    nkWindow_t *current = windowList;
+    while (!quitRequested && current != NULL)
+    {
+        nkWindow_t *next = current->next;
+
+        nkWindow_DrainInput(current);
+
+        current = next;
+    }
+
+    if (quitRequested)
+    {
+        return false;
+    }
+
+    /* paint once per pump, however many events invalidated each window */
+    for (current = windowList; current != NULL; current = current->next)
+    {
+        nkWindowDamage_t damage;
+
+        if (!nkWindow_BeginFrame(current, &damage))
+        {
+            continue;
+        }
+
+        if (current->renderThread == NULL)
+        {
+            PaintWindow(current, &damage);
+        }
+        else if (!nkRenderThread_Submit(current->renderThread, &damage))
+        {
+            nkWindow_RequestRedraw(current);
+        }
+    }
+
+    return true;
+}
+
+void nkWindow_WakeEventLoop(nkWindow_t *window)
+{
+    (void)window; /* one loop wakes for every window */
+
+    nkWakeup_Signal();
+}
+
+bool nkWindow_WaitEvents(double timeoutSeconds)
+{
+    /* wake for the next timer too */
+    timeoutSeconds = nkWindow_GetTimerTimeout(timeoutSeconds);
+
+    for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+    {
+        if (current->redrawRequested)
+        {
+            return nkWindow_PollEvents(); /* work is already waiting */
+        }
+    }
+
+    if (inputThreaded)
+    {
+        /* the input thread owns the connection and signals when it queued something */
+        nkWakeup_Wait(-1, timeoutSeconds);
+    }
+    else if (XEventsQueued(display, QueuedAlready) == 0)
+    {
+        /* requests still buffered could be what the server would answer */
+        XFlush(display);
+
+        nkWakeup_Wait(ConnectionNumber(display), timeoutSeconds);
+    }
+
+    return nkWindow_PollEvents();
+}
+
+float nkWindow_GetRefreshRate(nkWindow_t *window)
+{
+    int eventBase = 0;
+    int errorBase = 0;
+
+    if (window == NULL || !XRRQueryExtension(display, &eventBase, &errorBase))
+    {
+        return 0.0f;
+    }
+
+    /* the display is the CRTC the window's center is on, or the first one lit if it is on none */
+    Window root = DefaultRootWindow(display);
+    Window child;
+    int centerX = 0;
+    int centerY = 0;
+
+    XTranslateCoordinates(display, window->windowHandle, root, (int)(window->width * 0.5f), (int)(window->height * 0.5f), &centerX, &centerY, &child);
+
+    XRRScreenResources *resources = XRRGetScreenResourcesCurrent(display, root);
+
+    if (resources == NULL)
+    {
+        return 0.0f;
+    }
+
+    float refreshRate = 0.0f;
+    float fallbackRate = 0.0f;
+
+    for (int i = 0; i < resources->ncrtc && refreshRate == 0.0f; i++)
+    {
+        XRRCrtcInfo *crtc = XRRGetCrtcInfo(display, resources, resources->crtcs[i]);
+
+        if (crtc == NULL)
+        {
+            continue;
+        }
+
+        if (crtc->mode != None)
+        {
+            float rate = GetModeRefreshRate(resources, crtc->mode);
+
+            bool contains =
+                centerX >= crtc->x && centerX < crtc->x + (int)crtc->width &&
+                centerY >= crtc->y && centerY < crtc->y + (int)crtc->height;
+
+            if (contains)
+            {
+                refreshRate = rate;
+            }
+            else if (fallbackRate == 0.0f)
+            {
+                fallbackRate = rate;
+            }
+        }
+
+        XRRFreeCrtcInfo(crtc);
+    }
+
+    XRRFreeScreenResources(resources);
+
+    return (refreshRate > 0.0f) ? refreshRate : fallbackRate;
+}
+
+bool nkWindow_EnableInputThread(void)
+{
+    if (initialized)
+    {
+        return false; /* XInitThreads must come before the display is opened */
+    }
+
+    inputThreaded = true;
+
+    return true;
+}
+
+bool nkWindow_EnableSharedContexts(void)
+{
+    if (initialized)
+    {
+        return false; /* windows already exist */
+    }
+
+    contextsShared = true;
+
+    /* in case the server turns out to need software present */
+    nkOffscreen_ShareContexts();
+
+    return true;
+}
+
+bool nkWindow_EnableRenderThreads(void)
+{
+    if (initialized)
+    {
+        return false; /* XInitThreads must come before the display is opened */
+    }
+
+    renderThreaded = true;
+
+    return true;
+}
+
+bool nkWindow_BindRenderThread(nkWindow_t *target)
+{
+    return MakeCurrent(target);
+}
+
+void nkWindow_PresentFrame(nkWindow_t *target, nkWindowDamage_t *damage)
+{
+    PaintWindow(target, damage);
+}
+
+void nkWindow_UnbindRenderThread(nkWindow_t *window, nkWindow_t *target)
+{
+    ReleaseCurrent();
+
+    window->drawContext = target->drawContext;
+
+    /* software present recreates these whenever the window is resized */
+    window->eglSurface = target->eglSurface;
+    window->image = target->image;
+    window->shmSegment = target->shmSegment;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool InitX11(void)
+{
+    /* needed for Xutf8LookupString to produce UTF-8 */
+    setlocale(LC_CTYPE, "");
+    XSetLocaleModifiers("");
+
+    display = XOpenDisplay(NULL);
+
+    if (display == NULL)
+    {
+        return false;
+    }
+
+    /* report key releases only when the key is actually released, as Win32 does */
+    XkbSetDetectableAutoRepeat(display, True, NULL);
+
+    inputMethod = XOpenIM(display, NULL, NULL, NULL);
+
+    wmDeleteWindow = XInternAtom(display, "WM_DELETE_WINDOW", False);
+    wmProtocols = XInternAtom(display, "WM_PROTOCOLS", False);
+    netWmName = XInternAtom(display, "_NET_WM_NAME", False);
+    netWmState = XInternAtom(display, "_NET_WM_STATE", False);
+    netWmStateMaximizedHorz = XInternAtom(display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
+    netWmStateMaximizedVert = XInternAtom(display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
+    netWmStateFullscreen = XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", False);
+    utf8String = XInternAtom(display, "UTF8_STRING", False);
+
+    return true;
+}
+
+static bool InitEGL(void)
+{
+    eglDisplay = eglGetDisplay((EGLNativeDisplayType)display);
+
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, NULL, NULL))
+    {
+        fprintf(stderr, "Failed to initialize the EGL display.");
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        fprintf(stderr, "Failed to bind the OpenGL API.");
+        return false;
+    }
+
+    EGLint numConfigs = 0;
+    eglChooseConfig(eglDisplay, preservedConfigAttribs, &eglConfig, 1, &numConfigs);
+
+    if (numConfigs == 0)
+    {
+        eglChooseConfig(eglDisplay, configAttribs, &eglConfig, 1, &numConfigs);
+    }
+
+    if (numConfigs == 0)
+    {
+        fprintf(stderr, "Failed to find a suitable EGL config.");
+        return false;
+    }
+
+    /* on the software rasterizer it is cheaper to render offscreen and put only what changed */
+    PFNEGLGETDISPLAYDRIVERNAMEPROC eglGetDisplayDriverName = (PFNEGLGETDISPLAYDRIVERNAMEPROC)eglGetProcAddress("eglGetDisplayDriverName");
+
+    if (eglGetDisplayDriverName != NULL)
+    {
+        const char *driverName = eglGetDisplayDriverName(eglDisplay);
+
+        if (driverName != NULL && strstr(driverName, SOFTWARE_DRIVER_NAME) != NULL)
+        {
+            softwarePresent = true;
+        }
+    }
+
+    return true;
+}
+
+static bool InitSoftwarePresent(void)
+{
+    if (eglDisplay != EGL_NO_DISPLAY)
+    {
+        eglTerminate(eglDisplay); /* only offscreen.c renders from here on */
+        eglDisplay = EGL_NO_DISPLAY;
+    }
+
+    if (!nkOffscreen_Init())
+    {
+        return false;
+    }
+
+    /* GL_BGRA readback is the pixel layout of 24 bit TrueColor, padded to 32 bits per pixel */
+    if (!XMatchVisualInfo(display, DefaultScreen(display), 24, TrueColor, &softwareVisual))
+    {
+        return false;
+    }
+
+    shmAvailable = XShmQueryExtension(display) == True;
+
+    return true;
+}
+
+static bool GetWindowVisual(XVisualInfo *visualInfo)
+{
+    if (softwarePresent)
+    {
+        *visualInfo = softwareVisual;
+        return true;
+    }
+
+    /* the visual EGL picked for us */
+    EGLint visualId = 0;
+    eglGetConfigAttrib(eglDisplay, eglConfig, EGL_NATIVE_VISUAL_ID, &visualId);
+
+    XVisualInfo visualTemplate = { .visualid = (VisualID)visualId };
+    int visualCount = 0;
+    XVisualInfo *visuals = XGetVisualInfo(display, VisualIDMask, &visualTemplate, &visualCount);
+
+    if (visuals == NULL)
+    {
+        return false;
+    }
+
+    *visualInfo = visuals[0];
+    XFree(visuals);
+
+    return true;
+}
+
+static bool MakeCurrent(nkWindow_t *window)
+{
+    if (softwarePresent)
+    {
+        return nkOffscreen_MakeCurrent(window);
+    }
+
+    if (currentContext == window->eglContext)
+    {
+        return true;
+    }
+
+    if (!eglMakeCurrent(eglDisplay, window->eglSurface, window->eglSurface, window->eglContext))
+    {
+        return false;
+    }
+
+    currentContext = window->eglContext;
+
+    return true;
+}
+
+static void ReleaseCurrent(void)
+{
+    if (softwarePresent)
+    {
+        nkOffscreen_ReleaseCurrent();
+        return;
+    }
+
+    eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    currentContext = EGL_NO_CONTEXT;
+}
+
+static void PaintWindow(nkWindow_t *window, const nkWindowDamage_t *damage)
+{
+    if (softwarePresent)
+    {
+        PaintSoftware(window, damage);
+        return;
+    }
+
+    MakeCurrent(window);
+
+    nkWindow_RenderFrame(window, damage);
+
+    if (window->swapIntervalChanged)
+    {
+        /* EGL has no adaptive interval, negative values are clamped to 0 rather than tearing late frames */
+        eglSwapInterval(eglDisplay, (window->swapInterval == NK_SWAP_INTERVAL_OFF) ? 0 : 1);
+        window->swapIntervalChanged = false;
+    }
+
+    nkWindow_PaceFrame(window);
+
+    uint64_t presentStart = nkWindow_GetTicks();
+
+    eglSwapBuffers(eglDisplay, window->eglSurface);
+
+    nkWindow_FinishFrame(window, presentStart);
+}
+
+static void PaintSoftware(nkWindow_t *window, const nkWindowDamage_t *damage)
+{
+    nkWindowDamage_t frameDamage = *damage;
+
+    uint32_t width = (window->width >= 1.0f) ? (uint32_t)window->width : 1U;
+    uint32_t height = (window->height >= 1.0f) ? (uint32_t)window->height : 1U;
+
+    if (window->image == NULL || (uint32_t)window->image->width != width || (uint32_t)window->image->height != height)
+    {
+        DestroyImage(window);
+
+        if (!nkOffscreen_ResizeTarget(window, width, height) || !CreateImage(window, width, height))
+        {
+            fprintf(stderr, "Failed to resize the software render target!\n");
+            return;
+        }
+
+        frameDamage.full = true; /* the new pbuffer holds nothing yet */
+    }
+
+    MakeCurrent(window);
+
+    nkWindow_RenderFrame(window, &frameDamage);
+
+    /* puts are not synchronised to the display, so the cap is all that paces frames */
+    nkWindow_PaceFrame(window);
+
+    uint64_t presentStart = nkWindow_GetTicks();
+
+    if (frameDamage.full || frameDamage.count == 0)
+    {
+        PutImageRect(window, 0, 0, (int)width, (int)height);
+    }
+    else
+    {
+        /* only what changed crosses to the server, rounded out to whole pixels like the scissor */
+        for (uint32_t i = 0; i < frameDamage.count; i++)
+        {
+            nkRect_t rect = frameDamage.rects[i];
+
+            int left = (int)rect.x;
+            int top = (int)rect.y;
+            int right = (int)(rect.x + rect.width + 1.0f);
+            int bottom = (int)(rect.y + rect.height + 1.0f);
+
+            left = (left < 0) ? 0 : left;
+            top = (top < 0) ? 0 : top;
+            right = (right > (int)width) ? (int)width : right;
+            bottom = (bottom > (int)height) ? (int)height : bottom;
+
+            if (right > left && bottom > top)
+            {
+                PutImageRect(window, left, top, right - left, bottom - top);
+            }
+        }
+    }
+
+    if (window->shmSegment.shmaddr != NULL)
+    {
+        /* the server reads the segment while it handles the puts, so the next frame waits for that */
+        XSync(display, False);
+    }
+    else
+    {
+        XFlush(display);
+    }
+
+    nkWindow_FinishFrame(window, presentStart);
+}
+
+static void PutImageRect(nkWindow_t *window, int x, int y, int width, int height)
+{
+    XImage *image = window->image;
+    uint8_t *pixels = (uint8_t *)image->data + (size_t)y * (size_t)image->bytes_per_line + (size_t)x * 4U;
+
+    /* the image's 32 bit pixels are 0x00RRGGBB, which is BGRA in memory on little endian hosts */
+    nkOffscreen_ReadPixels(window, (uint32_t)x, (uint32_t)y, (uint32_t)width, (uint32_t)height, GL_BGRA, pixels, (size_t)image->bytes_per_line);
+
+    GC gc = DefaultGC(display, softwareVisual.screen);
+
+    if (window->shmSegment.shmaddr != NULL)
+    {
+        XShmPutImage(display, window->windowHandle, gc, image, x, y, x, y, (unsigned int)width, (unsigned int)height, False);
+    }
+    else
+    {
+        XPutImage(display, window->windowHandle, gc, image, x, y, x, y, (unsigned int)width, (unsigned int)height);
+    }
+}
+
+static float GetModeRefreshRate(const XRRScreenResources *resources, RRMode mode)
+{
+    for (int i = 0; i < resources->nmode; i++)
+    {
+        const XRRModeInfo *info = &resources->modes[i];
+
+        if (info->id != mode)
+        {
+            continue;
+        }
+
+        double lines = (double)info->vTotal;
+
+        if (info->modeFlags & RR_DoubleScan)
+        {
+            lines *= 2.0; /* every line is sent twice */
+        }
+
+        if (info->modeFlags & RR_Interlace)
+        {
+            lines /= 2.0; /* a field is half the lines */
+        }
+
+        if (info->hTotal == 0 || lines <= 0.0)
+        {
+            return 0.0f;
+        }
+
+        return (float)((double)info->dotClock / ((double)info->hTotal * lines));
+    }
+
+    return 0.0f;
+}
+
+static bool CreateImage(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    memset(&window->shmSegment, 0, sizeof(window->shmSegment));
+    window->shmSegment.shmid = -1;
+
+    if (shmAvailable)
+    {
+        window->image = XShmCreateImage(display, softwareVisual.visual, (unsigned int)softwareVisual.depth, ZPixmap, NULL, &window->shmSegment, width, height);
+    }
+
+    if (window->image != NULL)
+    {
+        window->shmSegment.shmid = shmget(IPC_PRIVATE, (size_t)window->image->bytes_per_line * height, IPC_CREAT | 0600);
+
+        if (window->shmSegment.shmid >= 0)
+        {
+            window->shmSegment.shmaddr = shmat(window->shmSegment.shmid, NULL, 0);
+
+            if (window->shmSegment.shmaddr == (char *)-1)
+            {
+                window->shmSegment.shmaddr = NULL;
+            }
+        }
+
+        if (window->shmSegment.shmaddr != NULL)
+        {
+            window->image->data = window->shmSegment.shmaddr;
+            window->shmSegment.readOnly = False;
+
+            /* the attach fails asynchronously on a server that cannot see our memory, so catch it here */
+            XErrorHandler previousHandler = XSetErrorHandler(ShmAttachErrorHandler);
+
+            shmAttachFailed = false;
+            XShmAttach(display, &window->shmSegment);
+            XSync(display, False);
+
+            XSetErrorHandler(previousHandler);
+
+            if (shmAttachFailed)
+            {
+                shmdt(window->shmSegment.shmaddr);
+                window->shmSegment.shmaddr = NULL;
+            }
+        }
+
+        if (window->shmSegment.shmid >= 0)
+        {
+            /* removed once both sides have detached */
+            shmctl(window->shmSegment.shmid, IPC_RMID, NULL);
+        }
+
+        if (window->shmSegment.shmaddr != NULL)
+        {
+            return true;
+        }
+
+        /* whatever went wrong will go wrong for the next window too */
+        shmAvailable = false;
+
+        window->image->data = NULL;
+        XDestroyImage(window->image);
+        window->image = NULL;
+    }
+
+    /* without MIT-SHM every put copies the pixels through the socket */
+    window->image = XCreateImage(display, softwareVisual.visual, (unsigned int)softwareVisual.depth, ZPixmap, 0, NULL, width, height, 32, 0);
+
+    if (window->image == NULL)
+    {
+        return false;
+    }
+
+    window->image->data = malloc((size_t)window->image->bytes_per_line * height);
+
+    if (window->image->data == NULL)
+    {
+        XDestroyImage(window->image);
+        window->image = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+static void DestroyImage(nkWindow_t *window)
+{
+    if (window->image == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (window->shmSegment.shmaddr != NULL)
+    {
+        XShmDetach(display, &window->shmSegment);
+        XSync(display, False);
+
+        shmdt(window->shmSegment.shmaddr);
+        window->shmSegment.shmaddr = NULL;
+
+        window->image->data = NULL; /* not from malloc, XDestroyImage would free it */
+    }
+
+    XDestroyImage(window->image);
+    window->image = NULL;
+}
+
+static int ShmAttachErrorHandler(Display *errorDisplay, XErrorEvent *error)
+{
+    (void)errorDisplay;
+    (void)error;
+
+    shmAttachFailed = true;
+    return 0;
+}
+
+static void RemoveWindow(nkWindow_t *window)
+{
+    if (windowList == window && window->next == NULL)
+    {
+        quitRequested = true; /* quit if this is the last */
+    }
+
+    if (windowList == window)
+    {
+        windowList = window->next; /* remove from head */
+    }
+    else
+    {
+        nkWindow_t *prev = windowList;
+        while (prev != NULL && prev->next != window)
+        {
+            prev = prev->next;
+        }
+
+        if (prev != NULL)
+        {
+            prev->next = window->next; /* remove from middle or end */
+        }
+    }
+
+    window->next = NULL;
+}
+
+static void *InputThreadMain(void *argument)
+{
+    (void)argument;
+
+    XEvent xevent;
+
+    for (;;)
+    {
+        /* blocks without holding the display lock, so the UI thread can keep issuing requests */
+        XNextEvent(display, &xevent);
+
+        pthread_mutex_lock(&inputMutex);
+        ProcessEvent(&xevent);
+        pthread_mutex_unlock(&inputMutex);
+
+        nkWakeup_Signal(); /* the UI thread may be waiting in nkWindow_WaitEvents */
+    }
+
+    return NULL;
+}
+
+static void ProcessEvent(XEvent *xevent)
+{
+    /* let the input method see key events first */
+    if (XFilterEvent(xevent, None))
+    {
+        return;
+    }
+
+    /* first, try and find this window */
+    nkWindow_t *window = NULL;
+    for (nkWindow_t *current = windowList; current != NULL; current = current->next)
+    {
+        if (current->windowHandle == xevent->xany.window)
+        {
+            window = current;
+            break;
+        }
+    }
+
+    if (window == NULL)
+    {
+        return;
+    }
+
+    /* now, process the event if the window was found */
+    switch (xevent->type)
+    {
+        case MotionNotify:
+        {
+            /* only the newest position of a run of motion matters, drop the rest unseen.
+               The first of the run is when the pointer started moving, so it keeps its time */
+            Time time = xevent->xmotion.time;
+            XEvent next;
+            while (XEventsQueued(display, QueuedAfterReading) > 0)
+            {
+                XPeekEvent(display, &next);
+
+                if (next.type != MotionNotify || next.xmotion.window != xevent->xmotion.window)
+                {
+                    break;
+                }
+
+                XNextEvent(display, xevent);
+            }
+
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_MOVE,
+                .timestamp = GetEventTime(time),
+                .pointer = { (float)xevent->xmotion.x, (float)xevent->xmotion.y }
+            };
+
+            nkWindow_PostInput(window, &event);
+
+        } break;
+
+        case LeaveNotify:
+        {
+            if (xevent->xcrossing.mode != NotifyNormal)
+            {
+                break; /* grabs while dragging are not a real leave */
+            }
+
+            nkEvent_t event = {
+                .type = NK_EVENT_POINTER_LEAVE,
+                .timestamp = GetEventTime(xevent->xcrossing.time)
+            };
+
+            nkWindow_PostInput(window, &event);
+
+        } break;
+
+        case ButtonPress:
+        {
+            ProcessButton(window, &xevent->xbutton, true);
+        } break;
+
+        case ButtonRelease:
+        {
+            ProcessButton(window, &xevent->xbutton, false);
+        } break;
+
+        case KeyPress:
+        {
+            ProcessKey(window, &xevent->xkey, true);
+        } break;
+
+        case KeyRelease:
+        {
+            ProcessKey(window, &xevent->xkey, false);
+        } break;
+
+        case ConfigureNotify:
+        {
+            /* an interactive resize floods the queue, only the final geometry is laid out */
+            while (XCheckTypedWindowEvent(display, window->windowHandle, ConfigureNotify, xevent))
+            {
+                /* keep the newest */
+            }
+
+            /* a move arrives with the same size, which the dispatcher ignores */
+            nkEvent_t event = {
+                .type = NK_EVENT_RESIZE,
+                .resize = { (float)xevent->xconfigure.width, (float)xevent->xconfigure.height }
+            };
+
+            nkWindow_PostInput(window, &event);
+
+        } break;
+
+        case Expose:
+        {
+            if (xevent->xexpose.count == 0)
+            {
+                nkEvent_t event = { .type = NK_EVENT_EXPOSE };
+
+                nkWindow_PostInput(window, &event);
+            }
+        } break;
+
+        case FocusIn:
+        case FocusOut:
+        {
+            if (xevent->xfocus.mode == NotifyGrab || xevent->xfocus.mode == NotifyUngrab)
+            {
+                break; /* keyboard grabs do not change window focus */
+            }
+
+            if (window->inputContext != NULL)
+            {
+                if (xevent->type == FocusIn)
+                {
+                    XSetICFocus(window->inputContext);
+                }
+                else
+                {
+                    XUnsetICFocus(window->inputContext);
+                }
+            }
+
+            nkEvent_t event = {
+                .type = NK_EVENT_FOCUS_CHANGE,
+                .focus = (xevent->type == FocusIn) ? NK_WINDOW_FOCUS_FOCUSED : NK_WINDOW_FOCUS_UNFOCUSED
+            };
+
+            nkWindow_PostInput(window, &event);
+
+        } break;
+
+        case MapNotify:
+        {
+            nkEvent_t event = {
+                .type = NK_EVENT_VISIBILITY_CHANGE,
+                .visibility = NK_WINDOW_VISIBILITY_VISIBLE
+            };
+
+            nkWindow_PostInput(window, &event);
+
+        } break;
+
+        case UnmapNotify:
+        {
+            if (window->visibility == NK_WINDOW_VISIBILITY_HIDDEN)
+            {
+                break; /* hidden on purpose by nkWindow_SetVisibility */
+            }
+
+            nkEvent_t event = {
+                .type = NK_EVENT_VISIBILITY_CHANGE,
+                .visibility = NK_WINDOW_VISIBILITY_MINIMIZED
+            };
+
+            nkWindow_PostInput(window, &event);
+
+        } break;
+
+        case ClientMessage:
+        {
+            if (xevent->xclient.message_type == wmProtocols && (Atom)xevent->xclient.data.l[0] == wmDeleteWindow)
+            {
+                nkEvent_t event = { .type = NK_EVENT_CLOSE };
+
+                nkWindow_PostInput(window, &event);
+            }
+        } break;
+
+        default:
+        {
+            /* do nothing */
+        } break;
+    }
+}
+
+static void ProcessButton(nkWindow_t *window, const XButtonEvent *xbutton, bool pressed)
+{
+    nkPointerAction_t action;
+
+    switch (xbutton->button)
+    {
+        case Button1: action = NK_POINTER_ACTION_PRIMARY; break;
+        case Button2: action = NK_POINTER_ACTION_TERTIARY; break;
+        case Button3: action = NK_POINTER_ACTION_SECONDARY; break;
+        case 8: action = NK_POINTER_ACTION_EXTENDED_1; break;
+        case 9: action = NK_POINTER_ACTION_EXTENDED_2; break;
+
+        case Button4:
+        case Button5:
+        case 6:
+        case 7:
+        {
+            /* the wheel arrives as button presses, one notch each, with a matching release */
+            if (!pressed)
+            {
+                return;
+            }
+
+            nkEvent_t event = {
+                .type = NK_EVENT_SCROLL,
+                .timestamp = GetEventTime(xbutton->time),
+                .scroll = {
+                    (xbutton->button == 6) ? 1.0f : (xbutton->button == 7) ? -1.0f : 0.0f,
+                    (xbutton->button == Button4) ? 1.0f : (xbutton->button == Button5) ? -1.0f : 0.0f
+                }
+            };
+
+            nkWindow_PostInput(window, &event);
+
+            return;
+        }
+
+        default:
+        {
+            return; /* unknown button */
+        }
+    }
+
+    nkEvent_t event = {
+        .type = pressed ? NK_EVENT_POINTER_ACTION_BEGIN : NK_EVENT_POINTER_ACTION_END,
+        .timestamp = GetEventTime(xbutton->time),
+        .pointerAction = { action, (float)xbutton->x, (float)xbutton->y }
+    };
+
+    nkWindow_PostInput(window, &event);
+}
+
+static void ProcessKey(nkWindow_t *window, XKeyEvent *xkey, bool pressed)
+{
+    KeySym keysym = XLookupKeysym(xkey, 0);
+    double timestamp = GetEventTime(xkey->time);
+
+    nkEvent_t event = {
+        .type = pressed ? NK_EVENT_KEY_DOWN : NK_EVENT_KEY_UP,
+        .timestamp = timestamp,
+        .key = { nkKeycode_FromKeysym((uint32_t)keysym) }
+    };
+
+    nkWindow_PostInput(window, &event);
+
+    if (!pressed)
+    {
+        return;
+    }
+
+    /* text input, decoded from UTF-8 into codepoints */
+    char buffer[64];
+    int length = 0;
+    Status status = 0;
+
+    if (window->inputContext != NULL)
+    {
+        length = Xutf8LookupString(window->inputContext, xkey, buffer, sizeof(buffer), NULL, &status);
+
+        if (status != XLookupChars && status != XLookupBoth)
+        {
+            length = 0;
+        }
+    }
+    else
+    {
+        length = XLookupString(xkey, buffer, sizeof(buffer), NULL, NULL);
+    }
+
+    const uint8_t *cursor = (const uint8_t *)buffer;
+    const uint8_t *end = cursor + length;
+
+    while (cursor < end)
+    {
+        uint32_t codepoint;
+        int extra;
+
+        if (*cursor < 0x80)         { codepoint = *cursor; extra = 0; }
+        else if (*cursor < 0xE0)    { codepoint = *cursor & 0x1F; extra = 1; }
+        else if (*cursor < 0xF0)    { codepoint = *cursor & 0x0F; extra = 2; }
+        else                        { codepoint = *cursor & 0x07; extra = 3; }
+
+        cursor++;
+
+        while (extra-- > 0 && cursor < end)
+        {
+            codepoint = (codepoint << 6) | (*cursor++ & 0x3F);
+        }
+
+        /* filter out control keys such as delete and backspace */
+        if (codepoint > 0x1F && codepoint != 0x7F)
+        {
+            nkEvent_t codepointEvent = {
+                .type = NK_EVENT_CODEPOINT_INPUT,
+                .timestamp = timestamp,
+                .codepoint = { codepoint }
+            };
+
+            nkWindow_PostInput(window, &codepointEvent);
+        }
+    }
+}
+
+static double GetEventTime(Time time)
+{
+    return nkEventClock_Convert(&eventClock, (double)time / 1000.0);
+}
+
+static void SetNetWmState(nkWindow_t *window, Atom first, Atom second)
+{
+    XEvent xevent = {0};
+
+    xevent.xclient.type = ClientMessage;
+    xevent.xclient.window = window->windowHandle;
+    xevent.xclient.message_type = netWmState;
+    xevent.xclient.format = 32;
+    xevent.xclient.data.l[0] = NET_WM_STATE_ADD;
+    xevent.xclient.data.l[1] = (long)first;
+    xevent.xclient.data.l[2] = (long)second;
+    xevent.xclient.data.l[3] = 1; /* normal application */
+
+    XSendEvent(
+        display,
+        DefaultRootWindow(display),
+        False,
+        SubstructureRedirectMask | SubstructureNotifyMask,
+        &xevent
+    );
+}
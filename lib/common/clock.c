@@ -0,0 +1,112 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  clock.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - monotonic clock, in seconds
+**                 and in nanosecond ticks, and platform event times
+**                 converted onto it
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    #include <time.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define EVENT_CLOCK_RESYNC      (10.0)      /* seconds off the estimate taken as the platform clock jumping or wrapping */
+#define EVENT_CLOCK_CREEP       (0.001)     /* share of a later delay the estimate moves by, to follow drift between the clocks */
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+double nkWindow_GetTime(void)
+{
+    #if _WIN32
+        static LARGE_INTEGER frequency = {0};
+
+        if (frequency.QuadPart == 0)
+        {
+            QueryPerformanceFrequency(&frequency);
+        }
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        return (double)counter.QuadPart / (double)frequency.QuadPart;
+    #elif __EMSCRIPTEN__
+        return emscripten_get_now() / 1000.0;
+    #else
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+    #endif
+}
+
+uint64_t nkWindow_GetTicks(void)
+{
+    #if _WIN32
+        static LARGE_INTEGER frequency = {0};
+
+        if (frequency.QuadPart == 0)
+        {
+            QueryPerformanceFrequency(&frequency);
+        }
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        /* split so the multiply cannot overflow */
+        uint64_t seconds = (uint64_t)counter.QuadPart / (uint64_t)frequency.QuadPart;
+        uint64_t remainder = (uint64_t)counter.QuadPart % (uint64_t)frequency.QuadPart;
+
+        return seconds * 1000000000ULL + remainder * 1000000000ULL / (uint64_t)frequency.QuadPart;
+    #elif __EMSCRIPTEN__
+        return (uint64_t)(emscripten_get_now() * 1e6);
+    #else
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    #endif
+}
+
+double nkEventClock_Convert(nkEventClock_t *clock, double platformSeconds)
+{
+    double now = nkWindow_GetTime();
+    double offset = now - platformSeconds;
+
+    /* the event that took least time to reach us gives the best offset between the clocks,
+       every other event was delayed on its way by the difference */
+    if (!clock->valid || offset < clock->offset || offset - clock->offset > EVENT_CLOCK_RESYNC)
+    {
+        clock->offset = offset;
+        clock->valid = true;
+    }
+    else
+    {
+        clock->offset += (offset - clock->offset) * EVENT_CLOCK_CREEP;
+    }
+
+    double timestamp = platformSeconds + clock->offset;
+
+    return (timestamp < now) ? timestamp : now;
+}
@@ -0,0 +1,816 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  dispatch.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - backend neutral event dispatch
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define KEY_STATE_BITS      (sizeof(((nkWindow_t *)0)->keyState) * 8U)
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const nkWindowDelegate_t emptyDelegate = {0};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void CoalesceEvent(nkWindow_t *window, const nkEvent_t *event);
+static void FlushPendingInput(nkWindow_t *window);
+static bool DrainPostedEvents(nkWindow_t *window);
+static void HitTestPointer(nkWindow_t *window, float x, float y);
+static bool ChildContains(const nkView_t *view, float x, float y);
+static nkRect_t GetHotBounds(const nkView_t *rootView, const nkView_t *view);
+static bool RectsOverlap(nkRect_t a, nkRect_t b);
+static nkRect_t RectIntersect(nkRect_t a, nkRect_t b);
+static bool RectContains(nkRect_t rect, float x, float y);
+static void DamagePointerViews(nkWindow_t *window, nkView_t *prevHot, nkView_t *prevActive, bool pressed);
+static void DamageView(nkWindow_t *window, nkView_t *view);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkWindow_SetDelegate(nkWindow_t *window, const nkWindowDelegate_t *delegate, void *userData)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->delegate = delegate;
+    window->userData = userData;
+}
+
+const nkWindowDelegate_t *nkWindow_GetDelegate(nkWindow_t *window)
+{
+    return (window->delegate != NULL) ? window->delegate : &emptyDelegate;
+}
+
+void nkWindow_DispatchEvent(nkWindow_t *window, const nkEvent_t *event)
+{
+    if (window == NULL || event == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (window->recording != NULL)
+    {
+        nkRecording_Write(window->recording, event);
+    }
+
+    if (event->type >= NK_EVENT_POINTER_MOVE && event->type <= NK_EVENT_CODEPOINT_INPUT)
+    {
+        /* user input, its latency runs until the frame answering it is presented */
+        nkWindow_AddFrameInput(window, event);
+    }
+
+    const nkWindowDelegate_t *delegate = nkWindow_GetDelegate(window);
+
+    uint64_t start = nkWindow_GetTicks();
+    uint64_t layoutBefore = window->frameTiming.phases[NK_FRAME_PHASE_LAYOUT];
+
+    if (event->type >= NK_EVENT_POINTER_MOVE && event->type <= NK_EVENT_SCROLL)
+    {
+        /* hit-testing needs the tree laid out for the current size */
+        nkWindow_UpdateLayout(window);
+    }
+
+    switch (event->type)
+    {
+        case NK_EVENT_POINTER_MOVE:
+        {
+            float x = event->pointer.x;
+            float y = event->pointer.y;
+
+            nkView_t *prevHot = window->hotView;
+
+            if (delegate->pointerMoveCallback)
+            {
+                delegate->pointerMoveCallback(window, x, y);
+            }
+
+            if (window->destroyed)
+            {
+                return; /* destroyed by the callback */
+            }
+
+            HitTestPointer(window, x, y);
+
+            if (delegate->pointerMoveCallback)
+            {
+                nkWindow_RequestRedraw(window); /* the application may draw anything in response */
+            }
+            else
+            {
+                DamagePointerViews(window, prevHot, window->activeView, false);
+            }
+
+        } break;
+
+        case NK_EVENT_POINTER_LEAVE:
+        {
+            nkView_t *prevHot = window->hotView;
+            nkView_t *prevActive = window->activeView;
+
+            /* set origin to -1, -1 */
+            nkView_ProcessPointerAction(
+                window->rootView,
+                window->activeAction,
+                POINTER_EVENT_CANCEL,
+                -1.0f,
+                -1.0f,
+                window->hotView,
+                &window->activeView,
+                &window->activeAction
+            );
+
+            nkView_ProcessPointerMovement(window->rootView, -1.0f, -1.0f, &window->hotView, window->activeView, window->activeAction);
+
+            DamagePointerViews(window, prevHot, prevActive, true);
+
+        } break;
+
+        case NK_EVENT_POINTER_ACTION_BEGIN:
+        {
+            nkView_t *prevActive = window->activeView;
+
+            if (delegate->pointerActionBeginCallback)
+            {
+                delegate->pointerActionBeginCallback(window, event->pointerAction.action, event->pointerAction.x, event->pointerAction.y);
+            }
+
+            if (window->destroyed)
+            {
+                return; /* destroyed by the callback */
+            }
+
+            nkView_ProcessPointerAction(
+                window->rootView,
+                event->pointerAction.action,
+                POINTER_EVENT_BEGIN,
+                event->pointerAction.x,
+                event->pointerAction.y,
+                window->hotView,
+                &window->activeView,
+                &window->activeAction
+            );
+
+            if (delegate->pointerActionBeginCallback)
+            {
+                nkWindow_RequestRedraw(window); /* the application may draw anything in response */
+            }
+            else
+            {
+                DamagePointerViews(window, window->hotView, prevActive, true);
+            }
+
+        } break;
+
+        case NK_EVENT_POINTER_ACTION_END:
+        {
+            nkView_t *prevActive = window->activeView;
+
+            if (delegate->pointerActionEndCallback)
+            {
+                delegate->pointerActionEndCallback(window, event->pointerAction.action, event->pointerAction.x, event->pointerAction.y);
+            }
+
+            if (window->destroyed)
+            {
+                return; /* destroyed by the callback */
+            }
+
+            nkView_ProcessPointerAction(
+                window->rootView,
+                event->pointerAction.action,
+                POINTER_EVENT_END,
+                event->pointerAction.x,
+                event->pointerAction.y,
+                window->hotView,
+                &window->activeView,
+                &window->activeAction
+            );
+
+            if (delegate->pointerActionEndCallback)
+            {
+                nkWindow_RequestRedraw(window); /* the application may draw anything in response */
+            }
+            else
+            {
+                DamagePointerViews(window, window->hotView, prevActive, true);
+            }
+
+        } break;
+
+        case NK_EVENT_SCROLL:
+        {
+            if (delegate->scrollCallback)
+            {
+                delegate->scrollCallback(window, event->scroll.deltaX, event->scroll.deltaY);
+            }
+
+            if (window->destroyed)
+            {
+                return; /* destroyed by the callback */
+            }
+
+            nkView_ProcessScroll(
+                window->rootView,
+                event->scroll.deltaY,
+                window->hotView
+            );
+
+            nkWindow_RequestRedraw(window);
+
+        } break;
+
+        case NK_EVENT_KEY_DOWN:
+        {
+            if (delegate->keyDownCallback)
+            {
+                delegate->keyDownCallback(window, event->key.keycode);
+            }
+        } break;
+
+        case NK_EVENT_KEY_UP:
+        {
+            if (delegate->keyUpCallback)
+            {
+                delegate->keyUpCallback(window, event->key.keycode);
+            }
+        } break;
+
+        case NK_EVENT_CODEPOINT_INPUT:
+        {
+            if (delegate->codepointInputCallback)
+            {
+                delegate->codepointInputCallback(window, event->codepoint.codepoint);
+            }
+        } break;
+
+        case NK_EVENT_RESIZE:
+        {
+            if (event->resize.width == window->width && event->resize.height == window->height)
+            {
+                NK_STATS_ADD(window, layoutsSkipped, 1U);
+                break; /* moved, or reported twice */
+            }
+
+            if (window->width != window->layoutSize.width || window->height != window->layoutSize.height)
+            {
+                /* still not laid out for the last resize, one layout will cover both */
+                NK_STATS_ADD(window, layoutsSkipped, 1U);
+            }
+
+            window->width = event->resize.width;
+            window->height = event->resize.height;
+
+            if (delegate->resizeCallback)
+            {
+                delegate->resizeCallback(window, window->width, window->height);
+            }
+
+            if (window->destroyed)
+            {
+                return; /* destroyed by the callback */
+            }
+
+            /* laid out when next hit-tested or drawn, so a resize drag costs one layout per frame */
+            nkWindow_RequestRedraw(window);
+
+        } break;
+
+        case NK_EVENT_FOCUS_CHANGE:
+        {
+            window->focus = event->focus;
+
+            if (delegate->focusChangeCallback)
+            {
+                delegate->focusChangeCallback(window, event->focus);
+            }
+        } break;
+
+        case NK_EVENT_VISIBILITY_CHANGE:
+        {
+            nkWindowVisibility_t prevVisibility = window->visibility;
+
+            window->visibility = event->visibility;
+
+            if (delegate->visibilityChangeCallback && window->visibility != prevVisibility)
+            {
+                delegate->visibilityChangeCallback(window, window->visibility);
+            }
+        } break;
+
+        case NK_EVENT_EXPOSE:
+        {
+            nkWindow_RequestRedraw(window);
+        } break;
+
+        case NK_EVENT_CLOSE:
+        {
+            nkWindow_Destroy(window);
+        } break;
+
+        case NK_EVENT_USER:
+        {
+            if (delegate->userEventCallback)
+            {
+                delegate->userEventCallback(window, event->user.code, event->user.data);
+            }
+        } break;
+
+        default:
+        {
+            /* do nothing */
+        } break;
+    }
+
+    if (window->destroyed)
+    {
+        return; /* the window is gone, closed or destroyed by a callback */
+    }
+
+    /* a layout run for hit-testing is timed as layout, not dispatch */
+    uint64_t layoutAfter = window->frameTiming.phases[NK_FRAME_PHASE_LAYOUT];
+
+    nkWindow_AddFrameTime(window, NK_FRAME_PHASE_DISPATCH, start + ((layoutAfter > layoutBefore) ? layoutAfter - layoutBefore : 0));
+}
+
+void nkWindow_PostInput(nkWindow_t *window, nkEvent_t *event)
+{
+    if (window == NULL || event == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (event->timestamp == 0.0)
+    {
+        event->timestamp = nkWindow_GetTime();
+    }
+
+    if (window->inputRing == NULL)
+    {
+        CoalesceEvent(window, event);
+        return;
+    }
+
+    /* a full ring means the UI thread has stalled for NK_EVENT_RING_CAPACITY events, drop rather than block input */
+    nkEventRing_Push(window->inputRing, event);
+}
+
+void nkWindow_ApplyEvent(nkWindow_t *window, nkEvent_t *event)
+{
+    if (window == NULL || event == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (event->timestamp == 0.0)
+    {
+        event->timestamp = nkWindow_GetTime();
+    }
+
+    CoalesceEvent(window, event);
+}
+
+bool nkWindow_PostEvent(nkWindow_t *window, uint32_t code, void *data)
+{
+    if (window == NULL || window->postQueue == NULL)
+    {
+        return false; /* nowhere to post to */
+    }
+
+    nkEvent_t event = {
+        .type = NK_EVENT_USER,
+        .timestamp = nkWindow_GetTime(),
+        .user = { code, data }
+    };
+
+    if (!nkPostQueue_Push(window->postQueue, &event))
+    {
+        return false;
+    }
+
+    nkWindow_WakeEventLoop(window);
+
+    return true;
+}
+
+bool nkWindow_DrainInput(nkWindow_t *window)
+{
+    if (window == NULL)
+    {
+        return true; /* nothing to do */
+    }
+
+    /* posted events first, a worker's update is older than the input read this pump */
+    if (!DrainPostedEvents(window))
+    {
+        return false;
+    }
+
+    if (window->inputRing == NULL)
+    {
+        FlushPendingInput(window);
+        return !window->destroyed;
+    }
+
+    /* only what is queued now, so a busy producer cannot hold the frame back */
+    uint32_t count = nkEventRing_Count(window->inputRing);
+
+    nkWindowMetrics_t *metrics = nkWindow_GetMetrics(window);
+
+    if (metrics != NULL)
+    {
+        metrics->stats.queueDepth = count;
+
+        if (count > metrics->stats.queueDepthMax)
+        {
+            metrics->stats.queueDepthMax = count;
+        }
+    }
+
+    double now = nkWindow_GetTime();
+
+    nkEvent_t event;
+
+    while (count-- > 0 && nkEventRing_Pop(window->inputRing, &event))
+    {
+        /* the block is freed if a callback destroys the window, which ends the loop before it is used again */
+        if (metrics != NULL)
+        {
+            metrics->stats.eventsQueued++;
+
+            if (now - event.timestamp > metrics->stats.queueLatencyMax)
+            {
+                metrics->stats.queueLatencyMax = now - event.timestamp;
+            }
+        }
+
+        CoalesceEvent(window, &event);
+
+        if (window->destroyed)
+        {
+            return false; /* closed, or destroyed by a callback, the window and its ring are gone */
+        }
+    }
+
+    FlushPendingInput(window);
+
+    return !window->destroyed;
+}
+
+void nkWindow_GetStats(nkWindow_t *window, nkWindowStats_t *stats)
+{
+    if (window == NULL || stats == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (window->renderThread != NULL)
+    {
+        nkRenderThread_Finish(window->renderThread); /* the frame in flight is counted there */
+    }
+
+    *stats = (window->metrics != NULL) ? window->metrics->stats : (nkWindowStats_t){ 0 };
+
+    if (window->inputRing != NULL)
+    {
+        stats->eventsDropped = nkEventRing_Dropped(window->inputRing);
+    }
+}
+
+void nkWindow_TrackInputState(nkWindow_t *window, const nkEvent_t *event)
+{
+    switch (event->type)
+    {
+        case NK_EVENT_POINTER_ACTION_BEGIN:
+        {
+            if ((uint32_t)event->pointerAction.action < 32U)
+            {
+                window->pointerActionState |= (1U << (uint32_t)event->pointerAction.action);
+            }
+        } break;
+
+        case NK_EVENT_POINTER_ACTION_END:
+        {
+            if ((uint32_t)event->pointerAction.action < 32U)
+            {
+                window->pointerActionState &= ~(1U << (uint32_t)event->pointerAction.action);
+            }
+        } break;
+
+        case NK_EVENT_KEY_DOWN:
+        {
+            if (event->key.keycode < KEY_STATE_BITS)
+            {
+                window->keyState[event->key.keycode / 32U] |= (1U << (event->key.keycode % 32U));
+            }
+        } break;
+
+        case NK_EVENT_KEY_UP:
+        {
+            if (event->key.keycode < KEY_STATE_BITS)
+            {
+                window->keyState[event->key.keycode / 32U] &= ~(1U << (event->key.keycode % 32U));
+            }
+        } break;
+
+        case NK_EVENT_FOCUS_CHANGE:
+        {
+            /* whatever is released while the window is not focused is never delivered to it */
+            if (event->focus == NK_WINDOW_FOCUS_UNFOCUSED)
+            {
+                for (uint32_t i = 0; i < KEY_STATE_BITS / 32U; i++)
+                {
+                    window->keyState[i] = 0;
+                }
+
+                window->pointerActionState = 0;
+            }
+        } break;
+
+        default:
+        {
+            /* do nothing */
+        } break;
+    }
+}
+
+bool nkWindow_TestKeyState(nkWindow_t *window, uint32_t keycode)
+{
+    if (window == NULL || keycode >= KEY_STATE_BITS)
+    {
+        return false; /* invalid keycode */
+    }
+
+    return (window->keyState[keycode / 32U] & (1U << (keycode % 32U))) != 0;
+}
+
+bool nkWindow_TestPointerActionState(nkWindow_t *window, nkPointerAction_t action)
+{
+    if (window == NULL || (uint32_t)action >= 32U)
+    {
+        return false; /* invalid action */
+    }
+
+    return (window->pointerActionState & (1U << (uint32_t)action)) != 0;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void CoalesceEvent(nkWindow_t *window, const nkEvent_t *event)
+{
+    nkEvent_t *pending = &window->pendingInput;
+
+    if (event->type != NK_EVENT_POINTER_MOVE && event->type != NK_EVENT_SCROLL)
+    {
+        /* transitions are never merged, and whatever was held back goes first to keep the order */
+        FlushPendingInput(window);
+
+        nkWindow_TrackInputState(window, event);
+        nkWindow_DispatchEvent(window, event);
+        return;
+    }
+
+    if (pending->type == event->type)
+    {
+        /* the oldest timestamp is kept, it is the input the next frame answers first */
+        if (event->type == NK_EVENT_POINTER_MOVE)
+        {
+            pending->pointer = event->pointer;
+            NK_STATS_ADD(window, pointerMovesMerged, 1U);
+        }
+        else
+        {
+            pending->scroll.deltaX += event->scroll.deltaX;
+            pending->scroll.deltaY += event->scroll.deltaY;
+            NK_STATS_ADD(window, scrollsMerged, 1U);
+        }
+
+        return;
+    }
+
+    FlushPendingInput(window);
+
+    *pending = *event;
+
+    /* make sure there is a next pump or frame to deliver it in, what it damages is known once dispatched */
+    nkWindow_RequestFrame(window);
+}
+
+static void FlushPendingInput(nkWindow_t *window)
+{
+    if (window->pendingInput.type == NK_EVENT_NONE)
+    {
+        return; /* nothing held back */
+    }
+
+    nkEvent_t event = window->pendingInput;
+
+    window->pendingInput.type = NK_EVENT_NONE;
+
+    nkWindow_DispatchEvent(window, &event);
+}
+
+static bool DrainPostedEvents(nkWindow_t *window)
+{
+    if (window->postQueue == NULL)
+    {
+        return true; /* nothing can be posted */
+    }
+
+    /* only as many as one lap of the queue, so workers posting nonstop cannot hold the frame back.
+       The queue is freed if a callback destroys the window, so it is never read again after that */
+    nkPostQueue_t *queue = window->postQueue;
+    nkEvent_t event;
+
+    for (uint32_t i = 0; i < NK_POST_QUEUE_CAPACITY && nkPostQueue_Pop(queue, &event); i++)
+    {
+        NK_STATS_ADD(window, eventsPosted, 1U);
+
+        CoalesceEvent(window, &event);
+
+        if (window->destroyed)
+        {
+            return false; /* destroyed by the callback */
+        }
+    }
+
+    return true;
+}
+
+static void HitTestPointer(nkWindow_t *window, float x, float y)
+{
+    if (window->activeView != NULL)
+    {
+        /* the drag goes to the view that captured it wherever the pointer is, so there is nothing to search for */
+        NK_STATS_ADD(window, pointerCaptureHits, 1U);
+        nkView_ProcessPointerMovement(window->activeView, x, y, &window->hotView, window->activeView, window->activeAction);
+
+        /* the hot view may have changed without a search, so the next one starts over */
+        window->hotBounds = (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+        return;
+    }
+
+    nkView_t *view;
+    bool searched = false;
+
+    if (window->hotView != NULL && window->hotViewLayout == window->layoutGeneration &&
+        RectContains(window->hotBounds, x, y) && !ChildContains(window->hotView, x, y))
+    {
+        /* nothing moved since the hot view was found, and the pointer is still where a search would end at it */
+        view = window->hotView;
+        NK_STATS_ADD(window, pointerHotHits, 1U);
+    }
+    else
+    {
+        view = nkViewIndex_Find(window->viewIndex, window->rootView, x, y);
+        NK_STATS_ADD(window, pointerHitTests, 1U);
+        searched = true;
+
+        if (view == NULL)
+        {
+            /* no index for this tree, walk all of it */
+            view = window->rootView;
+        }
+    }
+
+    /* none of a found view's children contain the point, so the walk from it tests them once and stops at it */
+    nkView_ProcessPointerMovement(view, x, y, &window->hotView, window->activeView, window->activeAction);
+
+    if (searched)
+    {
+        window->hotViewLayout = window->layoutGeneration;
+        window->hotBounds = GetHotBounds(window->rootView, window->hotView);
+    }
+}
+
+static bool ChildContains(const nkView_t *view, float x, float y)
+{
+    for (const nkView_t *child = view->child; child != NULL; child = child->sibling)
+    {
+        if (RectContains(child->frame, x, y))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static nkRect_t GetHotBounds(const nkView_t *rootView, const nkView_t *view)
+{
+    /* where a walk from the root still ends at the view, found once per layout: inside the view and each of
+       its ancestors, and clear of every earlier sibling along the way, which the walk would enter first.
+       An earlier sibling overlapping it leaves the bounds empty. Only read through the links, the
+       application's tree is never written to */
+    nkRect_t empty = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    if (view == NULL)
+    {
+        return empty;
+    }
+
+    nkRect_t bounds = view->frame;
+
+    for (const nkView_t *node = view; node != rootView; node = node->parent)
+    {
+        if (node->parent == NULL)
+        {
+            return empty; /* no longer in the window's tree */
+        }
+
+        for (const nkView_t *sibling = node->parent->child; sibling != node; sibling = sibling->sibling)
+        {
+            if (sibling == NULL || RectsOverlap(sibling->frame, bounds))
+            {
+                return empty;
+            }
+        }
+
+        bounds = RectIntersect(bounds, node->parent->frame);
+    }
+
+    return bounds;
+}
+
+static bool RectsOverlap(nkRect_t a, nkRect_t b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static nkRect_t RectIntersect(nkRect_t a, nkRect_t b)
+{
+    float left = (a.x > b.x) ? a.x : b.x;
+    float top = (a.y > b.y) ? a.y : b.y;
+    float right = (a.x + a.width < b.x + b.width) ? a.x + a.width : b.x + b.width;
+    float bottom = (a.y + a.height < b.y + b.height) ? a.y + a.height : b.y + b.height;
+
+    if (right <= left || bottom <= top)
+    {
+        return (nkRect_t){ 0.0f, 0.0f, 0.0f, 0.0f };
+    }
+
+    return (nkRect_t){ left, top, right - left, bottom - top };
+}
+
+static bool RectContains(nkRect_t rect, float x, float y)
+{
+    return x >= rect.x && x < rect.x + rect.width && y >= rect.y && y < rect.y + rect.height;
+}
+
+static void DamagePointerViews(nkWindow_t *window, nkView_t *prevHot, nkView_t *prevActive, bool pressed)
+{
+    /* hover and press state only show on the views that gained or lost it, and on the one being dragged */
+    if (window->hotView != prevHot || pressed)
+    {
+        DamageView(window, prevHot);
+        DamageView(window, window->hotView);
+    }
+
+    if (window->activeView != prevActive)
+    {
+        DamageView(window, prevActive);
+    }
+
+    DamageView(window, window->activeView);
+}
+
+static void DamageView(nkWindow_t *window, nkView_t *view)
+{
+    if (view == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkWindow_RequestRedrawRect(window, view->frame);
+}
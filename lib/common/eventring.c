@@ -0,0 +1,138 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  eventring.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - lock-free single producer,
+**                 single consumer event ring
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define RING_MASK           (NK_EVENT_RING_CAPACITY - 1U)
+#define CACHE_LINE_SIZE     (64U)
+
+#if (NK_EVENT_RING_CAPACITY & RING_MASK) != 0
+    #error "NK_EVENT_RING_CAPACITY must be a power of two"
+#endif
+
+/* the producer publishes a slot with a release store, the consumer observes it with an acquire load */
+#if defined(_MSC_VER)
+    #define LOAD_ACQUIRE(ptr)           ((uint32_t)_InterlockedOr((volatile long *)(ptr), 0))
+    #define STORE_RELEASE(ptr, value)   ((void)_InterlockedExchange((volatile long *)(ptr), (long)(value)))
+#elif defined(__GNUC__) || defined(__clang__)
+    #define LOAD_ACQUIRE(ptr)           __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define STORE_RELEASE(ptr, value)   __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+    #error "No atomics for this compiler, eventring.c needs MSVC, GCC or Clang"
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* head and tail live on separate cache lines so the two threads do not share one */
+struct nkEventRing_t
+{
+    /* written by the producer */
+    uint32_t head;
+    uint32_t cachedTail;        /* last tail the producer saw, refreshed only when the ring looks full */
+    uint32_t dropped;
+    uint8_t producerPadding[CACHE_LINE_SIZE - 3U * sizeof(uint32_t)];
+
+    /* written by the consumer */
+    uint32_t tail;
+    uint32_t cachedHead;        /* last head the consumer saw, refreshed only when the ring looks empty */
+    uint8_t consumerPadding[CACHE_LINE_SIZE - 2U * sizeof(uint32_t)];
+
+    nkEvent_t events[NK_EVENT_RING_CAPACITY];
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkEventRing_t *nkEventRing_Create(void)
+{
+    return calloc(1, sizeof(nkEventRing_t));
+}
+
+void nkEventRing_Destroy(nkEventRing_t *ring)
+{
+    free(ring);
+}
+
+bool nkEventRing_Push(nkEventRing_t *ring, const nkEvent_t *event)
+{
+    uint32_t head = ring->head;
+
+    if (head - ring->cachedTail == NK_EVENT_RING_CAPACITY)
+    {
+        ring->cachedTail = LOAD_ACQUIRE(&ring->tail);
+
+        if (head - ring->cachedTail == NK_EVENT_RING_CAPACITY)
+        {
+            STORE_RELEASE(&ring->dropped, ring->dropped + 1U);
+            return false; /* full */
+        }
+    }
+
+    ring->events[head & RING_MASK] = *event;
+
+    STORE_RELEASE(&ring->head, head + 1U);
+
+    return true;
+}
+
+bool nkEventRing_Pop(nkEventRing_t *ring, nkEvent_t *event)
+{
+    uint32_t tail = ring->tail;
+
+    if (tail == ring->cachedHead)
+    {
+        ring->cachedHead = LOAD_ACQUIRE(&ring->head);
+
+        if (tail == ring->cachedHead)
+        {
+            return false; /* empty */
+        }
+    }
+
+    *event = ring->events[tail & RING_MASK];
+
+    STORE_RELEASE(&ring->tail, tail + 1U);
+
+    return true;
+}
+
+uint32_t nkEventRing_Count(nkEventRing_t *ring)
+{
+    /* exact for the consumer, a lower bound for anyone else */
+    return LOAD_ACQUIRE(&ring->head) - ring->tail;
+}
+
+uint32_t nkEventRing_Dropped(nkEventRing_t *ring)
+{
+    return LOAD_ACQUIRE(&ring->dropped);
+}
@@ -0,0 +1,304 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  frame.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - backend neutral frame
+**                 scheduling and rendering
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <nanodraw.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define MIN(a, b)           ((a) < (b) ? (a) : (b))
+#define MAX(a, b)           ((a) > (b) ? (a) : (b))
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void MarkDirty(nkWindow_t *window);
+static void DiscardInput(nkWindow_t *window);
+static void AddDamage(nkWindow_t *window, nkRect_t rect);
+static bool RectsTouch(nkRect_t a, nkRect_t b);
+static nkRect_t RectUnion(nkRect_t a, nkRect_t b);
+static void RenderPass(nkWindow_t *window, nkRect_t rect, bool clipped);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkWindow_RequestRedraw(nkWindow_t *window)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    NK_STATS_ADD(window, redrawRequests, 1U);
+
+    window->damage.full = true;
+    window->damage.count = 0;
+
+    MarkDirty(window);
+}
+
+void nkWindow_RequestRedrawRect(nkWindow_t *window, nkRect_t rect)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    NK_STATS_ADD(window, redrawRequests, 1U);
+
+    AddDamage(window, rect);
+
+    MarkDirty(window);
+}
+
+void nkWindow_RequestFrame(nkWindow_t *window)
+{
+    if (window->redrawRequested)
+    {
+        return; /* already scheduled */
+    }
+
+    window->redrawRequested = true;
+
+    nkWindow_ScheduleFrame(window);
+}
+
+bool nkWindow_BeginFrame(nkWindow_t *window, nkWindowDamage_t *damage)
+{
+    damage->full = false;
+    damage->count = 0;
+
+    if (!window->redrawRequested)
+    {
+        DiscardInput(window);
+        return false; /* nothing changed since the last frame */
+    }
+
+    /* cleared before rendering, so a request made while drawing schedules the next frame */
+    window->redrawRequested = false;
+
+    *damage = window->damage;
+
+    window->damage.full = false;
+    window->damage.count = 0;
+
+    /* a frame scheduled only to deliver input that damaged nothing */
+    if (!damage->full && damage->count == 0)
+    {
+        DiscardInput(window);
+        return false;
+    }
+
+    nkWindow_UpdateLayout(window);
+
+    return true;
+}
+
+void nkWindow_RenderFrame(nkWindow_t *window, const nkWindowDamage_t *damage)
+{
+    uint64_t trace = NK_TRACE_BEGIN(NK_TRACE_LEVEL_INFO);
+
+    glViewport(0, 0, (int)window->width, (int)window->height);
+
+    if (damage->full || !window->partialRedraw)
+    {
+        /* the backend cannot keep the last frame, or everything changed */
+        nkRect_t bounds = { 0.0f, 0.0f, window->width, window->height };
+
+        RenderPass(window, bounds, false);
+    }
+    else
+    {
+        /* one walk of the tree per frame, scissored to the box around the damage. NanoView draws whole
+           subtrees, so a pass per rect would walk the same views once per rect */
+        nkRect_t bounds = damage->rects[0];
+
+        for (uint32_t i = 1; i < damage->count; i++)
+        {
+            bounds = RectUnion(bounds, damage->rects[i]);
+        }
+
+        glEnable(GL_SCISSOR_TEST);
+
+        RenderPass(window, bounds, true);
+
+        glDisable(GL_SCISSOR_TEST);
+
+        NK_STATS_ADD(window, partialFrames, 1U);
+    }
+
+    NK_STATS_ADD(window, framesRendered, 1U);
+
+    NK_TRACE_END(NK_TRACE_LEVEL_INFO, "frame", "RenderFrame", trace);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void MarkDirty(nkWindow_t *window)
+{
+    if (window->redrawRequested)
+    {
+        /* the frame already scheduled will show this change too */
+        NK_STATS_ADD(window, redrawsAbsorbed, 1U);
+        return;
+    }
+
+    nkWindow_RequestFrame(window);
+}
+
+static void DiscardInput(nkWindow_t *window)
+{
+    /* input that changed nothing on screen has no frame to wait for */
+    window->frameTiming.inputOldest = 0.0;
+    window->frameTiming.inputNewest = 0.0;
+}
+
+static void AddDamage(nkWindow_t *window, nkRect_t rect)
+{
+    nkWindowDamage_t *damage = &window->damage;
+
+    if (damage->full)
+    {
+        return; /* already covered */
+    }
+
+    /* clip to the window, outside of it there is nothing to draw */
+    float left = MAX(rect.x, 0.0f);
+    float top = MAX(rect.y, 0.0f);
+    float right = MIN(rect.x + rect.width, window->width);
+    float bottom = MIN(rect.y + rect.height, window->height);
+
+    if (right <= left || bottom <= top)
+    {
+        return; /* empty, or off the window */
+    }
+
+    rect = (nkRect_t){ left, top, right - left, bottom - top };
+
+    /* absorb every rect this one touches, the grown rect may then touch others */
+    uint32_t i = 0;
+
+    while (i < damage->count)
+    {
+        if (RectsTouch(rect, damage->rects[i]))
+        {
+            rect = RectUnion(rect, damage->rects[i]);
+            damage->rects[i] = damage->rects[--damage->count];
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    if (damage->count == NK_DAMAGE_RECT_COUNT)
+    {
+        /* too fragmented to be worth a pass each, draw their bounding box once instead */
+        for (i = 0; i < damage->count; i++)
+        {
+            rect = RectUnion(rect, damage->rects[i]);
+        }
+
+        damage->count = 0;
+    }
+
+    if (rect.width >= window->width && rect.height >= window->height)
+    {
+        damage->full = true;
+        damage->count = 0;
+        return;
+    }
+
+    damage->rects[damage->count++] = rect;
+}
+
+static bool RectsTouch(nkRect_t a, nkRect_t b)
+{
+    return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+           a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+static nkRect_t RectUnion(nkRect_t a, nkRect_t b)
+{
+    float left = MIN(a.x, b.x);
+    float top = MIN(a.y, b.y);
+    float right = MAX(a.x + a.width, b.x + b.width);
+    float bottom = MAX(a.y + a.height, b.y + b.height);
+
+    return (nkRect_t){ left, top, right - left, bottom - top };
+}
+
+static void RenderPass(nkWindow_t *window, nkRect_t rect, bool clipped)
+{
+    if (clipped)
+    {
+        /* whole pixels covering the rect, which is clipped to the window so never negative.
+           GL counts rows from the bottom */
+        int left = (int)rect.x;
+        int top = (int)rect.y;
+        int right = (int)(rect.x + rect.width);
+        int bottom = (int)(rect.y + rect.height);
+
+        right += ((float)right < rect.x + rect.width) ? 1 : 0;
+        bottom += ((float)bottom < rect.y + rect.height) ? 1 : 0;
+
+        glScissor(left, (int)window->height - bottom, right - left, bottom - top);
+    }
+
+    glClearColor(
+        window->backgroundColor.r,
+        window->backgroundColor.g,
+        window->backgroundColor.b,
+        window->backgroundColor.a
+    );
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    nkDraw_Begin(&window->drawContext, window->width, window->height);
+
+    uint64_t start = nkWindow_GetTicks();
+
+    nkWindow_RedrawViews(window); // Redraw the views in the window
+
+    nkWindow_AddFrameTime(window, NK_FRAME_PHASE_VIEWS, start);
+
+    const nkWindowDelegate_t *delegate = nkWindow_GetDelegate(window);
+
+    if (delegate->drawCallback)
+    {
+        start = nkWindow_GetTicks();
+
+        delegate->drawCallback(window);
+
+        nkWindow_AddFrameTime(window, NK_FRAME_PHASE_DRAW_CALLBACK, start);
+    }
+
+    nkDraw_End(&window->drawContext);
+
+    NK_STATS_ADD(window, pixelsRendered, (uint64_t)(rect.width * rect.height));
+}
@@ -0,0 +1,229 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  framestats.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - per frame timing by phase,
+**                 and input to present latency
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkFramePercentiles_t GetPercentiles(uint64_t *samples, uint32_t count);
+static int CompareSamples(const void *a, const void *b);
+static void AddLatency(nkLatencyHistogram_t *histogram, double latency);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkWindowMetrics_t *nkWindow_GetMetrics(nkWindow_t *window)
+{
+    if (window->metrics == NULL)
+    {
+        /* about 10 KB a window, most of it frame history, which windows that are never drawn do without */
+        window->metrics = calloc(1, sizeof(nkWindowMetrics_t));
+    }
+
+    return window->metrics;
+}
+
+void nkWindow_DestroyMetrics(nkWindow_t *window)
+{
+    free(window->metrics);
+    window->metrics = NULL;
+}
+
+void nkWindow_AddFrameTime(nkWindow_t *window, nkFramePhase_t phase, uint64_t start)
+{
+    uint64_t now = nkWindow_GetTicks();
+
+    if (window->frameTiming.start == 0)
+    {
+        window->frameTiming.start = start; /* the first work towards this frame */
+    }
+
+    window->frameTiming.phases[phase] += (now > start) ? now - start : 0;
+}
+
+void nkWindow_FinishFrame(nkWindow_t *window, uint64_t presentStart)
+{
+    nkWindow_AddFrameTime(window, NK_FRAME_PHASE_PRESENT, presentStart);
+
+    nkFrameTiming_t *timing = &window->frameTiming;
+    nkWindowMetrics_t *metrics = nkWindow_GetMetrics(window);
+
+    if (metrics != NULL)
+    {
+        if (timing->inputOldest > 0.0)
+        {
+            AddLatency(&metrics->inputLatency, nkWindow_GetTime() - timing->inputOldest);
+        }
+
+        timing->total = 0;
+
+        for (uint32_t i = 0; i < NK_FRAME_PHASE_COUNT; i++)
+        {
+            timing->total += timing->phases[i];
+        }
+
+        metrics->frameHistory[metrics->frameHistoryNext] = *timing;
+        metrics->frameHistoryNext = (metrics->frameHistoryNext + 1U) % NK_FRAME_HISTORY_COUNT;
+
+        if (metrics->frameHistoryCount < NK_FRAME_HISTORY_COUNT)
+        {
+            metrics->frameHistoryCount++;
+        }
+    }
+
+    *timing = (nkFrameTiming_t){ 0 };
+}
+
+void nkWindow_AddFrameInput(nkWindow_t *window, const nkEvent_t *event)
+{
+    nkFrameTiming_t *timing = &window->frameTiming;
+
+    /* merged events keep the oldest timestamp, so events can arrive a little out of order */
+    if (timing->inputOldest == 0.0 || event->timestamp < timing->inputOldest)
+    {
+        timing->inputOldest = event->timestamp;
+    }
+
+    if (event->timestamp > timing->inputNewest)
+    {
+        timing->inputNewest = event->timestamp;
+    }
+}
+
+void nkWindow_GetInputLatency(nkWindow_t *window, nkLatencyHistogram_t *histogram)
+{
+    if (window == NULL || histogram == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (window->renderThread != NULL)
+    {
+        nkRenderThread_Finish(window->renderThread); /* the frame in flight is timed there */
+    }
+
+    *histogram = (window->metrics != NULL) ? window->metrics->inputLatency : (nkLatencyHistogram_t){ 0 };
+}
+
+void nkWindow_GetFrameStats(nkWindow_t *window, nkFrameStats_t *stats)
+{
+    if (window == NULL || stats == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    if (window->renderThread != NULL)
+    {
+        nkRenderThread_Finish(window->renderThread); /* the frame in flight is timed there */
+    }
+
+    *stats = (nkFrameStats_t){ 0 };
+
+    const nkWindowMetrics_t *metrics = window->metrics;
+
+    if (metrics == NULL)
+    {
+        return; /* no frame finished yet */
+    }
+
+    uint32_t count = metrics->frameHistoryCount;
+
+    /* unroll the ring, the oldest frame sits where the next one will be written once it is full */
+    uint32_t oldest = (count < NK_FRAME_HISTORY_COUNT) ? 0U : metrics->frameHistoryNext;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        stats->frames[i] = metrics->frameHistory[(oldest + i) % NK_FRAME_HISTORY_COUNT];
+    }
+
+    stats->frameCount = count;
+
+    uint64_t samples[NK_FRAME_HISTORY_COUNT];
+
+    for (uint32_t phase = 0; phase < NK_FRAME_PHASE_COUNT; phase++)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            samples[i] = stats->frames[i].phases[phase];
+        }
+
+        stats->phases[phase] = GetPercentiles(samples, count);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        samples[i] = stats->frames[i].total;
+    }
+
+    stats->total = GetPercentiles(samples, count);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkFramePercentiles_t GetPercentiles(uint64_t *samples, uint32_t count)
+{
+    if (count == 0)
+    {
+        return (nkFramePercentiles_t){ 0 };
+    }
+
+    qsort(samples, count, sizeof(uint64_t), CompareSamples);
+
+    /* nearest rank, so every percentile is a frame that actually happened */
+    return (nkFramePercentiles_t){
+        .p50 = samples[(count * 50U + 99U) / 100U - 1U],
+        .p95 = samples[(count * 95U + 99U) / 100U - 1U],
+        .p99 = samples[(count * 99U + 99U) / 100U - 1U]
+    };
+}
+
+static int CompareSamples(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t *)a;
+    uint64_t right = *(const uint64_t *)b;
+
+    return (left > right) - (left < right);
+}
+
+static void AddLatency(nkLatencyHistogram_t *histogram, double latency)
+{
+    if (latency < 0.0)
+    {
+        latency = 0.0; /* stamped after the frame began, it cannot have waited on it */
+    }
+
+    uint32_t bucket = (uint32_t)(latency / NK_LATENCY_BUCKET_WIDTH);
+
+    histogram->buckets[(bucket < NK_LATENCY_BUCKET_COUNT) ? bucket : NK_LATENCY_BUCKET_COUNT - 1U]++;
+    histogram->count++;
+    histogram->sum += latency;
+
+    if (latency > histogram->max)
+    {
+        histogram->max = latency;
+    }
+}
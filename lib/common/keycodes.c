@@ -0,0 +1,335 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  keycodes.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - keycode translation tables
+**                 for Win32 virtual keys, X11 and XKB keysyms
+**                 and DOM key codes
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define KEYCODE_COUNT           (0x100U)    /* nanowin keycodes, as tracked in the window's key state */
+#define VIRTUAL_KEY_COUNT       (0x100U)
+#define KEYSYM_SLOT_COUNT       (0x200U)    /* Latin-1 keysyms, then the 0xFFxx function keysyms */
+
+/* keysyms below 0x100 are Latin-1 and take their own slot, the function keys 0xFF00 to 0xFFFF the slot
+   after them. Anything else has no keycode, see nkKeycode_FromKeysym */
+#define KEYSYM_SLOT(keysym)     ((keysym) < 0x100U ? (keysym) : 0x100U + ((keysym) & 0xFFU))
+
+/* The translations, one list per platform. KEY is the platform key a keycode is translated from and
+   back to, ALT another platform key reported as the same keycode (the right hand modifier, the keypad
+   enter) which only translates one way. Every table below is generated from these lists, so the two
+   directions cannot disagree */
+
+#define VIRTUAL_KEYS(KEY, ALT) \
+    KEY(NK_KEYCODE_SPACE,       0x20)   /* VK_SPACE */ \
+    KEY(NK_KEYCODE_BACKSPACE,   0x08)   /* VK_BACK */ \
+    KEY(NK_KEYCODE_TAB,         0x09)   /* VK_TAB */ \
+    KEY(NK_KEYCODE_CLEAR,       0x0C)   /* VK_CLEAR */ \
+    KEY(NK_KEYCODE_RETURN,      0x0D)   /* VK_RETURN */ \
+    KEY(NK_KEYCODE_PAUSE,       0x13)   /* VK_PAUSE */ \
+    KEY(NK_KEYCODE_ESCAPE,      0x1B)   /* VK_ESCAPE */ \
+    KEY(NK_KEYCODE_DELETE,      0x2E)   /* VK_DELETE */ \
+    \
+    KEY(NK_KEYCODE_SHIFT,       0x10)   /* VK_SHIFT */ \
+    ALT(NK_KEYCODE_SHIFT,       0xA0)   /* VK_LSHIFT */ \
+    ALT(NK_KEYCODE_SHIFT,       0xA1)   /* VK_RSHIFT */ \
+    KEY(NK_KEYCODE_CONTROL,     0x11)   /* VK_CONTROL */ \
+    ALT(NK_KEYCODE_CONTROL,     0xA2)   /* VK_LCONTROL */ \
+    ALT(NK_KEYCODE_CONTROL,     0xA3)   /* VK_RCONTROL */ \
+    KEY(NK_KEYCODE_META,        0x5B)   /* VK_LWIN */ \
+    ALT(NK_KEYCODE_META,        0x5C)   /* VK_RWIN */ \
+    KEY(NK_KEYCODE_ALT,         0x12)   /* VK_MENU */ \
+    ALT(NK_KEYCODE_ALT,         0xA4)   /* VK_LMENU */ \
+    ALT(NK_KEYCODE_ALT,         0xA5)   /* VK_RMENU */ \
+    \
+    KEY(NK_KEYCODE_PAGE_UP,     0x21)   /* VK_PRIOR */ \
+    KEY(NK_KEYCODE_PAGE_DOWN,   0x22)   /* VK_NEXT */ \
+    KEY(NK_KEYCODE_END,         0x23)   /* VK_END */ \
+    KEY(NK_KEYCODE_HOME,        0x24)   /* VK_HOME */ \
+    KEY(NK_KEYCODE_LEFT,        0x25)   /* VK_LEFT */ \
+    KEY(NK_KEYCODE_UP,          0x26)   /* VK_UP */ \
+    KEY(NK_KEYCODE_RIGHT,       0x27)   /* VK_RIGHT */ \
+    KEY(NK_KEYCODE_DOWN,        0x28)   /* VK_DOWN */ \
+    \
+    KEY(NK_KEYCODE_SELECT,      0x29)   /* VK_SELECT */ \
+    KEY(NK_KEYCODE_PRINT,       0x2A)   /* VK_PRINT */ \
+    ALT(NK_KEYCODE_PRINT,       0x2C)   /* VK_SNAPSHOT */ \
+    KEY(NK_KEYCODE_EXECUTE,     0x2B)   /* VK_EXECUTE */ \
+    KEY(NK_KEYCODE_INSERT,      0x2D)   /* VK_INSERT */ \
+    KEY(NK_KEYCODE_HELP,        0x2F)   /* VK_HELP */ \
+    \
+    KEY(NK_KEYCODE_F1,          0x70)   /* VK_F1 */ \
+    KEY(NK_KEYCODE_F2,          0x71) \
+    KEY(NK_KEYCODE_F3,          0x72) \
+    KEY(NK_KEYCODE_F4,          0x73) \
+    KEY(NK_KEYCODE_F5,          0x74) \
+    KEY(NK_KEYCODE_F6,          0x75) \
+    KEY(NK_KEYCODE_F7,          0x76) \
+    KEY(NK_KEYCODE_F8,          0x77) \
+    KEY(NK_KEYCODE_F9,          0x78) \
+    KEY(NK_KEYCODE_F10,         0x79) \
+    KEY(NK_KEYCODE_F11,         0x7A) \
+    KEY(NK_KEYCODE_F12,         0x7B) \
+    KEY(NK_KEYCODE_F13,         0x7C) \
+    KEY(NK_KEYCODE_F14,         0x7D) \
+    KEY(NK_KEYCODE_F15,         0x7E) \
+    KEY(NK_KEYCODE_F16,         0x7F) \
+    KEY(NK_KEYCODE_F17,         0x80) \
+    KEY(NK_KEYCODE_F18,         0x81) \
+    KEY(NK_KEYCODE_F19,         0x82) \
+    KEY(NK_KEYCODE_F20,         0x83) \
+    KEY(NK_KEYCODE_F21,         0x84) \
+    KEY(NK_KEYCODE_F22,         0x85) \
+    KEY(NK_KEYCODE_F23,         0x86) \
+    KEY(NK_KEYCODE_F24,         0x87)   /* VK_F24 */
+
+/* X11 keysyms, which XKB shares */
+#define KEYSYMS(KEY, ALT) \
+    KEY(NK_KEYCODE_SPACE,       0x0020) /* XK_space */ \
+    KEY(NK_KEYCODE_BACKSPACE,   0xFF08) /* XK_BackSpace */ \
+    KEY(NK_KEYCODE_TAB,         0xFF09) /* XK_Tab */ \
+    KEY(NK_KEYCODE_CLEAR,       0xFF0B) /* XK_Clear */ \
+    KEY(NK_KEYCODE_RETURN,      0xFF0D) /* XK_Return */ \
+    ALT(NK_KEYCODE_RETURN,      0xFF8D) /* XK_KP_Enter */ \
+    KEY(NK_KEYCODE_PAUSE,       0xFF13) /* XK_Pause */ \
+    KEY(NK_KEYCODE_ESCAPE,      0xFF1B) /* XK_Escape */ \
+    KEY(NK_KEYCODE_DELETE,      0xFFFF) /* XK_Delete */ \
+    \
+    KEY(NK_KEYCODE_SHIFT,       0xFFE1) /* XK_Shift_L */ \
+    ALT(NK_KEYCODE_SHIFT,       0xFFE2) /* XK_Shift_R */ \
+    KEY(NK_KEYCODE_CONTROL,     0xFFE3) /* XK_Control_L */ \
+    ALT(NK_KEYCODE_CONTROL,     0xFFE4) /* XK_Control_R */ \
+    KEY(NK_KEYCODE_META,        0xFFE7) /* XK_Meta_L */ \
+    ALT(NK_KEYCODE_META,        0xFFE8) /* XK_Meta_R */ \
+    KEY(NK_KEYCODE_ALT,         0xFFE9) /* XK_Alt_L */ \
+    ALT(NK_KEYCODE_ALT,         0xFFEA) /* XK_Alt_R */ \
+    KEY(NK_KEYCODE_SUPER,       0xFFEB) /* XK_Super_L */ \
+    ALT(NK_KEYCODE_SUPER,       0xFFEC) /* XK_Super_R */ \
+    KEY(NK_KEYCODE_HYPER,       0xFFED) /* XK_Hyper_L */ \
+    ALT(NK_KEYCODE_HYPER,       0xFFEE) /* XK_Hyper_R */ \
+    \
+    KEY(NK_KEYCODE_PAGE_UP,     0xFF55) /* XK_Prior */ \
+    KEY(NK_KEYCODE_PAGE_DOWN,   0xFF56) /* XK_Next */ \
+    KEY(NK_KEYCODE_END,         0xFF57) /* XK_End */ \
+    KEY(NK_KEYCODE_HOME,        0xFF50) /* XK_Home */ \
+    KEY(NK_KEYCODE_LEFT,        0xFF51) /* XK_Left */ \
+    KEY(NK_KEYCODE_UP,          0xFF52) /* XK_Up */ \
+    KEY(NK_KEYCODE_RIGHT,       0xFF53) /* XK_Right */ \
+    KEY(NK_KEYCODE_DOWN,        0xFF54) /* XK_Down */ \
+    \
+    KEY(NK_KEYCODE_SELECT,      0xFF60) /* XK_Select */ \
+    KEY(NK_KEYCODE_PRINT,       0xFF61) /* XK_Print */ \
+    KEY(NK_KEYCODE_EXECUTE,     0xFF62) /* XK_Execute */ \
+    KEY(NK_KEYCODE_INSERT,      0xFF63) /* XK_Insert */ \
+    KEY(NK_KEYCODE_HELP,        0xFF6A) /* XK_Help */ \
+    \
+    KEY(NK_KEYCODE_F1,          0xFFBE) /* XK_F1 */ \
+    KEY(NK_KEYCODE_F2,          0xFFBF) \
+    KEY(NK_KEYCODE_F3,          0xFFC0) \
+    KEY(NK_KEYCODE_F4,          0xFFC1) \
+    KEY(NK_KEYCODE_F5,          0xFFC2) \
+    KEY(NK_KEYCODE_F6,          0xFFC3) \
+    KEY(NK_KEYCODE_F7,          0xFFC4) \
+    KEY(NK_KEYCODE_F8,          0xFFC5) \
+    KEY(NK_KEYCODE_F9,          0xFFC6) \
+    KEY(NK_KEYCODE_F10,         0xFFC7) \
+    KEY(NK_KEYCODE_F11,         0xFFC8) \
+    KEY(NK_KEYCODE_F12,         0xFFC9) \
+    KEY(NK_KEYCODE_F13,         0xFFCA) \
+    KEY(NK_KEYCODE_F14,         0xFFCB) \
+    KEY(NK_KEYCODE_F15,         0xFFCC) \
+    KEY(NK_KEYCODE_F16,         0xFFCD) \
+    KEY(NK_KEYCODE_F17,         0xFFCE) \
+    KEY(NK_KEYCODE_F18,         0xFFCF) \
+    KEY(NK_KEYCODE_F19,         0xFFD0) \
+    KEY(NK_KEYCODE_F20,         0xFFD1) \
+    KEY(NK_KEYCODE_F21,         0xFFD2) \
+    KEY(NK_KEYCODE_F22,         0xFFD3) \
+    KEY(NK_KEYCODE_F23,         0xFFD4) \
+    KEY(NK_KEYCODE_F24,         0xFFD5) /* XK_F24 */
+
+/* KeyboardEvent.code values, which name the physical key whatever the layout */
+#define CODES(KEY, ALT) \
+    KEY(NK_KEYCODE_SPACE,       "Space") \
+    KEY(NK_KEYCODE_BACKSPACE,   "Backspace") \
+    KEY(NK_KEYCODE_TAB,         "Tab") \
+    KEY(NK_KEYCODE_CLEAR,       "NumpadClear") \
+    KEY(NK_KEYCODE_RETURN,      "Enter") \
+    ALT(NK_KEYCODE_RETURN,      "NumpadEnter") \
+    KEY(NK_KEYCODE_PAUSE,       "Pause") \
+    KEY(NK_KEYCODE_ESCAPE,      "Escape") \
+    KEY(NK_KEYCODE_DELETE,      "Delete") \
+    \
+    KEY(NK_KEYCODE_SHIFT,       "ShiftLeft") \
+    ALT(NK_KEYCODE_SHIFT,       "ShiftRight") \
+    KEY(NK_KEYCODE_CONTROL,     "ControlLeft") \
+    ALT(NK_KEYCODE_CONTROL,     "ControlRight") \
+    KEY(NK_KEYCODE_META,        "MetaLeft") \
+    ALT(NK_KEYCODE_META,        "MetaRight") \
+    ALT(NK_KEYCODE_META,        "OSLeft") \
+    ALT(NK_KEYCODE_META,        "OSRight") \
+    KEY(NK_KEYCODE_ALT,         "AltLeft") \
+    ALT(NK_KEYCODE_ALT,         "AltRight") \
+    KEY(NK_KEYCODE_SUPER,       "Super") \
+    KEY(NK_KEYCODE_HYPER,       "Hyper") \
+    \
+    KEY(NK_KEYCODE_PAGE_UP,     "PageUp") \
+    KEY(NK_KEYCODE_PAGE_DOWN,   "PageDown") \
+    KEY(NK_KEYCODE_END,         "End") \
+    KEY(NK_KEYCODE_HOME,        "Home") \
+    KEY(NK_KEYCODE_LEFT,        "ArrowLeft") \
+    KEY(NK_KEYCODE_UP,          "ArrowUp") \
+    KEY(NK_KEYCODE_RIGHT,       "ArrowRight") \
+    KEY(NK_KEYCODE_DOWN,        "ArrowDown") \
+    \
+    KEY(NK_KEYCODE_SELECT,      "Select") \
+    KEY(NK_KEYCODE_PRINT,       "PrintScreen") \
+    KEY(NK_KEYCODE_INSERT,      "Insert") \
+    KEY(NK_KEYCODE_HELP,        "Help") \
+    \
+    KEY(NK_KEYCODE_F1,          "F1") \
+    KEY(NK_KEYCODE_F2,          "F2") \
+    KEY(NK_KEYCODE_F3,          "F3") \
+    KEY(NK_KEYCODE_F4,          "F4") \
+    KEY(NK_KEYCODE_F5,          "F5") \
+    KEY(NK_KEYCODE_F6,          "F6") \
+    KEY(NK_KEYCODE_F7,          "F7") \
+    KEY(NK_KEYCODE_F8,          "F8") \
+    KEY(NK_KEYCODE_F9,          "F9") \
+    KEY(NK_KEYCODE_F10,         "F10") \
+    KEY(NK_KEYCODE_F11,         "F11") \
+    KEY(NK_KEYCODE_F12,         "F12") \
+    KEY(NK_KEYCODE_F13,         "F13") \
+    KEY(NK_KEYCODE_F14,         "F14") \
+    KEY(NK_KEYCODE_F15,         "F15") \
+    KEY(NK_KEYCODE_F16,         "F16") \
+    KEY(NK_KEYCODE_F17,         "F17") \
+    KEY(NK_KEYCODE_F18,         "F18") \
+    KEY(NK_KEYCODE_F19,         "F19") \
+    KEY(NK_KEYCODE_F20,         "F20") \
+    KEY(NK_KEYCODE_F21,         "F21") \
+    KEY(NK_KEYCODE_F22,         "F22") \
+    KEY(NK_KEYCODE_F23,         "F23") \
+    KEY(NK_KEYCODE_F24,         "F24")
+
+/* table generators, a list expands to designated initializers in either direction */
+#define TO_KEYCODE(keycode, key)        [key] = (keycode),
+#define KEYSYM_TO_KEYCODE(keycode, key) [KEYSYM_SLOT(key)] = (keycode),
+#define FROM_KEYCODE(keycode, key)      [keycode] = (key),
+#define CODE_ENTRY(keycode, key)        { (key), (keycode) },
+#define SKIP(keycode, key)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    const char *code;
+    uint8_t keycode;
+} nkCodeEntry_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const uint8_t virtualKeyToKeycode[VIRTUAL_KEY_COUNT] = { VIRTUAL_KEYS(TO_KEYCODE, TO_KEYCODE) };
+static const uint8_t keycodeToVirtualKey[KEYCODE_COUNT] = { VIRTUAL_KEYS(FROM_KEYCODE, SKIP) };
+
+static const uint8_t keysymToKeycode[KEYSYM_SLOT_COUNT] = { KEYSYMS(KEYSYM_TO_KEYCODE, KEYSYM_TO_KEYCODE) };
+static const uint16_t keycodeToKeysym[KEYCODE_COUNT] = { KEYSYMS(FROM_KEYCODE, SKIP) };
+
+/* codes are strings, so they are looked up by scanning, which key events are rare enough for */
+static const nkCodeEntry_t codeToKeycode[] = { CODES(CODE_ENTRY, CODE_ENTRY) };
+static const char *const keycodeToCode[KEYCODE_COUNT] = { CODES(FROM_KEYCODE, SKIP) };
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+uint32_t nkKeycode_FromVirtualKey(uint32_t virtualKey)
+{
+    if (virtualKey >= VIRTUAL_KEY_COUNT)
+    {
+        return 0;
+    }
+
+    return virtualKeyToKeycode[virtualKey];
+}
+
+uint32_t nkKeycode_ToVirtualKey(uint32_t keycode)
+{
+    if (keycode >= KEYCODE_COUNT)
+    {
+        return 0;
+    }
+
+    return keycodeToVirtualKey[keycode];
+}
+
+uint32_t nkKeycode_FromKeysym(uint32_t keysym)
+{
+    if (keysym >= 0x100U && (keysym & 0xFF00U) != 0xFF00U)
+    {
+        return 0; /* outside the ranges the table covers, none of them is a keycode */
+    }
+
+    return keysymToKeycode[KEYSYM_SLOT(keysym)];
+}
+
+uint32_t nkKeycode_ToKeysym(uint32_t keycode)
+{
+    if (keycode >= KEYCODE_COUNT)
+    {
+        return 0;
+    }
+
+    return keycodeToKeysym[keycode];
+}
+
+uint32_t nkKeycode_FromCode(const char *code)
+{
+    if (code == NULL)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < sizeof(codeToKeycode) / sizeof(codeToKeycode[0]); i++)
+    {
+        if (strcmp(codeToKeycode[i].code, code) == 0)
+        {
+            return codeToKeycode[i].keycode;
+        }
+    }
+
+    return 0;
+}
+
+const char *nkKeycode_ToCode(uint32_t keycode)
+{
+    if (keycode >= KEYCODE_COUNT)
+    {
+        return NULL;
+    }
+
+    return keycodeToCode[keycode];
+}
@@ -0,0 +1,86 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  layout.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - cached view layout
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkWindow_LayoutViews(nkWindow_t *window)
+{
+    if (window == NULL || window->rootView == NULL)
+    {
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Window contains no views");
+        return;
+    }
+
+    uint64_t start = nkWindow_GetTicks();
+    uint64_t trace = NK_TRACE_BEGIN(NK_TRACE_LEVEL_INFO);
+
+    nkView_LayoutTree(window->rootView, (nkSize_t){window->width, window->height}, &window->drawContext);
+
+    /* hit-testing reads the frames from here on, so index them while they are fresh */
+    if (window->viewIndex == NULL)
+    {
+        window->viewIndex = nkViewIndex_Create();
+    }
+
+    if (window->viewIndex != NULL && !nkViewIndex_Build(window->viewIndex, window->rootView, window->width, window->height))
+    {
+        NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "view", "Failed to index the view tree, hit-testing walks it instead");
+    }
+
+    nkWindow_AddFrameTime(window, NK_FRAME_PHASE_LAYOUT, start);
+    NK_TRACE_END(NK_TRACE_LEVEL_INFO, "frame", "LayoutViews", trace);
+
+    window->layoutSize = (nkSize_t){ window->width, window->height };
+    window->layoutDirty = false;
+
+    window->layoutGeneration++;
+    NK_STATS_ADD(window, layoutsPerformed, 1U);
+}
+
+void nkWindow_SetNeedsLayout(nkWindow_t *window)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->layoutDirty = true;
+
+    nkWindow_RequestRedraw(window);
+}
+
+void nkWindow_UpdateLayout(nkWindow_t *window)
+{
+    if (window->rootView == NULL)
+    {
+        return; /* nothing to lay out */
+    }
+
+    if (!window->layoutDirty && window->layoutSize.width == window->width && window->layoutSize.height == window->height)
+    {
+        return; /* the last layout still holds */
+    }
+
+    nkWindow_LayoutViews(window);
+}
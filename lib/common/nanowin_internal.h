@@ -0,0 +1,241 @@
+/***************************************************************
+**
+** NanoKit Library Header File
+**
+** File         :  nanowin_internal.h
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - shared backend internals
+**
+***************************************************************/
+
+#ifndef NANOWIN_INTERNAL_H
+#define NANOWIN_INTERNAL_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <nanowin.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* adds amount to one of the window's nkWindowStats_t counters */
+#define NK_STATS_ADD(window, counter, amount) \
+    do \
+    { \
+        nkWindowMetrics_t *statsMetrics = nkWindow_GetMetrics(window); \
+        \
+        if (statsMetrics != NULL) \
+        { \
+            statsMetrics->stats.counter += (amount); \
+        } \
+    } while (0)
+
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+    /* Windows 10 1803 and later, missing from older SDK and MinGW headers */
+    #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION   (0x00000002UL)
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct nkEventRing_t nkEventRing_t;
+typedef struct nkPostQueue_t nkPostQueue_t;
+typedef struct nkRecording_t nkRecording_t;
+typedef struct nkReplay_t nkReplay_t;
+typedef struct nkViewIndex_t nkViewIndex_t;
+typedef struct nkRenderThread_t nkRenderThread_t;
+
+/* what a window measures, kept out of nkWindow_t and allocated the first time anything is counted, see
+   nkWindow_GetMetrics. A render thread's copy of the window points at the same block and only writes the
+   frame counters, history and latency, which the UI thread reads after nkRenderThread_Finish */
+typedef struct nkWindowMetrics_t
+{
+    nkWindowStats_t stats;
+    nkFrameTiming_t frameHistory[NK_FRAME_HISTORY_COUNT];   /* the last frames, a ring */
+    uint32_t frameHistoryCount;
+    uint32_t frameHistoryNext;
+    nkLatencyHistogram_t inputLatency;
+} nkWindowMetrics_t;
+
+/* the offset between a platform's event times and nkWindow_GetTime, see nkEventClock_Convert */
+typedef struct
+{
+    double offset;
+    bool valid;
+} nkEventClock_t;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* delivers a translated event to the window callbacks and the view tree */
+void nkWindow_DispatchEvent(nkWindow_t *window, const nkEvent_t *event);
+
+/* the window's delegate, or one with every callback NULL if it has none, so callers need not check twice */
+const nkWindowDelegate_t *nkWindow_GetDelegate(nkWindow_t *window);
+
+/* entry point for backends: stamps the event, then dispatches it now or queues it on the window's input ring */
+void nkWindow_PostInput(nkWindow_t *window, nkEvent_t *event);
+
+/* dispatches what was queued on the window's input ring and any motion or scroll held back for merging,
+   once per window per pump before painting. Returns false if the window was closed by it */
+bool nkWindow_DrainInput(nkWindow_t *window);
+
+/* for state changes made on the UI thread itself: stamps the event and dispatches it now, after any motion
+   or scroll held back for merging. Never goes through the input ring, whose only producer is the input thread */
+void nkWindow_ApplyEvent(nkWindow_t *window, nkEvent_t *event);
+
+/* backend hook for nkWindow_PostEvent, called from any thread to make the UI thread pump again */
+void nkWindow_WakeEventLoop(nkWindow_t *window);
+
+/* frame scheduling (frame.c). nkWindow_RequestRedraw only marks the window dirty and,
+   on the first request since the last frame, calls the backend's nkWindow_ScheduleFrame.
+   nkWindow_RequestFrame schedules a frame without damaging anything, so the pump runs again.
+   nkWindow_BeginFrame takes the damage, returning false if there is nothing to draw */
+void nkWindow_ScheduleFrame(nkWindow_t *window);
+void nkWindow_RequestFrame(nkWindow_t *window);
+bool nkWindow_BeginFrame(nkWindow_t *window, nkWindowDamage_t *damage);
+void nkWindow_RenderFrame(nkWindow_t *window, const nkWindowDamage_t *damage);
+
+/* the window's metrics (framestats.c), allocated on first use. NULL only if that allocation failed, in
+   which case what was to be counted is dropped. nkWindow_DestroyMetrics frees them with the window */
+nkWindowMetrics_t *nkWindow_GetMetrics(nkWindow_t *window);
+void nkWindow_DestroyMetrics(nkWindow_t *window);
+
+/* frame timing (framestats.c). Phases add the time since start to the frame being timed,
+   nkWindow_FinishFrame adds the present phase and moves the frame into the window's history */
+uint64_t nkWindow_GetTicks(void);
+void nkWindow_AddFrameTime(nkWindow_t *window, nkFramePhase_t phase, uint64_t start);
+void nkWindow_FinishFrame(nkWindow_t *window, uint64_t presentStart);
+
+/* notes an input event dispatched towards the frame being timed, whose present then adds
+   the latency from the oldest such input to the window's input latency histogram */
+void nkWindow_AddFrameInput(nkWindow_t *window, const nkEvent_t *event);
+
+/* frame rate caps (pacing.c). nkWindow_PaceFrame is called by the backend right before it presents, and
+   waits until the window's cap allows the present. nkWindow_GetPaceDelay is the seconds that wait would
+   take, for backends that cannot block and have to come back later instead. Each thread that paces keeps
+   a wait timer, nkWindow_ReleasePaceTimer closes the calling thread's before it exits */
+void nkWindow_PaceFrame(nkWindow_t *window);
+double nkWindow_GetPaceDelay(nkWindow_t *window);
+void nkWindow_ReleasePaceTimer(void);
+
+/* converts a platform event time (in seconds, on whatever clock the platform stamps events with)
+   to the nkWindow_GetTime clock, so an event is timed from when the platform received it (clock.c) */
+double nkEventClock_Convert(nkEventClock_t *clock, double platformSeconds);
+
+/* lays out the view tree if it changed or the window was resized since the last layout (layout.c) */
+void nkWindow_UpdateLayout(nkWindow_t *window);
+
+/* uniform grid over the view frames (viewindex.c). nkViewIndex_Find returns the view a walk of the
+   tree would stop at for the point, or root if the point misses it, so none of the returned view's
+   children need testing. Returns NULL if the index was not built for root or the point is off the window */
+nkViewIndex_t *nkViewIndex_Create(void);
+void nkViewIndex_Destroy(nkViewIndex_t *index);
+bool nkViewIndex_Build(nkViewIndex_t *index, nkView_t *root, float width, float height);
+nkView_t *nkViewIndex_Find(nkViewIndex_t *index, nkView_t *root, float x, float y);
+
+/* render threads (renderthread.c). nkRenderThread_Submit snapshots the window's views and hands the
+   frame to the thread, waiting only if two frames are already in flight. nkRenderThread_Finish waits for
+   every submitted frame, after which their timing can be read from the window's metrics. It returns the
+   render thread's copy of the window, which is safe to read until the next submit */
+nkRenderThread_t *nkRenderThread_Create(nkWindow_t *window);
+void nkRenderThread_Destroy(nkRenderThread_t *thread);
+bool nkRenderThread_Submit(nkRenderThread_t *thread, const nkWindowDamage_t *damage);
+nkWindow_t *nkRenderThread_Finish(nkRenderThread_t *thread);
+
+/* backend hooks, called on the render thread with its copy of the window. nkWindow_BindRenderThread
+   makes the context current there, nkWindow_PresentFrame draws the damage and presents it, and
+   nkWindow_UnbindRenderThread releases the context and hands what the copy changed back to the window */
+bool nkWindow_BindRenderThread(nkWindow_t *target);
+void nkWindow_PresentFrame(nkWindow_t *target, nkWindowDamage_t *damage);
+void nkWindow_UnbindRenderThread(nkWindow_t *window, nkWindow_t *target);
+
+/* draw resources shared by every window whose context is in the backend's share group (sharedraw.c).
+   The first acquire creates them with the caller's context current, and every window acquires once,
+   with its own context current so its vertex array is created there. Release returns true for the
+   last window, after which the backend can let the group go */
+void nkSharedDraw_Acquire(nkDrawContext_t *context);
+bool nkSharedDraw_Release(void);
+
+/* single producer, single consumer ring of events (eventring.c) */
+nkEventRing_t *nkEventRing_Create(void);
+void nkEventRing_Destroy(nkEventRing_t *ring);
+bool nkEventRing_Push(nkEventRing_t *ring, const nkEvent_t *event);
+bool nkEventRing_Pop(nkEventRing_t *ring, nkEvent_t *event);
+uint32_t nkEventRing_Count(nkEventRing_t *ring);
+uint32_t nkEventRing_Dropped(nkEventRing_t *ring);
+
+/* timers (timer.c). nkWindow_ServiceTimers runs the callbacks now due, once per pump.
+   nkWindow_GetTimerTimeout shortens a wait timeout to end at the next deadline */
+void nkWindow_ServiceTimers(void);
+double nkWindow_GetTimerTimeout(double timeoutSeconds);
+
+/* keycode translation (keycodes.c). Both directions come from one list per platform, so a keycode
+   translated to a platform key translates back to itself. Return 0, or NULL, where there is no key */
+uint32_t nkKeycode_FromVirtualKey(uint32_t virtualKey);
+uint32_t nkKeycode_ToVirtualKey(uint32_t keycode);
+uint32_t nkKeycode_FromKeysym(uint32_t keysym);
+uint32_t nkKeycode_ToKeysym(uint32_t keycode);
+uint32_t nkKeycode_FromCode(const char *code);
+const char *nkKeycode_ToCode(uint32_t keycode);
+
+/* appends an event reaching the dispatcher to a recording (record.c) */
+void nkRecording_Write(nkRecording_t *recording, const nkEvent_t *event);
+
+/* multiple producer, single consumer queue of posted events (postqueue.c) */
+nkPostQueue_t *nkPostQueue_Create(void);
+void nkPostQueue_Destroy(nkPostQueue_t *queue);
+bool nkPostQueue_Push(nkPostQueue_t *queue, const nkEvent_t *event);
+bool nkPostQueue_Pop(nkPostQueue_t *queue, nkEvent_t *event);
+
+/* tracks key and pointer action state from the events dispatched to a window, which every backend reports it from */
+void nkWindow_TrackInputState(nkWindow_t *window, const nkEvent_t *event);
+bool nkWindow_TestKeyState(nkWindow_t *window, uint32_t keycode);
+bool nkWindow_TestPointerActionState(nkWindow_t *window, nkPointerAction_t action);
+
+#if NANOWIN_HEADLESS || NANOWIN_WAYLAND || NANOWIN_X11
+
+/* self pipe wakeups (wakeup.c). nkWakeup_Wait sleeps until fd (or nothing if negative) is readable,
+   nkWakeup_Signal is called from another thread or the timeout passes. Returns true if fd is readable */
+bool nkWakeup_Init(void);
+void nkWakeup_Signal(void);
+bool nkWakeup_Wait(int fd, double timeoutSeconds);
+
+/* EGL pbuffer render targets (offscreen.c), using the window's eglSurface and eglContext.
+   Headless builds without EGL get offscreen_none.c instead, where nkOffscreen_Init fails */
+bool nkOffscreen_Init(void);
+bool nkOffscreen_CreateTarget(nkWindow_t *window, uint32_t width, uint32_t height);
+bool nkOffscreen_ResizeTarget(nkWindow_t *window, uint32_t width, uint32_t height);
+bool nkOffscreen_MakeCurrent(nkWindow_t *window);
+void nkOffscreen_ReleaseCurrent(void);
+
+/* puts the contexts of targets created afterwards in one share group, until nkOffscreen_DestroyShareGroup
+   lets it go once the last of them is destroyed */
+void nkOffscreen_ShareContexts(void);
+void nkOffscreen_DestroyShareGroup(void);
+void nkOffscreen_ReadPixels(nkWindow_t *window, uint32_t x, uint32_t y, uint32_t width, uint32_t height, GLenum format, uint8_t *pixels, size_t stride);
+void nkOffscreen_DestroyTarget(nkWindow_t *window);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NANOWIN_INTERNAL_H */
@@ -0,0 +1,293 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  offscreen.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - EGL pbuffer render targets
+**                 for backends that present from CPU memory
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <EGL/eglext.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA       (0x31DDU)
+#endif
+
+#define FLIP_CHUNK_SIZE                     (4096U) /* bytes of a row swapped per copy, a 1024 pixel row at once */
+
+static const EGLint configAttribs[] =
+{
+    EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+    EGL_RED_SIZE,           8,
+    EGL_GREEN_SIZE,         8,
+    EGL_BLUE_SIZE,          8,
+    EGL_ALPHA_SIZE,         8,
+    EGL_DEPTH_SIZE,         24,
+    EGL_STENCIL_SIZE,       8,
+    EGL_NONE
+};
+
+static const EGLint gl33Attribs[] =
+{
+    EGL_CONTEXT_MAJOR_VERSION,          3,
+    EGL_CONTEXT_MINOR_VERSION,          3,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+};
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static bool initialized = false;
+static bool available = false;
+static bool glLoaded = false;
+
+static EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+static EGLConfig eglConfig = NULL;
+
+/* with nkOffscreen_ShareContexts every context shares objects with shareRoot, which is never made
+   current and only exists so the group outlives whichever window created it */
+static bool sharing = false;
+static EGLContext shareRoot = EGL_NO_CONTEXT;
+
+/* per thread, a window with a render thread has its context current there instead */
+static _Thread_local EGLContext currentContext = EGL_NO_CONTEXT;
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkOffscreen_Init(void)
+{
+    if (initialized)
+    {
+        return available;
+    }
+
+    initialized = true;
+
+    /* prefer a display that needs no window system, such as Mesa surfaceless with llvmpipe */
+    PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+    if (eglGetPlatformDisplayEXT)
+    {
+        eglDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    }
+
+    if (eglDisplay == EGL_NO_DISPLAY)
+    {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, NULL, NULL))
+    {
+        fprintf(stderr, "No EGL display available, rendering is disabled.\n");
+        return false;
+    }
+
+    EGLint numConfigs = 0;
+
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(eglDisplay, configAttribs, &eglConfig, 1, &numConfigs) || numConfigs == 0)
+    {
+        fprintf(stderr, "No suitable EGL config available, rendering is disabled.\n");
+        return false;
+    }
+
+    available = true;
+
+    return true;
+}
+
+void nkOffscreen_ShareContexts(void)
+{
+    sharing = true;
+}
+
+void nkOffscreen_DestroyShareGroup(void)
+{
+    if (shareRoot == EGL_NO_CONTEXT)
+    {
+        return; /* nothing to do */
+    }
+
+    eglDestroyContext(eglDisplay, shareRoot);
+    shareRoot = EGL_NO_CONTEXT;
+}
+
+bool nkOffscreen_CreateTarget(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    if (sharing && shareRoot == EGL_NO_CONTEXT)
+    {
+        shareRoot = eglCreateContext(eglDisplay, eglConfig, EGL_NO_CONTEXT, gl33Attribs);
+    }
+
+    window->eglSurface = EGL_NO_SURFACE;
+    window->eglContext = eglCreateContext(eglDisplay, eglConfig, shareRoot, gl33Attribs);
+
+    if (window->eglContext == EGL_NO_CONTEXT)
+    {
+        fprintf(stderr, "Failed to create OpenGL 3.3 context.\n");
+        return false;
+    }
+
+    if (!nkOffscreen_ResizeTarget(window, width, height))
+    {
+        fprintf(stderr, "Failed to create a %u x %u pbuffer.\n", width, height);
+        return false;
+    }
+
+    if (!nkOffscreen_MakeCurrent(window))
+    {
+        fprintf(stderr, "Failed to activate OpenGL 3.3 rendering context.\n");
+        return false;
+    }
+
+    if (!glLoaded)
+    {
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+        {
+            fprintf(stderr, "Failed to initialize GLAD for OpenGL 3.3.\n");
+            return false;
+        }
+
+        glLoaded = true;
+    }
+
+    return true;
+}
+
+bool nkOffscreen_ResizeTarget(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    const EGLint pbufferAttribs[] =
+    {
+        EGL_WIDTH,  (EGLint)((width > 0) ? width : 1U),
+        EGL_HEIGHT, (EGLint)((height > 0) ? height : 1U),
+        EGL_NONE
+    };
+
+    if (currentContext == window->eglContext)
+    {
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        currentContext = EGL_NO_CONTEXT;
+    }
+
+    if (window->eglSurface != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(eglDisplay, window->eglSurface);
+    }
+
+    window->eglSurface = eglCreatePbufferSurface(eglDisplay, eglConfig, pbufferAttribs);
+
+    return window->eglSurface != EGL_NO_SURFACE;
+}
+
+bool nkOffscreen_MakeCurrent(nkWindow_t *window)
+{
+    if (currentContext == window->eglContext)
+    {
+        return true;
+    }
+
+    if (!eglMakeCurrent(eglDisplay, window->eglSurface, window->eglSurface, window->eglContext))
+    {
+        return false;
+    }
+
+    currentContext = window->eglContext;
+
+    return true;
+}
+
+void nkOffscreen_ReleaseCurrent(void)
+{
+    if (currentContext == EGL_NO_CONTEXT)
+    {
+        return; /* nothing to do */
+    }
+
+    /* a context can only be current on one thread, so it has to be let go before another can take it */
+    eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    currentContext = EGL_NO_CONTEXT;
+}
+
+void nkOffscreen_ReadPixels(nkWindow_t *window, uint32_t x, uint32_t y, uint32_t width, uint32_t height, GLenum format, uint8_t *pixels, size_t stride)
+{
+    if (height == 0 || !nkOffscreen_MakeCurrent(window))
+    {
+        return;
+    }
+
+    EGLint surfaceHeight = 0;
+    eglQuerySurface(eglDisplay, window->eglSurface, EGL_HEIGHT, &surfaceHeight);
+
+    /* x, y and pixels are top-down, GL is bottom-up */
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, (GLint)(stride / 4U));
+    glReadPixels((GLint)x, (GLint)((uint32_t)surfaceHeight - y - height), (GLsizei)width, (GLsizei)height, format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+    /* flip the rows in place so the caller gets a top-down image, swapping whole rows through a buffer */
+    uint8_t buffer[FLIP_CHUNK_SIZE];
+    uint8_t *top = pixels;
+    uint8_t *bottom = pixels + stride * (height - 1U);
+    size_t rowBytes = (size_t)width * 4U;
+
+    while (top < bottom)
+    {
+        for (size_t offset = 0; offset < rowBytes; offset += FLIP_CHUNK_SIZE)
+        {
+            size_t size = (rowBytes - offset < FLIP_CHUNK_SIZE) ? rowBytes - offset : FLIP_CHUNK_SIZE;
+
+            memcpy(buffer, top + offset, size);
+            memcpy(top + offset, bottom + offset, size);
+            memcpy(bottom + offset, buffer, size);
+        }
+
+        top += stride;
+        bottom -= stride;
+    }
+}
+
+void nkOffscreen_DestroyTarget(nkWindow_t *window)
+{
+    if (currentContext == window->eglContext)
+    {
+        eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        currentContext = EGL_NO_CONTEXT;
+    }
+
+    if (window->eglSurface != EGL_NO_SURFACE)
+    {
+        eglDestroySurface(eglDisplay, window->eglSurface);
+        window->eglSurface = EGL_NO_SURFACE;
+    }
+
+    if (window->eglContext != EGL_NO_CONTEXT)
+    {
+        eglDestroyContext(eglDisplay, window->eglContext);
+        window->eglContext = EGL_NO_CONTEXT;
+    }
+}
@@ -0,0 +1,88 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  offscreen_none.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - offscreen targets for
+**                 headless builds without EGL, none are available
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkOffscreen_Init(void)
+{
+    return false; /* built without EGL, only dispatch and layout run */
+}
+
+void nkOffscreen_ShareContexts(void)
+{
+    /* nothing to share */
+}
+
+void nkOffscreen_DestroyShareGroup(void)
+{
+    /* nothing to do */
+}
+
+bool nkOffscreen_CreateTarget(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    (void)window;
+    (void)width;
+    (void)height;
+
+    return false;
+}
+
+bool nkOffscreen_ResizeTarget(nkWindow_t *window, uint32_t width, uint32_t height)
+{
+    (void)window;
+    (void)width;
+    (void)height;
+
+    return false;
+}
+
+bool nkOffscreen_MakeCurrent(nkWindow_t *window)
+{
+    (void)window;
+
+    return false;
+}
+
+void nkOffscreen_ReleaseCurrent(void)
+{
+    /* nothing to do */
+}
+
+void nkOffscreen_ReadPixels(nkWindow_t *window, uint32_t x, uint32_t y, uint32_t width, uint32_t height, GLenum format, uint8_t *pixels, size_t stride)
+{
+    (void)window;
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+    (void)format;
+    (void)pixels;
+    (void)stride;
+}
+
+void nkOffscreen_DestroyTarget(nkWindow_t *window)
+{
+    (void)window;
+}
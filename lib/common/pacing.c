@@ -0,0 +1,210 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  pacing.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - swap intervals and frame
+**                 rate caps
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+    #include <time.h>
+    #include <errno.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define PACE_SPIN_MARGIN        (1000000ULL)    /* ns before the deadline a sleep hands over to spinning, more than a timed sleep oversleeps by */
+#define PACE_COARSE_MARGIN      (16000000ULL)   /* the same for Windows without high resolution timers, a scheduler tick */
+
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL        __declspec(thread)
+#else
+    #define THREAD_LOCAL        _Thread_local
+#endif
+
+#if defined(_WIN32)
+    #define SPIN_PAUSE()        YieldProcessor()
+#elif defined(__x86_64__) || defined(__i386__)
+    #define SPIN_PAUSE()        __builtin_ia32_pause()
+#else
+    #define SPIN_PAUSE()
+#endif
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+#if defined(_WIN32)
+    /* created on the first wait and reused, each thread that presents has its own */
+    static THREAD_LOCAL HANDLE paceTimer = NULL;
+    static THREAD_LOCAL bool paceTimerCoarse = false;   /* no high resolution timers, it can wake a tick late */
+#endif
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+#if !defined(__EMSCRIPTEN__)
+static void WaitUntil(uint64_t deadline, bool spin);
+#endif
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkWindow_SetSwapInterval(nkWindow_t *window, nkSwapInterval_t interval)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->swapInterval = interval;
+    window->swapIntervalChanged = true;
+}
+
+void nkWindow_SetMaxFrameRate(nkWindow_t *window, float framesPerSecond)
+{
+    if (window == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    window->maxFrameRate = (framesPerSecond > 0.0f) ? framesPerSecond : 0.0f;
+    window->nextPresent = 0; /* the next frame starts the new pace */
+}
+
+void nkWindow_PaceFrame(nkWindow_t *window)
+{
+    if (window->maxFrameRate <= 0.0f)
+    {
+        return; /* uncapped */
+    }
+
+    uint64_t period = (uint64_t)(1e9 / (double)window->maxFrameRate);
+    uint64_t now = nkWindow_GetTicks();
+
+    if (now < window->nextPresent)
+    {
+        #if !defined(__EMSCRIPTEN__)
+            /* a swap that waits for the blank lands on the one after the deadline anyway, so only
+               presents that go out at once need the deadline hit exactly */
+            WaitUntil(window->nextPresent, window->swapInterval == NK_SWAP_INTERVAL_OFF);
+        #endif
+
+        now = window->nextPresent;
+    }
+
+    /* deadlines follow each other rather than when they were met, so the rate does not drift,
+       but a frame more than a period late starts the pace over instead of bunching up the next ones */
+    if (now - window->nextPresent < period)
+    {
+        window->nextPresent += period;
+    }
+    else
+    {
+        window->nextPresent = now + period;
+    }
+}
+
+double nkWindow_GetPaceDelay(nkWindow_t *window)
+{
+    if (window->maxFrameRate <= 0.0f)
+    {
+        return 0.0; /* uncapped */
+    }
+
+    uint64_t now = nkWindow_GetTicks();
+
+    return (now < window->nextPresent) ? (double)(window->nextPresent - now) / 1e9 : 0.0;
+}
+
+void nkWindow_ReleasePaceTimer(void)
+{
+    #if defined(_WIN32)
+        if (paceTimer != NULL)
+        {
+            CloseHandle(paceTimer);
+            paceTimer = NULL;
+        }
+    #endif
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+#if !defined(__EMSCRIPTEN__)
+static void WaitUntil(uint64_t deadline, bool spin)
+{
+    uint64_t margin = spin ? PACE_SPIN_MARGIN : 0;
+    uint64_t now = nkWindow_GetTicks();
+
+    #if defined(_WIN32)
+        if (paceTimer == NULL)
+        {
+            paceTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+            paceTimerCoarse = (paceTimer == NULL);
+
+            if (paceTimer == NULL)
+            {
+                paceTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+            }
+        }
+
+        if (paceTimerCoarse)
+        {
+            /* an ordinary timer can wake a whole tick late, so it only takes what is left beyond one */
+            margin = spin ? PACE_COARSE_MARGIN : 0;
+        }
+
+        if (paceTimer != NULL && deadline > now + margin)
+        {
+            /* relative, in 100 ns units */
+            LARGE_INTEGER dueTime;
+            dueTime.QuadPart = -(LONGLONG)((deadline - margin - now) / 100U);
+
+            if (SetWaitableTimer(paceTimer, &dueTime, 0, NULL, NULL, FALSE))
+            {
+                WaitForSingleObject(paceTimer, INFINITE);
+            }
+        }
+    #else
+        if (deadline > now + margin)
+        {
+            /* absolute on the clock nkWindow_GetTicks reads, so being interrupted costs nothing */
+            uint64_t wake = deadline - margin;
+            struct timespec wakeTime = { .tv_sec = (time_t)(wake / 1000000000ULL), .tv_nsec = (long)(wake % 1000000000ULL) };
+
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, NULL) == EINTR)
+            {
+                /* sleep the rest */
+            }
+        }
+    #endif
+
+    while (spin && nkWindow_GetTicks() < deadline)
+    {
+        SPIN_PAUSE();
+    }
+}
+#endif
@@ -0,0 +1,158 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  postqueue.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - lock-free multiple producer,
+**                 single consumer queue of posted events
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define QUEUE_MASK          (NK_POST_QUEUE_CAPACITY - 1U)
+#define CACHE_LINE_SIZE     (64U)
+
+#if (NK_POST_QUEUE_CAPACITY & QUEUE_MASK) != 0
+    #error "NK_POST_QUEUE_CAPACITY must be a power of two"
+#endif
+
+/* producers claim a slot with a compare and swap, then publish it with a release store of its sequence */
+#if defined(_MSC_VER)
+    #define LOAD_ACQUIRE(ptr)               ((uint32_t)_InterlockedOr((volatile long *)(ptr), 0))
+    #define STORE_RELEASE(ptr, value)       ((void)_InterlockedExchange((volatile long *)(ptr), (long)(value)))
+    #define COMPARE_EXCHANGE(ptr, expected, desired) \
+        ((uint32_t)_InterlockedCompareExchange((volatile long *)(ptr), (long)(desired), (long)(expected)) == (expected))
+#elif defined(__GNUC__) || defined(__clang__)
+    #define LOAD_ACQUIRE(ptr)               __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define STORE_RELEASE(ptr, value)       __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define COMPARE_EXCHANGE(ptr, expected, desired) \
+        __atomic_compare_exchange_n((ptr), &(uint32_t){ (expected) }, (desired), false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+    #error "No atomics for this compiler, postqueue.c needs MSVC, GCC or Clang"
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* a slot is free for the producer claiming position p when its sequence is p,
+   and holds an event for the consumer at position p when its sequence is p + 1 */
+typedef struct
+{
+    uint32_t sequence;
+    nkEvent_t event;
+} nkPostSlot_t;
+
+struct nkPostQueue_t
+{
+    /* claimed by producers */
+    uint32_t head;
+    uint8_t producerPadding[CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+    /* written by the consumer */
+    uint32_t tail;
+    uint8_t consumerPadding[CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+    nkPostSlot_t slots[NK_POST_QUEUE_CAPACITY];
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkPostQueue_t *nkPostQueue_Create(void)
+{
+    nkPostQueue_t *queue = calloc(1, sizeof(nkPostQueue_t));
+
+    if (queue == NULL)
+    {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < NK_POST_QUEUE_CAPACITY; i++)
+    {
+        queue->slots[i].sequence = i;
+    }
+
+    return queue;
+}
+
+void nkPostQueue_Destroy(nkPostQueue_t *queue)
+{
+    free(queue);
+}
+
+bool nkPostQueue_Push(nkPostQueue_t *queue, const nkEvent_t *event)
+{
+    uint32_t position = LOAD_ACQUIRE(&queue->head);
+    nkPostSlot_t *slot;
+
+    for (;;)
+    {
+        slot = &queue->slots[position & QUEUE_MASK];
+
+        int32_t difference = (int32_t)(LOAD_ACQUIRE(&slot->sequence) - position);
+
+        if (difference == 0)
+        {
+            if (COMPARE_EXCHANGE(&queue->head, position, position + 1U))
+            {
+                break; /* the slot is ours */
+            }
+        }
+        else if (difference < 0)
+        {
+            return false; /* full, the consumer has not freed this slot yet */
+        }
+
+        /* another producer got there first */
+        position = LOAD_ACQUIRE(&queue->head);
+    }
+
+    slot->event = *event;
+
+    STORE_RELEASE(&slot->sequence, position + 1U);
+
+    return true;
+}
+
+bool nkPostQueue_Pop(nkPostQueue_t *queue, nkEvent_t *event)
+{
+    uint32_t position = queue->tail;
+    nkPostSlot_t *slot = &queue->slots[position & QUEUE_MASK];
+
+    if (LOAD_ACQUIRE(&slot->sequence) != position + 1U)
+    {
+        return false; /* empty, or the next producer has not finished writing */
+    }
+
+    *event = slot->event;
+
+    /* free the slot for the producer one lap ahead */
+    STORE_RELEASE(&slot->sequence, position + NK_POST_QUEUE_CAPACITY);
+
+    queue->tail = position + 1U;
+
+    return true;
+}
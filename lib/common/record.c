@@ -0,0 +1,556 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  record.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - compact input recording and
+**                 replay through the dispatcher
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* file layout: the magic and version, then one record per event.
+   A record is the event type byte, the microseconds since the previous record as a varint,
+   then its fields. Coordinates are 1/256 pixel fixed point, pointer positions stored as zigzag
+   varint deltas from the previous position. Sizes and scroll deltas are zigzag varints */
+#define RECORDING_MAGIC         "NKRC"
+#define RECORDING_VERSION       (1U)
+#define FIXED_POINT_SCALE       (256.0f)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+struct nkRecording_t
+{
+    FILE *file;
+    double lastTimestamp;
+    int32_t lastX;              /* fixed point, the deltas are taken against these */
+    int32_t lastY;
+};
+
+struct nkReplay_t
+{
+    uint8_t *data;
+    size_t size;
+    size_t offset;
+    double speed;
+    double nextTime;            /* when the next record is due, on the nkWindow_GetTime clock */
+    int32_t lastX;
+    int32_t lastY;
+    nkTimer_t timer;
+    nkWindow_t *window;
+};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void WriteVarint(FILE *file, uint64_t value);
+static void WriteSigned(FILE *file, int64_t value);
+static int32_t ToFixed(float value);
+static void WritePointer(nkRecording_t *recording, float x, float y);
+
+static bool ReadVarint(nkReplay_t *replay, uint64_t *value);
+static bool ReadSigned(nkReplay_t *replay, int64_t *value);
+static bool ReadPointer(nkReplay_t *replay, float *x, float *y);
+static bool ReadEvent(nkReplay_t *replay, nkEvent_t *event, double *delay);
+
+static bool ScheduleReplay(nkReplay_t *replay);
+static void ReplayStep(void *userData);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkWindow_StartRecording(nkWindow_t *window, const char *path)
+{
+    if (window == NULL || path == NULL)
+    {
+        return false; /* nothing to do */
+    }
+
+    nkWindow_StopRecording(window);
+
+    nkRecording_t *recording = calloc(1, sizeof(nkRecording_t));
+
+    if (recording == NULL)
+    {
+        return false;
+    }
+
+    recording->file = fopen(path, "wb");
+
+    if (recording->file == NULL)
+    {
+        fprintf(stderr, "Failed to open %s for recording!\n", path);
+        free(recording);
+        return false;
+    }
+
+    fwrite(RECORDING_MAGIC, 1, 4, recording->file);
+    fputc(RECORDING_VERSION, recording->file);
+
+    recording->lastTimestamp = nkWindow_GetTime();
+
+    window->recording = recording;
+
+    return true;
+}
+
+void nkWindow_StopRecording(nkWindow_t *window)
+{
+    if (window == NULL || window->recording == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    fclose(window->recording->file);
+    free(window->recording);
+
+    window->recording = NULL;
+}
+
+void nkRecording_Write(nkRecording_t *recording, const nkEvent_t *event)
+{
+    switch (event->type)
+    {
+        case NK_EVENT_POINTER_MOVE:
+        case NK_EVENT_POINTER_LEAVE:
+        case NK_EVENT_POINTER_ACTION_BEGIN:
+        case NK_EVENT_POINTER_ACTION_END:
+        case NK_EVENT_SCROLL:
+        case NK_EVENT_KEY_DOWN:
+        case NK_EVENT_KEY_UP:
+        case NK_EVENT_CODEPOINT_INPUT:
+        case NK_EVENT_RESIZE:
+        {
+            /* recorded */
+        } break;
+
+        default:
+        {
+            return; /* not input, or carries pointers that mean nothing later */
+        } break;
+    }
+
+    /* merged events keep the oldest timestamp, so time never runs backwards by more than that */
+    double elapsed = event->timestamp - recording->lastTimestamp;
+    uint64_t microseconds = (elapsed > 0.0) ? (uint64_t)(elapsed * 1e6 + 0.5) : 0U;
+
+    recording->lastTimestamp += (double)microseconds / 1e6;
+
+    fputc((int)event->type, recording->file);
+    WriteVarint(recording->file, microseconds);
+
+    switch (event->type)
+    {
+        case NK_EVENT_POINTER_MOVE:
+        {
+            WritePointer(recording, event->pointer.x, event->pointer.y);
+        } break;
+
+        case NK_EVENT_POINTER_ACTION_BEGIN:
+        case NK_EVENT_POINTER_ACTION_END:
+        {
+            WriteVarint(recording->file, (uint64_t)event->pointerAction.action);
+            WritePointer(recording, event->pointerAction.x, event->pointerAction.y);
+        } break;
+
+        case NK_EVENT_SCROLL:
+        {
+            WriteSigned(recording->file, ToFixed(event->scroll.deltaX));
+            WriteSigned(recording->file, ToFixed(event->scroll.deltaY));
+        } break;
+
+        case NK_EVENT_KEY_DOWN:
+        case NK_EVENT_KEY_UP:
+        {
+            WriteVarint(recording->file, event->key.keycode);
+        } break;
+
+        case NK_EVENT_CODEPOINT_INPUT:
+        {
+            WriteVarint(recording->file, event->codepoint.codepoint);
+        } break;
+
+        case NK_EVENT_RESIZE:
+        {
+            WriteSigned(recording->file, ToFixed(event->resize.width));
+            WriteSigned(recording->file, ToFixed(event->resize.height));
+        } break;
+
+        default:
+        {
+            /* no fields */
+        } break;
+    }
+}
+
+bool nkWindow_Replay(nkWindow_t *window, const char *path, double speed)
+{
+    if (window == NULL || path == NULL)
+    {
+        return false; /* nothing to do */
+    }
+
+    nkWindow_StopReplay(window);
+
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Failed to open recording %s!\n", path);
+        return false;
+    }
+
+    /* recordings are small, a few bytes per event, so read it whole and keep file access out of the loop */
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    nkReplay_t *replay = calloc(1, sizeof(nkReplay_t));
+    uint8_t *data = (size > 0) ? malloc((size_t)size) : NULL;
+
+    if (replay == NULL || data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size)
+    {
+        fprintf(stderr, "Failed to read recording %s!\n", path);
+        fclose(file);
+        free(replay);
+        free(data);
+        return false;
+    }
+
+    fclose(file);
+
+    if (size < 5 || memcmp(data, RECORDING_MAGIC, 4) != 0 || data[4] != RECORDING_VERSION)
+    {
+        fprintf(stderr, "%s is not a recording this version can replay!\n", path);
+        free(replay);
+        free(data);
+        return false;
+    }
+
+    replay->data = data;
+    replay->size = (size_t)size;
+    replay->offset = 5;
+    replay->speed = speed;
+    replay->nextTime = nkWindow_GetTime();
+    replay->window = window;
+
+    window->replay = replay;
+
+    /* even when the first record is due, it waits for the loop to pump */
+    if (ScheduleReplay(replay))
+    {
+        replay->timer = nkWindow_AddTimer(0.0, false, ReplayStep, replay);
+    }
+
+    return true;
+}
+
+void nkWindow_StopReplay(nkWindow_t *window)
+{
+    if (window == NULL || window->replay == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkWindow_CancelTimer(window->replay->timer);
+
+    free(window->replay->data);
+    free(window->replay);
+
+    window->replay = NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void WriteVarint(FILE *file, uint64_t value)
+{
+    /* seven bits a byte, low first, the top bit set on all but the last */
+    while (value >= 0x80U)
+    {
+        fputc((int)((value & 0x7FU) | 0x80U), file);
+        value >>= 7;
+    }
+
+    fputc((int)value, file);
+}
+
+static void WriteSigned(FILE *file, int64_t value)
+{
+    /* zigzag, so small negative numbers stay small */
+    WriteVarint(file, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static int32_t ToFixed(float value)
+{
+    float scaled = value * FIXED_POINT_SCALE;
+
+    return (int32_t)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+static void WritePointer(nkRecording_t *recording, float x, float y)
+{
+    int32_t fixedX = ToFixed(x);
+    int32_t fixedY = ToFixed(y);
+
+    WriteSigned(recording->file, (int64_t)fixedX - recording->lastX);
+    WriteSigned(recording->file, (int64_t)fixedY - recording->lastY);
+
+    recording->lastX = fixedX;
+    recording->lastY = fixedY;
+}
+
+static bool ReadVarint(nkReplay_t *replay, uint64_t *value)
+{
+    *value = 0;
+
+    for (uint32_t shift = 0; shift < 64U; shift += 7U)
+    {
+        if (replay->offset >= replay->size)
+        {
+            return false; /* truncated */
+        }
+
+        uint8_t byte = replay->data[replay->offset++];
+
+        *value |= (uint64_t)(byte & 0x7FU) << shift;
+
+        if ((byte & 0x80U) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false; /* too long to be ours */
+}
+
+static bool ReadSigned(nkReplay_t *replay, int64_t *value)
+{
+    uint64_t encoded;
+
+    if (!ReadVarint(replay, &encoded))
+    {
+        return false;
+    }
+
+    *value = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1U);
+
+    return true;
+}
+
+static bool ReadPointer(nkReplay_t *replay, float *x, float *y)
+{
+    int64_t deltaX;
+    int64_t deltaY;
+
+    if (!ReadSigned(replay, &deltaX) || !ReadSigned(replay, &deltaY))
+    {
+        return false;
+    }
+
+    replay->lastX += (int32_t)deltaX;
+    replay->lastY += (int32_t)deltaY;
+
+    *x = (float)replay->lastX / FIXED_POINT_SCALE;
+    *y = (float)replay->lastY / FIXED_POINT_SCALE;
+
+    return true;
+}
+
+static bool ReadEvent(nkReplay_t *replay, nkEvent_t *event, double *delay)
+{
+    uint64_t microseconds;
+    uint64_t value;
+    int64_t first;
+    int64_t second;
+
+    if (replay->offset >= replay->size)
+    {
+        return false; /* the end */
+    }
+
+    *event = (nkEvent_t){ .type = (nkEventType_t)replay->data[replay->offset++] };
+
+    if (!ReadVarint(replay, &microseconds))
+    {
+        return false;
+    }
+
+    *delay = (double)microseconds / 1e6;
+
+    switch (event->type)
+    {
+        case NK_EVENT_POINTER_MOVE:
+        {
+            return ReadPointer(replay, &event->pointer.x, &event->pointer.y);
+        } break;
+
+        case NK_EVENT_POINTER_LEAVE:
+        {
+            return true;
+        } break;
+
+        case NK_EVENT_POINTER_ACTION_BEGIN:
+        case NK_EVENT_POINTER_ACTION_END:
+        {
+            if (!ReadVarint(replay, &value))
+            {
+                return false;
+            }
+
+            event->pointerAction.action = (nkPointerAction_t)value;
+
+            return ReadPointer(replay, &event->pointerAction.x, &event->pointerAction.y);
+        } break;
+
+        case NK_EVENT_SCROLL:
+        {
+            if (!ReadSigned(replay, &first) || !ReadSigned(replay, &second))
+            {
+                return false;
+            }
+
+            event->scroll.deltaX = (float)first / FIXED_POINT_SCALE;
+            event->scroll.deltaY = (float)second / FIXED_POINT_SCALE;
+        } break;
+
+        case NK_EVENT_KEY_DOWN:
+        case NK_EVENT_KEY_UP:
+        {
+            if (!ReadVarint(replay, &value))
+            {
+                return false;
+            }
+
+            event->key.keycode = (uint32_t)value;
+        } break;
+
+        case NK_EVENT_CODEPOINT_INPUT:
+        {
+            if (!ReadVarint(replay, &value))
+            {
+                return false;
+            }
+
+            event->codepoint.codepoint = (uint32_t)value;
+        } break;
+
+        case NK_EVENT_RESIZE:
+        {
+            if (!ReadSigned(replay, &first) || !ReadSigned(replay, &second))
+            {
+                return false;
+            }
+
+            event->resize.width = (float)first / FIXED_POINT_SCALE;
+            event->resize.height = (float)second / FIXED_POINT_SCALE;
+        } break;
+
+        default:
+        {
+            fprintf(stderr, "Unknown record type 0x%02X, stopping the replay!\n", (unsigned int)event->type);
+            return false;
+        } break;
+    }
+
+    return true;
+}
+
+static bool ScheduleReplay(nkReplay_t *replay)
+{
+    /* peek at the next record's delay, the record itself is read again when it is due */
+    size_t offset = replay->offset;
+    uint64_t microseconds = 0;
+
+    replay->offset++;
+    bool more = offset < replay->size && ReadVarint(replay, &microseconds);
+    replay->offset = offset;
+
+    if (!more)
+    {
+        nkWindow_StopReplay(replay->window);
+        return false;
+    }
+
+    /* with no speed, each event gets a pump and a frame of its own, as fast as the loop runs */
+    double delay = 0.0;
+
+    if (replay->speed > 0.0)
+    {
+        replay->nextTime += (double)microseconds / 1e6 / replay->speed;
+        delay = replay->nextTime - nkWindow_GetTime();
+
+        if (delay <= 0.0)
+        {
+            return true; /* already due, a replay that fell behind catches up without waiting for a pump */
+        }
+    }
+
+    replay->timer = nkWindow_AddTimer(delay, false, ReplayStep, replay);
+
+    return false;
+}
+
+static void ReplayStep(void *userData)
+{
+    nkReplay_t *replay = (nkReplay_t *)userData;
+    nkWindow_t *window = replay->window;
+
+    replay->timer = NK_TIMER_INVALID;
+
+    /* every record due by now, so the replay keeps to the recording's timing however often the loop pumps */
+    do
+    {
+        nkEvent_t event;
+        double delay;
+
+        if (!ReadEvent(replay, &event, &delay))
+        {
+            nkWindow_StopReplay(window);
+            return;
+        }
+
+        event.timestamp = nkWindow_GetTime();
+
+        if (event.type == NK_EVENT_RESIZE)
+        {
+            /* through the platform, so the real window matches what the views are laid out for */
+            nkWindow_SetSize(window, event.resize.width, event.resize.height);
+        }
+        else
+        {
+            /* merged with, and ordered after, any motion or scroll held back, as platform input is */
+            nkWindow_ApplyEvent(window, &event);
+        }
+
+        if (window->replay != replay)
+        {
+            return; /* stopped by a callback, or the window was destroyed */
+        }
+    }
+    while (ScheduleReplay(replay));
+}
@@ -0,0 +1,422 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  renderthread.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - per window render threads
+**                 drawing from snapshots of the view tree
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#if defined(_WIN32)
+    #define LOCK(thread)        EnterCriticalSection(&(thread)->lock)
+    #define UNLOCK(thread)      LeaveCriticalSection(&(thread)->lock)
+    #define WAIT(thread)        SleepConditionVariableCS(&(thread)->changed, &(thread)->lock, INFINITE)
+    #define BROADCAST(thread)   WakeAllConditionVariable(&(thread)->changed)
+#else
+    #define LOCK(thread)        pthread_mutex_lock(&(thread)->lock)
+    #define UNLOCK(thread)      pthread_mutex_unlock(&(thread)->lock)
+    #define WAIT(thread)        pthread_cond_wait(&(thread)->changed, &(thread)->lock)
+    #define BROADCAST(thread)   pthread_cond_broadcast(&(thread)->changed)
+#endif
+
+#define FRAME_COUNT         (2U)    /* frames in flight, one drawn while the next is laid out and waits */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    RENDER_STATE_STARTING,
+    RENDER_STATE_RUNNING,
+    RENDER_STATE_QUIT
+} nkRenderState_t;
+
+/* what one submitted frame draws, written by the UI thread and then only read by the render thread */
+typedef struct
+{
+    nkView_t *views;            /* the snapshot of the view tree, parents first */
+    uint32_t viewCount;
+    uint32_t viewCapacity;
+    nkView_t *rootView;         /* views[0], or NULL for no tree */
+    nkWindowDamage_t damage;
+
+    float width;
+    float height;
+    nkColor_t backgroundColor;
+    const nkWindowDelegate_t *delegate;
+    void *userData;
+    float maxFrameRate;
+    nkSwapInterval_t swapInterval;
+    bool swapIntervalChanged;
+    nkFrameTiming_t frameTiming;
+} nkRenderFrame_t;
+
+struct nkRenderThread_t
+{
+    nkWindow_t *window;         /* the window on the UI thread */
+    nkWindow_t target;          /* the render thread's copy, which owns the context while the thread runs */
+
+    /* frame n goes in frames[n % FRAME_COUNT], which the UI thread only rewrites once frame n - FRAME_COUNT
+       is drawn. Both counts wrap and are guarded by the lock */
+    nkRenderFrame_t frames[FRAME_COUNT];
+    uint32_t submitted;
+    uint32_t completed;
+
+    bool bound;                 /* the context was made current on the render thread */
+    nkRenderState_t state;
+
+    #if defined(_WIN32)
+        HANDLE handle;
+        CRITICAL_SECTION lock;
+        CONDITION_VARIABLE changed;
+    #else
+        pthread_t handle;
+        pthread_mutex_t lock;
+        pthread_cond_t changed;
+    #endif
+};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+#if defined(_WIN32)
+    static DWORD WINAPI RenderThreadMain(LPVOID argument);
+#else
+    static void *RenderThreadMain(void *argument);
+#endif
+
+static void RenderLoop(nkRenderThread_t *thread);
+static void WaitForIdle(nkRenderThread_t *thread);
+static uint32_t CountViews(nkView_t *view);
+static nkView_t *CopyViews(nkRenderFrame_t *frame, nkView_t *view, nkView_t *parent);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkRenderThread_t *nkRenderThread_Create(nkWindow_t *window)
+{
+    nkRenderThread_t *thread = calloc(1, sizeof(nkRenderThread_t));
+
+    if (thread == NULL)
+    {
+        return NULL;
+    }
+
+    /* allocated here on the UI thread, so the render thread's copy counts into the window's own block */
+    if (nkWindow_GetMetrics(window) == NULL)
+    {
+        free(thread);
+        return NULL;
+    }
+
+    thread->window = window;
+    thread->target = *window;
+    thread->target.renderThread = thread;
+    thread->target.next = NULL;
+    thread->state = RENDER_STATE_STARTING;
+
+    #if defined(_WIN32)
+        InitializeCriticalSection(&thread->lock);
+        InitializeConditionVariable(&thread->changed);
+
+        thread->handle = CreateThread(NULL, 0, RenderThreadMain, thread, 0, NULL);
+        bool started = (thread->handle != NULL);
+    #else
+        pthread_mutex_init(&thread->lock, NULL);
+        pthread_cond_init(&thread->changed, NULL);
+
+        bool started = (pthread_create(&thread->handle, NULL, RenderThreadMain, thread) == 0);
+    #endif
+
+    if (started)
+    {
+        /* the context has to be current before anything is submitted */
+        LOCK(thread);
+
+        while (thread->state == RENDER_STATE_STARTING)
+        {
+            WAIT(thread);
+        }
+
+        UNLOCK(thread);
+
+        if (thread->bound)
+        {
+            return thread;
+        }
+
+        nkRenderThread_Destroy(thread);
+        return NULL;
+    }
+
+    #if defined(_WIN32)
+        DeleteCriticalSection(&thread->lock);
+    #else
+        pthread_cond_destroy(&thread->changed);
+        pthread_mutex_destroy(&thread->lock);
+    #endif
+
+    free(thread);
+
+    return NULL;
+}
+
+void nkRenderThread_Destroy(nkRenderThread_t *thread)
+{
+    if (thread == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    nkRenderThread_Finish(thread);
+
+    LOCK(thread);
+    thread->state = RENDER_STATE_QUIT;
+    BROADCAST(thread);
+    UNLOCK(thread);
+
+    /* the thread releases the context and hands the target back to the window as it leaves */
+    #if defined(_WIN32)
+        WaitForSingleObject(thread->handle, INFINITE);
+        CloseHandle(thread->handle);
+        DeleteCriticalSection(&thread->lock);
+    #else
+        pthread_join(thread->handle, NULL);
+        pthread_cond_destroy(&thread->changed);
+        pthread_mutex_destroy(&thread->lock);
+    #endif
+
+    for (uint32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        free(thread->frames[i].views);
+    }
+
+    free(thread);
+}
+
+bool nkRenderThread_Submit(nkRenderThread_t *thread, const nkWindowDamage_t *damage)
+{
+    nkWindow_t *window = thread->window;
+
+    /* the UI thread runs a frame ahead of the one being drawn, and only waits when it gets two ahead */
+    LOCK(thread);
+
+    while (thread->submitted - thread->completed == FRAME_COUNT)
+    {
+        WAIT(thread);
+    }
+
+    nkRenderFrame_t *frame = &thread->frames[thread->submitted % FRAME_COUNT];
+
+    UNLOCK(thread);
+
+    frame->rootView = NULL;
+
+    if (window->rootView != NULL)
+    {
+        uint32_t count = CountViews(window->rootView);
+
+        if (count > frame->viewCapacity)
+        {
+            nkView_t *views = realloc(frame->views, (size_t)count * sizeof(nkView_t));
+
+            if (views == NULL)
+            {
+                return false; /* nothing was submitted, the frame is the caller's to retry */
+            }
+
+            frame->views = views;
+            frame->viewCapacity = count;
+        }
+
+        frame->viewCount = 0;
+        frame->rootView = CopyViews(frame, window->rootView, NULL);
+    }
+
+    /* what the frame draws is the window as it is now, everything else stays with the render thread */
+    frame->damage = *damage;
+    frame->width = window->width;
+    frame->height = window->height;
+    frame->backgroundColor = window->backgroundColor;
+    frame->delegate = window->delegate;
+    frame->userData = window->userData;
+
+    /* presentation settings are applied by the thread that presents */
+    frame->maxFrameRate = window->maxFrameRate;
+    frame->swapInterval = window->swapInterval;
+    frame->swapIntervalChanged = window->swapIntervalChanged;
+    window->swapIntervalChanged = false;
+
+    /* the frame's layout time and input go with it, the window starts timing the next one */
+    frame->frameTiming = window->frameTiming;
+    window->frameTiming = (nkFrameTiming_t){ 0 };
+
+    LOCK(thread);
+    thread->submitted++;
+    BROADCAST(thread);
+    UNLOCK(thread);
+
+    return true;
+}
+
+nkWindow_t *nkRenderThread_Finish(nkRenderThread_t *thread)
+{
+    /* the frames were timed and counted straight into the metrics the window shares with the copy */
+    WaitForIdle(thread);
+
+    return &thread->target;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+#if defined(_WIN32)
+static DWORD WINAPI RenderThreadMain(LPVOID argument)
+{
+    RenderLoop(argument);
+    return 0;
+}
+#else
+static void *RenderThreadMain(void *argument)
+{
+    RenderLoop(argument);
+    return NULL;
+}
+#endif
+
+static void RenderLoop(nkRenderThread_t *thread)
+{
+    bool bound = nkWindow_BindRenderThread(&thread->target);
+
+    LOCK(thread);
+
+    thread->bound = bound;
+    thread->state = bound ? RENDER_STATE_RUNNING : RENDER_STATE_QUIT;
+    BROADCAST(thread);
+
+    while (thread->state != RENDER_STATE_QUIT)
+    {
+        if (thread->completed == thread->submitted)
+        {
+            WAIT(thread);
+            continue;
+        }
+
+        /* frames are drawn in the order submitted, this one is left alone by the UI thread until it is done */
+        nkRenderFrame_t *frame = &thread->frames[thread->completed % FRAME_COUNT];
+
+        UNLOCK(thread);
+
+        nkWindow_t *target = &thread->target;
+
+        target->rootView = frame->rootView;
+        target->width = frame->width;
+        target->height = frame->height;
+        target->backgroundColor = frame->backgroundColor;
+        target->delegate = frame->delegate;
+        target->userData = frame->userData;
+        target->maxFrameRate = frame->maxFrameRate;
+        target->frameTiming = frame->frameTiming;
+
+        if (frame->swapIntervalChanged)
+        {
+            target->swapInterval = frame->swapInterval;
+            target->swapIntervalChanged = true;
+        }
+
+        uint64_t trace = NK_TRACE_BEGIN(NK_TRACE_LEVEL_INFO);
+
+        nkWindow_PresentFrame(target, &frame->damage);
+
+        NK_TRACE_END(NK_TRACE_LEVEL_INFO, "frame", "PresentFrame", trace);
+
+        LOCK(thread);
+
+        thread->completed++;
+        BROADCAST(thread);
+    }
+
+    UNLOCK(thread);
+
+    if (bound)
+    {
+        nkWindow_UnbindRenderThread(thread->window, &thread->target);
+    }
+
+    nkWindow_ReleasePaceTimer();
+}
+
+static void WaitForIdle(nkRenderThread_t *thread)
+{
+    LOCK(thread);
+
+    while (thread->completed != thread->submitted)
+    {
+        WAIT(thread);
+    }
+
+    UNLOCK(thread);
+}
+
+static uint32_t CountViews(nkView_t *view)
+{
+    uint32_t count = 1;
+
+    for (nkView_t *child = view->child; child != NULL; child = child->sibling)
+    {
+        count += CountViews(child);
+    }
+
+    return count;
+}
+
+static nkView_t *CopyViews(nkRenderFrame_t *frame, nkView_t *view, nkView_t *parent)
+{
+    /* the views are copied, not what they point to, and linked to each other in the same shape,
+       so nothing the render thread follows leads back into the UI thread's tree */
+    nkView_t *copy = &frame->views[frame->viewCount++];
+
+    *copy = *view;
+    copy->parent = parent;
+    copy->child = NULL;
+    copy->sibling = NULL;
+
+    nkView_t **link = &copy->child;
+
+    for (nkView_t *child = view->child; child != NULL; child = child->sibling)
+    {
+        *link = CopyViews(frame, child, copy);
+        link = &(*link)->sibling;
+    }
+
+    return copy;
+}
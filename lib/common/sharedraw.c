@@ -0,0 +1,195 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  sharedraw.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - draw resources shared by
+**                 the windows of a GL share group
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <nanodraw.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define VERTEX_ATTRIB_COUNT     (16U)   /* the least GL 3.3 and GLES 3.0 guarantee */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* one attribute of the draw context's vertex array, as the first context set it up */
+typedef struct
+{
+    GLint enabled;
+    GLint buffer;
+    GLint size;
+    GLint type;
+    GLint normalized;
+    GLint integer;
+    GLint stride;
+    GLint divisor;
+    void *pointer;
+} nkVertexAttrib_t;
+
+/* what the windows of a share group have in common. Programs, buffers and textures are shared objects,
+   so their names hold in every context. A vertex array is a container object that each context needs
+   its own of, so only its layout is kept, to be built again in each context */
+typedef struct
+{
+    nkDrawContext_t context;
+    nkVertexAttrib_t attribs[VERTEX_ATTRIB_COUNT];
+    GLint elementBuffer;
+    uint32_t referenceCount;
+} nkSharedDraw_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void ReadVertexLayout(GLuint vertexArray);
+static GLuint CreateVertexArray(void);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static nkSharedDraw_t sharedDraw;
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkSharedDraw_Acquire(nkDrawContext_t *context)
+{
+    if (sharedDraw.referenceCount == 0)
+    {
+        /* uploaded once into the share group, through the first window's context, which keeps the
+           vertex array it was created with */
+        nkDraw_CreateContext(&sharedDraw.context);
+        ReadVertexLayout(sharedDraw.context.vao);
+
+        sharedDraw.referenceCount = 1;
+
+        *context = sharedDraw.context;
+        return;
+    }
+
+    sharedDraw.referenceCount++;
+
+    /* the shared objects by name, then per window state of its own in the caller's context */
+    *context = sharedDraw.context;
+    context->vao = CreateVertexArray();
+    context->width = 0.0f;
+    context->height = 0.0f;
+}
+
+bool nkSharedDraw_Release(void)
+{
+    if (sharedDraw.referenceCount == 0)
+    {
+        return false; /* nothing to do */
+    }
+
+    sharedDraw.referenceCount--;
+
+    /* a window's vertex array goes with its context. The shared objects go with the last context in
+       the group, and the next acquire starts a new set */
+    return sharedDraw.referenceCount == 0;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void ReadVertexLayout(GLuint vertexArray)
+{
+    GLint previous = 0;
+
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previous);
+    glBindVertexArray(vertexArray);
+
+    for (GLuint i = 0; i < VERTEX_ATTRIB_COUNT; i++)
+    {
+        nkVertexAttrib_t *attrib = &sharedDraw.attribs[i];
+
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &attrib->enabled);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &attrib->buffer);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &attrib->size);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &attrib->type);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &attrib->normalized);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &attrib->integer);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &attrib->stride);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &attrib->divisor);
+        glGetVertexAttribPointerv(i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &attrib->pointer);
+    }
+
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &sharedDraw.elementBuffer);
+
+    glBindVertexArray((GLuint)previous);
+}
+
+static GLuint CreateVertexArray(void)
+{
+    GLuint vertexArray = 0;
+    GLint previous = 0;
+    GLint previousBuffer = 0;
+
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previous);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+
+    glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+
+    /* the buffers are shared, so the same bindings point at the same vertices */
+    for (GLuint i = 0; i < VERTEX_ATTRIB_COUNT; i++)
+    {
+        const nkVertexAttrib_t *attrib = &sharedDraw.attribs[i];
+
+        if (attrib->buffer == 0)
+        {
+            continue; /* never set up */
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, (GLuint)attrib->buffer);
+
+        if (attrib->integer)
+        {
+            glVertexAttribIPointer(i, attrib->size, (GLenum)attrib->type, attrib->stride, attrib->pointer);
+        }
+        else
+        {
+            glVertexAttribPointer(i, attrib->size, (GLenum)attrib->type, (GLboolean)attrib->normalized, attrib->stride, attrib->pointer);
+        }
+
+        glVertexAttribDivisor(i, (GLuint)attrib->divisor);
+
+        if (attrib->enabled)
+        {
+            glEnableVertexAttribArray(i);
+        }
+    }
+
+    /* part of the vertex array's state, unlike the array buffer binding */
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (GLuint)sharedDraw.elementBuffer);
+
+    glBindVertexArray((GLuint)previous);
+    glBindBuffer(GL_ARRAY_BUFFER, (GLuint)previousBuffer);
+
+    return vertexArray;
+}
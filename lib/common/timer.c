@@ -0,0 +1,320 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  timer.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - timers, kept in one min-heap
+**                 of deadlines and serviced by the event loop
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if __EMSCRIPTEN__
+    #include <emscripten/eventloop.h>
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    double deadline;            /* seconds on the nkWindow_GetTime clock */
+    double interval;            /* 0 for a one shot timer */
+    nkTimer_t id;
+    nkTimerCallback_t callback;
+    void *userData;
+} nkTimerEntry_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static nkTimerEntry_t *heap = NULL;     /* earliest deadline first */
+static uint32_t heapCount = 0;
+static uint32_t heapCapacity = 0;
+
+static nkTimer_t nextId = 1;
+static nkTimer_t firingId = NK_TIMER_INVALID;  /* the timer whose callback is running */
+static bool firingRepeats = false;
+static bool firingCancelled = false;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool Insert(const nkTimerEntry_t *entry);
+static void RemoveAt(uint32_t index);
+static void SiftUp(uint32_t index);
+static void SiftDown(uint32_t index);
+static void Swap(uint32_t a, uint32_t b);
+
+#if __EMSCRIPTEN__
+static void ArmBrowserTimeout(void);
+static void BrowserTimeoutCallback(void *userData);
+#endif
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkTimer_t nkWindow_AddTimer(double intervalSeconds, bool repeat, nkTimerCallback_t callback, void *userData)
+{
+    if (callback == NULL || intervalSeconds < 0.0 || (repeat && intervalSeconds <= 0.0))
+    {
+        return NK_TIMER_INVALID; /* a repeating timer needs a period */
+    }
+
+    nkTimerEntry_t entry = {
+        .deadline = nkWindow_GetTime() + intervalSeconds,
+        .interval = repeat ? intervalSeconds : 0.0,
+        .id = nextId,
+        .callback = callback,
+        .userData = userData
+    };
+
+    if (!Insert(&entry))
+    {
+        fprintf(stderr, "Failed to grow the timer heap!\n");
+        return NK_TIMER_INVALID;
+    }
+
+    nextId = (nextId == UINT32_MAX) ? 1U : nextId + 1U;
+
+    #if __EMSCRIPTEN__
+        ArmBrowserTimeout();
+    #endif
+
+    return entry.id;
+}
+
+bool nkWindow_CancelTimer(nkTimer_t timer)
+{
+    if (timer == NK_TIMER_INVALID)
+    {
+        return false; /* nothing to do */
+    }
+
+    if (timer == firingId)
+    {
+        /* out of the heap while its callback runs. This stops a repeating timer coming back, a one shot
+           timer has already fired */
+        bool stopped = firingRepeats && !firingCancelled;
+
+        firingCancelled = true;
+        return stopped;
+    }
+
+    /* a linear search, there are rarely more than a handful of timers */
+    for (uint32_t i = 0; i < heapCount; i++)
+    {
+        if (heap[i].id == timer)
+        {
+            RemoveAt(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void nkWindow_ServiceTimers(void)
+{
+    double now = nkWindow_GetTime();
+
+    /* a timer added or rescheduled by a callback is due after now, so this always ends */
+    while (heapCount > 0 && heap[0].deadline <= now)
+    {
+        nkTimerEntry_t entry = heap[0];
+
+        RemoveAt(0);
+
+        firingId = entry.id;
+        firingRepeats = (entry.interval > 0.0);
+        firingCancelled = false;
+
+        entry.callback(entry.userData);
+
+        firingId = NK_TIMER_INVALID;
+
+        if (entry.interval > 0.0 && !firingCancelled)
+        {
+            /* the next deadline follows the last one, not the late callback, so the period does not drift.
+               Periods missed while the loop was busy are dropped rather than fired back to back */
+            entry.deadline += entry.interval;
+
+            if (entry.deadline <= now)
+            {
+                entry.deadline += entry.interval * (double)(uint64_t)((now - entry.deadline) / entry.interval + 1.0);
+            }
+
+            Insert(&entry);
+        }
+    }
+
+    #if __EMSCRIPTEN__
+        ArmBrowserTimeout();
+    #endif
+}
+
+double nkWindow_GetTimerTimeout(double timeoutSeconds)
+{
+    if (heapCount == 0)
+    {
+        return timeoutSeconds; /* no timers */
+    }
+
+    double untilDeadline = heap[0].deadline - nkWindow_GetTime();
+
+    if (untilDeadline < 0.0)
+    {
+        untilDeadline = 0.0;
+    }
+
+    if (timeoutSeconds < 0.0 || untilDeadline < timeoutSeconds)
+    {
+        return untilDeadline;
+    }
+
+    return timeoutSeconds;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool Insert(const nkTimerEntry_t *entry)
+{
+    if (heapCount == heapCapacity)
+    {
+        uint32_t capacity = (heapCapacity == 0) ? 16U : heapCapacity * 2U;
+        nkTimerEntry_t *grown = realloc(heap, capacity * sizeof(nkTimerEntry_t));
+
+        if (grown == NULL)
+        {
+            return false;
+        }
+
+        heap = grown;
+        heapCapacity = capacity;
+    }
+
+    heap[heapCount] = *entry;
+    heapCount++;
+
+    SiftUp(heapCount - 1U);
+
+    return true;
+}
+
+static void RemoveAt(uint32_t index)
+{
+    heapCount--;
+
+    if (index == heapCount)
+    {
+        return; /* was the last */
+    }
+
+    /* the last entry fills the hole, then moves whichever way restores the order */
+    heap[index] = heap[heapCount];
+
+    SiftUp(index);
+    SiftDown(index);
+}
+
+static void SiftUp(uint32_t index)
+{
+    while (index > 0)
+    {
+        uint32_t parent = (index - 1U) / 2U;
+
+        if (heap[parent].deadline <= heap[index].deadline)
+        {
+            break;
+        }
+
+        Swap(parent, index);
+        index = parent;
+    }
+}
+
+static void SiftDown(uint32_t index)
+{
+    for (;;)
+    {
+        uint32_t smallest = index;
+        uint32_t left = index * 2U + 1U;
+        uint32_t right = left + 1U;
+
+        if (left < heapCount && heap[left].deadline < heap[smallest].deadline)
+        {
+            smallest = left;
+        }
+
+        if (right < heapCount && heap[right].deadline < heap[smallest].deadline)
+        {
+            smallest = right;
+        }
+
+        if (smallest == index)
+        {
+            break;
+        }
+
+        Swap(smallest, index);
+        index = smallest;
+    }
+}
+
+static void Swap(uint32_t a, uint32_t b)
+{
+    nkTimerEntry_t temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+}
+
+#if __EMSCRIPTEN__
+
+/* the browser owns the loop, so the earliest deadline is handed to it as a timeout */
+static void ArmBrowserTimeout(void)
+{
+    static long timeoutId = 0;
+    static double armedDeadline = 0.0;
+
+    if (heapCount == 0 || (timeoutId != 0 && armedDeadline <= heap[0].deadline))
+    {
+        return; /* nothing due, or the armed timeout comes first */
+    }
+
+    if (timeoutId != 0)
+    {
+        emscripten_clear_timeout(timeoutId);
+    }
+
+    armedDeadline = heap[0].deadline;
+    timeoutId = emscripten_set_timeout(BrowserTimeoutCallback, nkWindow_GetTimerTimeout(-1.0) * 1000.0, &timeoutId);
+}
+
+static void BrowserTimeoutCallback(void *userData)
+{
+    *(long *)userData = 0; /* fired */
+
+    nkWindow_ServiceTimers();
+}
+
+#endif
@@ -0,0 +1,285 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  trace.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - per thread trace rings,
+**                 exported as Chrome trace JSON
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define RING_MASK           (NK_TRACE_RING_CAPACITY - 1U)
+
+#if (NK_TRACE_RING_CAPACITY & RING_MASK) != 0
+    #error "NK_TRACE_RING_CAPACITY must be a power of two"
+#endif
+
+/* the owning thread publishes an event with a release store of head, the exporter reads head with an acquire load */
+#if defined(_MSC_VER)
+    #define THREAD_LOCAL                    __declspec(thread)
+    #define LOAD_ACQUIRE(ptr)               ((uint32_t)_InterlockedOr((volatile long *)(ptr), 0))
+    #define STORE_RELEASE(ptr, value)       ((void)_InterlockedExchange((volatile long *)(ptr), (long)(value)))
+    #define FETCH_ADD(ptr, value)           ((uint32_t)_InterlockedExchangeAdd((volatile long *)(ptr), (long)(value)))
+    #define LOAD_POINTER(ptr)               _InterlockedCompareExchangePointer((void *volatile *)(ptr), NULL, NULL)
+    #define SWAP_POINTER(ptr, expected, desired) \
+        (_InterlockedCompareExchangePointer((void *volatile *)(ptr), (desired), (expected)) == (expected))
+#elif defined(__GNUC__) || defined(__clang__)
+    #define THREAD_LOCAL                    _Thread_local
+    #define LOAD_ACQUIRE(ptr)               __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define STORE_RELEASE(ptr, value)       __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define FETCH_ADD(ptr, value)           __atomic_fetch_add((ptr), (value), __ATOMIC_RELAXED)
+    #define LOAD_POINTER(ptr)               __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define SWAP_POINTER(ptr, expected, desired) \
+        __atomic_compare_exchange_n((ptr), &(nkTraceRing_t *){ (expected) }, (desired), false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+#else
+    #error "No atomics for this compiler, trace.c needs MSVC, GCC or Clang"
+#endif
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    const char *category;
+    const char *name;
+    uint64_t begin;             /* ticks */
+    uint64_t duration;          /* ticks, spans only */
+    bool span;                  /* otherwise an instant */
+} nkTraceEvent_t;
+
+/* written by its thread only. Rings are never freed, so the exporter can walk them while threads come and go */
+typedef struct nkTraceRing_t
+{
+    struct nkTraceRing_t *next;
+    uint32_t threadId;
+    uint32_t head;              /* events written, wrapping */
+    bool full;                  /* head has passed NK_TRACE_RING_CAPACITY, so every slot holds an event */
+    nkTraceEvent_t events[NK_TRACE_RING_CAPACITY];
+} nkTraceRing_t;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static uint32_t traceLevel = NK_TRACE_LEVEL_OFF;
+
+/* every thread's ring, newest first, pushed without locks */
+static nkTraceRing_t *rings = NULL;
+static uint32_t nextThreadId = 1;
+
+static THREAD_LOCAL nkTraceRing_t *threadRing = NULL;
+static THREAD_LOCAL bool threadRingFailed = false;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static nkTraceRing_t *GetThreadRing(void);
+static void WriteEvent(const char *category, const char *name, uint64_t begin, uint64_t duration, bool span);
+static void WriteString(FILE *file, const char *string);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void nkWindow_SetTraceLevel(int level)
+{
+    STORE_RELEASE(&traceLevel, (level > 0) ? (uint32_t)level : 0U);
+}
+
+void nkWindow_TraceInstant(int level, const char *category, const char *name)
+{
+    if ((uint32_t)level > LOAD_ACQUIRE(&traceLevel))
+    {
+        return; /* not traced */
+    }
+
+    WriteEvent(category, name, nkWindow_GetTicks(), 0, false);
+}
+
+uint64_t nkWindow_TraceBegin(int level)
+{
+    if ((uint32_t)level > LOAD_ACQUIRE(&traceLevel))
+    {
+        return 0; /* not traced, so neither is the end */
+    }
+
+    return nkWindow_GetTicks();
+}
+
+void nkWindow_TraceEnd(const char *category, const char *name, uint64_t begin)
+{
+    uint64_t now = nkWindow_GetTicks();
+
+    WriteEvent(category, name, begin, (now > begin) ? now - begin : 0, true);
+}
+
+bool nkWindow_ExportTrace(const char *path)
+{
+    FILE *file = fopen(path, "w");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    bool first = true;
+
+    for (nkTraceRing_t *ring = LOAD_POINTER(&rings); ring != NULL; ring = ring->next)
+    {
+        uint32_t head = LOAD_ACQUIRE(&ring->head);
+        uint32_t count = ring->full ? NK_TRACE_RING_CAPACITY : head;
+
+        for (uint32_t i = head - count; i != head; i++)
+        {
+            nkTraceEvent_t event = ring->events[i & RING_MASK];
+
+            /* the thread may have come round and be writing over the slot while it was copied */
+            if (LOAD_ACQUIRE(&ring->head) - i >= NK_TRACE_RING_CAPACITY)
+            {
+                continue;
+            }
+
+            fprintf(file, first ? "\n" : ",\n");
+            first = false;
+
+            fprintf(file, "{\"name\":");
+            WriteString(file, event.name);
+            fprintf(file, ",\"cat\":");
+            WriteString(file, event.category);
+
+            /* microseconds, ticks are nanoseconds */
+            if (event.span)
+            {
+                fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", (double)event.begin / 1000.0, (double)event.duration / 1000.0);
+            }
+            else
+            {
+                fprintf(file, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f", (double)event.begin / 1000.0);
+            }
+
+            fprintf(file, ",\"pid\":1,\"tid\":%u}", ring->threadId);
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    bool written = (ferror(file) == 0);
+
+    if (fclose(file) != 0)
+    {
+        written = false;
+    }
+
+    return written;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static nkTraceRing_t *GetThreadRing(void)
+{
+    if (threadRing != NULL || threadRingFailed)
+    {
+        return threadRing;
+    }
+
+    nkTraceRing_t *ring = calloc(1, sizeof(nkTraceRing_t));
+
+    if (ring == NULL)
+    {
+        threadRingFailed = true; /* this thread goes untraced rather than retrying every event */
+        return NULL;
+    }
+
+    ring->threadId = FETCH_ADD(&nextThreadId, 1U);
+
+    nkTraceRing_t *expected;
+
+    do
+    {
+        expected = LOAD_POINTER(&rings);
+        ring->next = expected;
+    } while (!SWAP_POINTER(&rings, expected, ring));
+
+    threadRing = ring;
+
+    return ring;
+}
+
+static void WriteEvent(const char *category, const char *name, uint64_t begin, uint64_t duration, bool span)
+{
+    nkTraceRing_t *ring = GetThreadRing();
+
+    if (ring == NULL)
+    {
+        return;
+    }
+
+    uint32_t head = ring->head;
+    nkTraceEvent_t *event = &ring->events[head & RING_MASK];
+
+    event->category = category;
+    event->name = name;
+    event->begin = begin;
+    event->duration = duration;
+    event->span = span;
+
+    if (head + 1U == NK_TRACE_RING_CAPACITY)
+    {
+        ring->full = true;
+    }
+
+    STORE_RELEASE(&ring->head, head + 1U);
+}
+
+static void WriteString(FILE *file, const char *string)
+{
+    fputc('"', file);
+
+    for (const char *c = (string != NULL) ? string : ""; *c != '\0'; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            fputc('\\', file);
+            fputc(*c, file);
+        }
+        else if ((unsigned char)*c < 0x20U)
+        {
+            fprintf(file, "\\u%04x", (unsigned int)(unsigned char)*c);
+        }
+        else
+        {
+            fputc(*c, file);
+        }
+    }
+
+    fputc('"', file);
+}
@@ -0,0 +1,326 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  viewindex.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - uniform grid over the laid
+**                 out view frames, for pointer hit-testing
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define VIEWS_PER_CELL      (4U)    /* views a cell is sized to hold, before nesting adds the parents */
+#define GRID_SIZE_MAX       (128U)  /* cells across and down, at most */
+#define NO_PARENT           (UINT32_MAX)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+struct nkViewIndex_t
+{
+    nkView_t *root;             /* the tree this was built for, NULL if nothing is indexed */
+    float width;
+    float height;
+    float cellWidth;
+    float cellHeight;
+    uint32_t columns;
+    uint32_t rows;
+
+    nkView_t **views;           /* the tree flattened parents first, each followed by its subtree */
+    uint32_t *parents;          /* each view's parent by position, NO_PARENT for the root */
+    uint32_t *subtreeEnd;       /* one past the last view in each view's subtree */
+    uint32_t viewCount;
+    uint32_t viewCapacity;
+    uint32_t parentCapacity;
+    uint32_t subtreeCapacity;
+
+    uint32_t *cellStart;        /* cell c holds entries cellStart[c] up to cellStart[c + 1] */
+    uint32_t cellCapacity;
+
+    uint32_t *entries;          /* the views overlapping each cell, by position in views, in tree order */
+    uint32_t entryCapacity;
+};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool FlattenTree(nkViewIndex_t *index, nkView_t *view, uint32_t parent);
+static bool GetCellRange(nkViewIndex_t *index, nkRect_t frame, uint32_t *left, uint32_t *top, uint32_t *right, uint32_t *bottom);
+static bool Reserve(void **array, uint32_t *capacity, uint32_t count, size_t size);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+nkViewIndex_t *nkViewIndex_Create(void)
+{
+    return calloc(1, sizeof(nkViewIndex_t));
+}
+
+void nkViewIndex_Destroy(nkViewIndex_t *index)
+{
+    if (index == NULL)
+    {
+        return; /* nothing to do */
+    }
+
+    free(index->views);
+    free(index->parents);
+    free(index->subtreeEnd);
+    free(index->cellStart);
+    free(index->entries);
+    free(index);
+}
+
+bool nkViewIndex_Build(nkViewIndex_t *index, nkView_t *root, float width, float height)
+{
+    index->root = NULL;
+    index->viewCount = 0;
+
+    if (root == NULL || width <= 0.0f || height <= 0.0f || !FlattenTree(index, root, NO_PARENT))
+    {
+        return false;
+    }
+
+    /* square cells' worth of grid, enough that a cell holds a few views */
+    uint32_t size = 1;
+
+    while (size < GRID_SIZE_MAX && size * size * VIEWS_PER_CELL < index->viewCount)
+    {
+        size++;
+    }
+
+    index->width = width;
+    index->height = height;
+    index->columns = size;
+    index->rows = size;
+    index->cellWidth = width / (float)size;
+    index->cellHeight = height / (float)size;
+
+    uint32_t cellCount = size * size;
+
+    if (!Reserve((void **)&index->cellStart, &index->cellCapacity, cellCount + 1U, sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    /* counted into the next cell's slot, summed so each slot holds where the cell before it ends,
+       then filled back to front counting each slot down to where its cell begins */
+    for (uint32_t i = 0; i <= cellCount; i++)
+    {
+        index->cellStart[i] = 0;
+    }
+
+    uint32_t left, top, right, bottom;
+
+    for (uint32_t i = 0; i < index->viewCount; i++)
+    {
+        if (!GetCellRange(index, index->views[i]->frame, &left, &top, &right, &bottom))
+        {
+            continue;
+        }
+
+        for (uint32_t row = top; row <= bottom; row++)
+        {
+            for (uint32_t column = left; column <= right; column++)
+            {
+                index->cellStart[row * size + column + 1U]++;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < cellCount; i++)
+    {
+        index->cellStart[i + 1U] += index->cellStart[i];
+    }
+
+    uint32_t entryCount = index->cellStart[cellCount];
+
+    if (!Reserve((void **)&index->entries, &index->entryCapacity, entryCount, sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = index->viewCount; i-- > 0;)
+    {
+        if (!GetCellRange(index, index->views[i]->frame, &left, &top, &right, &bottom))
+        {
+            continue;
+        }
+
+        for (uint32_t row = top; row <= bottom; row++)
+        {
+            for (uint32_t column = left; column <= right; column++)
+            {
+                index->entries[--index->cellStart[row * size + column + 1U]] = i;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < cellCount; i++)
+    {
+        index->cellStart[i] = index->cellStart[i + 1U];
+    }
+
+    index->cellStart[cellCount] = entryCount;
+
+    index->root = root;
+
+    return true;
+}
+
+nkView_t *nkViewIndex_Find(nkViewIndex_t *index, nkView_t *root, float x, float y)
+{
+    if (index == NULL || index->root == NULL || index->root != root)
+    {
+        return NULL; /* not built for this tree */
+    }
+
+    if (x < 0.0f || y < 0.0f || x >= index->width || y >= index->height)
+    {
+        return NULL; /* off the grid */
+    }
+
+    uint32_t column = (uint32_t)(x / index->cellWidth);
+    uint32_t row = (uint32_t)(y / index->cellHeight);
+
+    column = (column < index->columns) ? column : index->columns - 1U;
+    row = (row < index->rows) ? row : index->rows - 1U;
+
+    uint32_t cell = row * index->columns + column;
+
+    /* descend as a walk of the tree would, into the first child of the view found so far that contains
+       the point. Its children follow it in tree order, so the rest of the cell is never looked at */
+    uint32_t found = NO_PARENT;
+    uint32_t end = index->viewCount;
+
+    for (uint32_t i = index->cellStart[cell]; i < index->cellStart[cell + 1U]; i++)
+    {
+        uint32_t entry = index->entries[i];
+
+        if (entry >= end)
+        {
+            break; /* past the subtree of the view found so far */
+        }
+
+        if (index->parents[entry] != found)
+        {
+            continue; /* deeper than a child, or under a sibling that missed */
+        }
+
+        nkRect_t frame = index->views[entry]->frame;
+
+        if (x >= frame.x && x < frame.x + frame.width && y >= frame.y && y < frame.y + frame.height)
+        {
+            found = entry;
+            end = index->subtreeEnd[entry];
+        }
+    }
+
+    /* over no view at all, which the root alone can answer */
+    return (found != NO_PARENT) ? index->views[found] : root;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool FlattenTree(nkViewIndex_t *index, nkView_t *view, uint32_t parent)
+{
+    if (!Reserve((void **)&index->views, &index->viewCapacity, index->viewCount + 1U, sizeof(nkView_t *)) ||
+        !Reserve((void **)&index->parents, &index->parentCapacity, index->viewCount + 1U, sizeof(uint32_t)) ||
+        !Reserve((void **)&index->subtreeEnd, &index->subtreeCapacity, index->viewCount + 1U, sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    uint32_t position = index->viewCount++;
+
+    index->views[position] = view;
+    index->parents[position] = parent;
+
+    for (nkView_t *child = view->child; child != NULL; child = child->sibling)
+    {
+        if (!FlattenTree(index, child, position))
+        {
+            return false;
+        }
+    }
+
+    index->subtreeEnd[position] = index->viewCount;
+
+    return true;
+}
+
+static bool GetCellRange(nkViewIndex_t *index, nkRect_t frame, uint32_t *left, uint32_t *top, uint32_t *right, uint32_t *bottom)
+{
+    /* clipped to the window, a view wholly outside it can never be hit */
+    float x0 = (frame.x > 0.0f) ? frame.x : 0.0f;
+    float y0 = (frame.y > 0.0f) ? frame.y : 0.0f;
+    float x1 = (frame.x + frame.width < index->width) ? frame.x + frame.width : index->width;
+    float y1 = (frame.y + frame.height < index->height) ? frame.y + frame.height : index->height;
+
+    if (x1 <= x0 || y1 <= y0)
+    {
+        return false;
+    }
+
+    *left = (uint32_t)(x0 / index->cellWidth);
+    *top = (uint32_t)(y0 / index->cellHeight);
+    *right = (uint32_t)(x1 / index->cellWidth);
+    *bottom = (uint32_t)(y1 / index->cellHeight);
+
+    /* the far edge is exclusive, and float division may land a hair past the last cell */
+    *left = (*left < index->columns) ? *left : index->columns - 1U;
+    *top = (*top < index->rows) ? *top : index->rows - 1U;
+    *right = (*right < index->columns) ? *right : index->columns - 1U;
+    *bottom = (*bottom < index->rows) ? *bottom : index->rows - 1U;
+
+    return true;
+}
+
+static bool Reserve(void **array, uint32_t *capacity, uint32_t count, size_t size)
+{
+    if (count <= *capacity)
+    {
+        return true;
+    }
+
+    uint32_t grown = (*capacity > 0) ? *capacity : 64U;
+
+    while (grown < count)
+    {
+        grown *= 2U;
+    }
+
+    void *resized = realloc(*array, grown * size);
+
+    if (resized == NULL)
+    {
+        return false;
+    }
+
+    *array = resized;
+    *capacity = grown;
+
+    return true;
+}
@@ -0,0 +1,157 @@
+/***************************************************************
+**
+** NanoKit Library Source File
+**
+** File         :  wakeup.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - blocking waits on the
+**                 display connection that other threads or a
+**                 deadline can cut short, for the POSIX backends
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#if __linux__
+    #include <sys/timerfd.h>
+#endif
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/* a self pipe, readable while a wakeup is pending */
+static int wakeupFds[2] = { -1, -1 };
+static uint32_t wakeupPending = 0;
+
+/* a timerfd keeps the deadline to the nanosecond, a poll timeout only to the millisecond */
+static int timerFd = -1;
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool nkWakeup_Init(void)
+{
+    if (wakeupFds[0] >= 0)
+    {
+        return true; /* already set up */
+    }
+
+    if (pipe(wakeupFds) != 0)
+    {
+        fprintf(stderr, "Failed to create the wakeup pipe!\n");
+        return false;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        fcntl(wakeupFds[i], F_SETFL, fcntl(wakeupFds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(wakeupFds[i], F_SETFD, FD_CLOEXEC);
+    }
+
+    #if __linux__
+        timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    #endif
+
+    return true;
+}
+
+void nkWakeup_Signal(void)
+{
+    if (wakeupFds[1] < 0)
+    {
+        return; /* nobody can be waiting */
+    }
+
+    /* one byte per wait is enough, the rest would only fill the pipe */
+    if (__atomic_exchange_n(&wakeupPending, 1U, __ATOMIC_SEQ_CST) != 0)
+    {
+        return;
+    }
+
+    uint8_t byte = 1;
+
+    while (write(wakeupFds[1], &byte, 1) < 0 && errno == EINTR)
+    {
+        /* retry */
+    }
+}
+
+bool nkWakeup_Wait(int fd, double timeoutSeconds)
+{
+    int timeout = -1;
+
+    if (timeoutSeconds >= 0.0)
+    {
+        /* rounded up, waking early would only mean waiting again */
+        double milliseconds = timeoutSeconds * 1000.0;
+        timeout = (milliseconds >= (double)INT_MAX) ? INT_MAX : (int)milliseconds;
+        timeout += ((double)timeout < milliseconds) ? 1 : 0;
+    }
+
+    bool timerArmed = false;
+
+    #if __linux__
+        if (timerFd >= 0 && timeoutSeconds > 0.0)
+        {
+            struct itimerspec deadline = { 0 };
+            deadline.it_value.tv_sec = (time_t)timeoutSeconds;
+            deadline.it_value.tv_nsec = (long)((timeoutSeconds - (double)deadline.it_value.tv_sec) * 1e9);
+            deadline.it_value.tv_nsec += (deadline.it_value.tv_sec == 0 && deadline.it_value.tv_nsec == 0) ? 1 : 0;
+
+            timerArmed = timerfd_settime(timerFd, 0, &deadline, NULL) == 0;
+            timeout = timerArmed ? -1 : timeout;
+        }
+    #endif
+
+    struct pollfd descriptors[3] = {
+        { .fd = fd, .events = POLLIN },             /* a negative fd is ignored by poll */
+        { .fd = wakeupFds[0], .events = POLLIN },
+        { .fd = timerArmed ? timerFd : -1, .events = POLLIN }
+    };
+
+    while (poll(descriptors, 3, timeout) < 0 && errno == EINTR)
+    {
+        /* retry */
+    }
+
+    #if __linux__
+        if (timerArmed)
+        {
+            struct itimerspec disarm = { 0 };
+            timerfd_settime(timerFd, 0, &disarm, NULL);
+
+            uint64_t expirations;
+            (void)read(timerFd, &expirations, sizeof(expirations));
+        }
+    #endif
+
+    /* cleared before the caller looks for work, so a signal sent after this wakes the next wait */
+    __atomic_store_n(&wakeupPending, 0U, __ATOMIC_SEQ_CST);
+
+    uint8_t bytes[16];
+
+    while (wakeupFds[0] >= 0 && read(wakeupFds[0], bytes, sizeof(bytes)) > 0)
+    {
+        /* drain */
+    }
+
+    return fd >= 0 && (descriptors[0].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+}
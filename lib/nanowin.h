@@ -21,9 +21,40 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#if _WIN32
+#if NANOWIN_HEADLESS
+    #ifndef EGL_NO_X11
+    #define EGL_NO_X11
+    #endif
+
+    #include <extern/glad/glad.h>
+    #include <EGL/egl.h>
+
+#elif NANOWIN_WAYLAND
+    #ifndef EGL_NO_X11
+    #define EGL_NO_X11
+    #endif
+
+    #include <wayland-client.h>
+
+    #include <extern/glad/glad.h>
+    #include <EGL/egl.h>
+
+#elif NANOWIN_X11
+    #include <X11/Xlib.h>
+    #include <X11/Xutil.h>
+    #include <X11/extensions/XShm.h>
+
+    #include <extern/glad/glad.h>
+    #include <EGL/egl.h>
+
+#elif _WIN32
     #define WIN32_LEAN_AND_MEAN
 
+    /* CreateWaitableTimerExW is Vista and later, which older MinGW headers hide unless asked for */
+    #ifndef _WIN32_WINNT
+    #define _WIN32_WINNT 0x0600
+    #endif
+
     #ifndef UNICODE
     #define UNICODE
     #endif 
@@ -112,6 +143,44 @@ extern "C" {
 #define NK_KEYCODE_F23               (0x0057U)
 #define NK_KEYCODE_F24               (0x0058U)
 
+#define NK_EVENT_RING_CAPACITY      (1024U) /* events per window ring, a power of two */
+#define NK_POST_QUEUE_CAPACITY      (256U)  /* events posted to a window and not yet delivered, a power of two */
+#define NK_TIMER_INVALID            (0U)
+#define NK_FRAME_HISTORY_COUNT      (128U)  /* frames kept for nkWindow_GetFrameStats */
+#define NK_DAMAGE_RECT_COUNT        (4U)    /* damaged rectangles kept apart before they collapse into one */
+#define NK_LATENCY_BUCKET_COUNT     (64U)   /* input latency histogram buckets, the last collects anything slower */
+#define NK_LATENCY_BUCKET_WIDTH     (0.001) /* seconds of input latency per histogram bucket */
+
+#define NK_TRACE_RING_CAPACITY      (4096U) /* trace events kept per thread, the oldest are overwritten */
+
+/* trace levels, each including the ones before it */
+#define NK_TRACE_LEVEL_OFF          (0)
+#define NK_TRACE_LEVEL_ERROR        (1)
+#define NK_TRACE_LEVEL_WARNING      (2)
+#define NK_TRACE_LEVEL_INFO         (3)
+#define NK_TRACE_LEVEL_DEBUG        (4)
+
+/* the most detailed level compiled in, trace points above it cost nothing at all */
+#ifndef NANOWIN_TRACE_LEVEL
+    #define NANOWIN_TRACE_LEVEL     NK_TRACE_LEVEL_INFO
+#endif
+
+/* trace points, recorded if their level is compiled in and no more detailed than nkWindow_SetTraceLevel.
+   category and name must be string literals, only the pointers are kept. A span is the time from the
+   NK_TRACE_BEGIN to the NK_TRACE_END it hands its result to, on the same thread */
+#define NK_TRACE_INSTANT(level, category, name) \
+    do { if ((level) <= NANOWIN_TRACE_LEVEL) nkWindow_TraceInstant((level), (category), (name)); } while (0)
+
+#define NK_TRACE_BEGIN(level) \
+    (((level) <= NANOWIN_TRACE_LEVEL) ? nkWindow_TraceBegin(level) : 0U)
+
+#define NK_TRACE_END(level, category, name, begin) \
+    do { if ((level) <= NANOWIN_TRACE_LEVEL && (begin) != 0U) nkWindow_TraceEnd((category), (name), (begin)); } while (0)
+
+#if NANOWIN_WAYLAND
+    #define NK_WAYLAND_BUFFER_COUNT     (3U) /* one on screen, one queued, one to draw into */
+#endif
+
 #if _WIN32
     #define NK_CURSOR_ARROW_VALUE        ((uintptr_t)IDC_ARROW)
     #define NK_CURSOR_IBEAM_VALUE        ((uintptr_t)IDC_IBEAM)
@@ -169,7 +238,24 @@ typedef enum
     NK_WINDOW_FOCUS_UNFOCUSED        = 0x02
 } nkWindowFocus_t;
 
+typedef enum
+{
+    NK_SWAP_INTERVAL_OFF            = 0x00, /* present as soon as the frame is drawn, tearing if need be */
+    NK_SWAP_INTERVAL_ON             = 0x01, /* wait for the display's vertical blank */
+    NK_SWAP_INTERVAL_ADAPTIVE       = 0x02  /* wait for the blank unless the frame missed it, then tear rather than wait another */
+} nkSwapInterval_t;
+
 struct nkWindow_t; /* forward declaration */
+struct nkEventRing_t; /* forward declaration, see common/eventring.c */
+struct nkPostQueue_t; /* forward declaration, see common/postqueue.c */
+struct nkRecording_t; /* forward declaration, see common/record.c */
+struct nkReplay_t; /* forward declaration, see common/record.c */
+struct nkViewIndex_t; /* forward declaration, see common/viewindex.c */
+
+#if NANOWIN_WAYLAND
+    struct xdg_surface;     /* forward declaration, generated from xdg-shell.xml */
+    struct xdg_toplevel;    /* forward declaration, generated from xdg-shell.xml */
+#endif
 
 /* General Window Events */
 typedef void (*nkWindowResizeCallback_t)(struct nkWindow_t *window, float width, float height);
@@ -189,22 +275,144 @@ typedef void (*nkWindowKeyDownCallback_t)(struct nkWindow_t *window, uint32_t ke
 typedef void (*nkWindowKeyUpCallback_t)(struct nkWindow_t *window, uint32_t keycode);
 typedef void (*nkWindowCodepointInputCallback_t)(struct nkWindow_t *window, uint32_t codepoint);
 
-typedef struct nkWindow_t
-{
-    struct nkWindow_t *next;
-
-    const char *title;
-    float width;
-    float height;
-
-    nkColor_t backgroundColor;
+/* Timers */
+typedef uint32_t nkTimer_t;
+typedef void (*nkTimerCallback_t)(void *userData);
 
-    nkDrawContext_t drawContext;
+/* Posted Events */
+typedef void (*nkWindowUserEventCallback_t)(struct nkWindow_t *window, uint32_t code, void *data);
 
-    nkWindowVisibility_t visibility;
-    nkWindowFocus_t focus;
-    nkCursorType_t cursorType;
+/* Window Events (as translated from the platform by each backend) */
+typedef enum
+{
+    NK_EVENT_NONE                   = 0x00,
+    NK_EVENT_POINTER_MOVE           = 0x01,
+    NK_EVENT_POINTER_LEAVE          = 0x02,
+    NK_EVENT_POINTER_ACTION_BEGIN   = 0x03,
+    NK_EVENT_POINTER_ACTION_END     = 0x04,
+    NK_EVENT_SCROLL                 = 0x05,
+    NK_EVENT_KEY_DOWN               = 0x06,
+    NK_EVENT_KEY_UP                 = 0x07,
+    NK_EVENT_CODEPOINT_INPUT        = 0x08,
+    NK_EVENT_RESIZE                 = 0x09,
+    NK_EVENT_FOCUS_CHANGE           = 0x0A,
+    NK_EVENT_VISIBILITY_CHANGE      = 0x0B,
+    NK_EVENT_EXPOSE                 = 0x0C,
+    NK_EVENT_CLOSE                  = 0x0D,
+    NK_EVENT_USER                   = 0x0E
+} nkEventType_t;
+
+typedef struct
+{
+    nkEventType_t type;
+    double timestamp;   /* seconds on the nkWindow_GetTime clock, taken when the backend read the event */
+
+    union
+    {
+        struct { float x; float y; } pointer;
+        struct { nkPointerAction_t action; float x; float y; } pointerAction;
+        struct { float deltaX; float deltaY; } scroll;
+        struct { uint32_t keycode; } key;
+        struct { uint32_t codepoint; } codepoint;
+        struct { float width; float height; } resize;
+        nkWindowFocus_t focus;
+        nkWindowVisibility_t visibility;
+        struct { uint32_t code; void *data; } user;
+    };
+} nkEvent_t;
+
+/* counters accumulated over the lifetime of a window */
+typedef struct
+{
+    /* input ring, only counted while an input thread feeds the window */
+    uint64_t eventsQueued;          /* events drained from the ring */
+    uint32_t eventsDropped;         /* events lost because the ring was full */
+    uint32_t queueDepth;            /* events waiting at the start of the last drain */
+    uint32_t queueDepthMax;
+    double queueLatencyMax;         /* longest wait between an event's timestamp and its dispatch, in seconds */
+
+    /* consecutive motion and scroll merged into one dispatch per pump */
+    uint64_t pointerMovesMerged;    /* moves replaced by a newer one before dispatch */
+    uint64_t scrollsMerged;         /* scrolls summed into an earlier one */
+
+    /* frame scheduling */
+    uint64_t redrawRequests;        /* calls to nkWindow_RequestRedraw */
+    uint64_t redrawsAbsorbed;       /* requests already covered by a scheduled frame */
+    uint64_t framesRendered;
+    uint64_t partialFrames;         /* frames that rendered only the damaged part of the window */
+    uint64_t pixelsRendered;        /* area cleared and drawn, summed over every frame */
+
+    /* view layout, deferred until the tree is next hit-tested or drawn */
+    uint64_t layoutsPerformed;
+    uint64_t layoutsSkipped;        /* resizes that needed no layout of their own */
+
+    /* pointer moves by how their view was found */
+    uint64_t pointerHitTests;       /* the tree searched, through the view index or by walking it */
+    uint64_t pointerHotHits;        /* still inside the hot view since the last layout, no search */
+    uint64_t pointerCaptureHits;    /* moved while a view captures a drag, no search */
+
+    /* events from nkWindow_PostEvent */
+    uint64_t eventsPosted;          /* delivered to the window */
+} nkWindowStats_t;
+
+/* where a frame's time went, see nkWindow_GetFrameStats */
+typedef enum
+{
+    NK_FRAME_PHASE_DISPATCH         = 0x00, /* delivering events since the previous frame */
+    NK_FRAME_PHASE_LAYOUT           = 0x01, /* nkWindow_LayoutViews */
+    NK_FRAME_PHASE_VIEWS            = 0x02, /* nkWindow_RedrawViews */
+    NK_FRAME_PHASE_DRAW_CALLBACK    = 0x03, /* the window's drawCallback */
+    NK_FRAME_PHASE_PRESENT          = 0x04, /* swapping, or reading back and handing over the pixels */
+    NK_FRAME_PHASE_COUNT            = 0x05
+} nkFramePhase_t;
+
+typedef struct
+{
+    uint64_t start;                         /* nanoseconds on the nkWindow_GetTime clock */
+    uint64_t phases[NK_FRAME_PHASE_COUNT];  /* nanoseconds spent in each phase */
+    uint64_t total;                         /* sum of the phases */
+    double inputOldest;                     /* timestamps of the first and last input events the frame showed, */
+    double inputNewest;                     /* 0 if it showed none */
+} nkFrameTiming_t;
+
+typedef struct
+{
+    uint64_t p50;
+    uint64_t p95;
+    uint64_t p99;
+} nkFramePercentiles_t;
 
+typedef struct
+{
+    nkFrameTiming_t frames[NK_FRAME_HISTORY_COUNT];     /* oldest first */
+    uint32_t frameCount;
+    nkFramePercentiles_t phases[NK_FRAME_PHASE_COUNT];  /* nanoseconds, over the frames above */
+    nkFramePercentiles_t total;
+} nkFrameStats_t;
+
+/* how long after input reached the platform the frame showing it was presented, counted per frame
+   from the oldest input it showed. Bucket i holds latencies from i to i + 1 NK_LATENCY_BUCKET_WIDTH */
+typedef struct
+{
+    uint64_t buckets[NK_LATENCY_BUCKET_COUNT];
+    uint64_t count;
+    double sum;                             /* seconds */
+    double max;
+} nkLatencyHistogram_t;
+
+/* the part of a window that changed since its last frame, in window coordinates */
+typedef struct
+{
+    nkRect_t rects[NK_DAMAGE_RECT_COUNT];   /* disjoint, clipped to the window */
+    uint32_t count;
+    bool full;                              /* the whole window, rects are ignored */
+} nkWindowDamage_t;
+
+/* what a window calls back into, each callback may be NULL. Windows only point at their delegate and never
+   write through it, so one table (typically static const) serves any number of windows, with whatever is
+   particular to each window reached through its userData */
+typedef struct
+{
     nkWindowResizeCallback_t resizeCallback;
     nkWindowDrawCallback_t drawCallback;
     nkWindowCloseCallback_t closeCallback;
@@ -220,19 +428,111 @@ typedef struct nkWindow_t
     nkWindowKeyUpCallback_t keyUpCallback;
     nkWindowCodepointInputCallback_t codepointInputCallback;
 
+    nkWindowUserEventCallback_t userEventCallback;
+} nkWindowDelegate_t;
+
+typedef struct nkWindow_t
+{
+    /* read by every dispatch and every walk of the window list, so kept together at the front */
+    struct nkWindow_t *next;
+    #if NANOWIN_WAYLAND                 /* the handle platform events are matched to the window by */
+        struct wl_surface *surface;
+    #elif NANOWIN_X11
+        Window windowHandle;
+    #elif _WIN32
+        HWND windowHandle;
+    #endif
+    const nkWindowDelegate_t *delegate; /* see nkWindow_SetDelegate */
+    float width;
+    float height;
+    bool redrawRequested;               /* dirty since the last frame, see nkWindow_RequestRedraw */
+    bool layoutDirty;                   /* the tree changed since, see nkWindow_SetNeedsLayout */
+    nkView_t *rootView;                 /* root view of the window */
+    nkView_t *hotView;                  /* view under cursor */
+    nkView_t *activeView;               /* view capturing input */
+
+    void *userData;                     /* the application's, for its callbacks to find their state by */
+
+    const char *title;
+
+    nkColor_t backgroundColor;
+
+    nkDrawContext_t drawContext;
+
+    nkWindowVisibility_t visibility;
+    nkWindowFocus_t focus;
+    nkCursorType_t cursorType;
+
     /* view management */
-    nkView_t *rootView;     /* root view of the window */
-    nkView_t *hotView;      /* view under cursor */
-    nkView_t *activeView;   /* view capturing input */
     nkPointerAction_t activeAction;
     nkPoint_t activeOrigin; /* origin of the active pointer action in window coords */
-
-    #if _WIN32
-        HWND windowHandle;
+    uint64_t layoutGeneration; /* counts layouts, so what was found before one can tell it is stale */
+    uint64_t hotViewLayout; /* layoutGeneration when hotBounds was found */
+    nkRect_t hotBounds;     /* window space area over which a hit-test ends at hotView, empty if unknown */
+
+    /* input state as delivered by events, read by nkWindow_IsKeyDown and nkWindow_IsPointerActionDown */
+    uint32_t keyState[8];           /* one bit per nanowin keycode below 0x100 */
+    uint32_t pointerActionState;    /* one bit per nkPointerAction_t */
+
+    struct nkEventRing_t *inputRing;    /* fed by the input thread, NULL when events are dispatched as they are read */
+    nkEvent_t pendingInput;             /* motion or scroll held back for merging, NK_EVENT_NONE if empty */
+    struct nkPostQueue_t *postQueue;    /* events posted from any thread by nkWindow_PostEvent */
+    struct nkRecording_t *recording;    /* input being written out, see nkWindow_StartRecording */
+    struct nkReplay_t *replay;          /* input being played back, see nkWindow_Replay */
+    struct nkViewIndex_t *viewIndex;    /* view frames by position, rebuilt after each layout */
+    struct nkRenderThread_t *renderThread;  /* draws the window's frames, NULL when they are drawn on the UI thread */
+    bool destroyed;                     /* set by nkWindow_Destroy, so a pump stops at a window a callback destroyed */
+    nkWindowDamage_t damage;            /* what the next frame has to draw */
+    bool partialRedraw;                 /* the backend keeps the last frame, so only damage needs drawing */
+    nkSwapInterval_t swapInterval;      /* see nkWindow_SetSwapInterval */
+    bool swapIntervalChanged;           /* not yet applied, the backend does so as it presents the next frame */
+    float maxFrameRate;                 /* see nkWindow_SetMaxFrameRate, 0 when uncapped */
+    uint64_t nextPresent;               /* ticks the frame rate cap holds the next present back until */
+    nkSize_t layoutSize;                /* window size the views were last laid out for */
+
+    nkFrameTiming_t frameTiming;        /* the frame being timed */
+    struct nkWindowMetrics_t *metrics;  /* stats, frame history and input latency, allocated once first counted */
+
+    #if NANOWIN_HEADLESS
+        EGLSurface eglSurface;
+        EGLContext eglContext;
+        uint8_t *framebuffer;           /* RGBA8, top row first, width * height * 4 bytes */
+        uint32_t framebufferWidth;
+        uint32_t framebufferHeight;
+        bool framebufferStale;          /* GL contents not yet read back into framebuffer */
+    #elif NANOWIN_WAYLAND
+        struct xdg_surface *xdgSurface;
+        struct xdg_toplevel *xdgToplevel;
+        struct wl_callback *frameCallback;  /* set while the compositor has not asked for the next frame */
+        struct wl_output *output;           /* the output the surface last entered, NULL before it is shown */
+        struct wl_shm_pool *shmPool;
+        uint8_t *shmData;
+        size_t shmSize;
+        struct
+        {
+            struct wl_buffer *handle;
+            uint8_t *pixels;
+            bool busy;                      /* attached, not yet released by the compositor */
+        } buffers[NK_WAYLAND_BUFFER_COUNT];
+        uint32_t bufferWidth;
+        uint32_t bufferHeight;
+        float pendingWidth;                 /* from the last xdg_toplevel.configure */
+        float pendingHeight;
+        nkWindowVisibility_t pendingVisibility;
+        bool configured;
+        bool closeRequested;
+        EGLSurface eglSurface;
+        EGLContext eglContext;
+    #elif NANOWIN_X11
+        XIC inputContext;
+        EGLSurface eglSurface;          /* a pbuffer when the frames are presented from CPU memory */
+        EGLContext eglContext;
+        XImage *image;                  /* the frame in CPU memory, for software present only */
+        XShmSegmentInfo shmSegment;     /* where the image's pixels live when MIT-SHM is used */
+    #elif _WIN32
         HINSTANCE instanceHandle;
         HDC drawingContext;
         HGLRC glRenderContext;
-        PAINTSTRUCT paintStruct;
     #endif
 } nkWindow_t;
 
@@ -248,17 +548,123 @@ void nkWindow_SetFocus(nkWindow_t *window, nkWindowFocus_t focus);
 void nkWindow_SetCursor(nkWindow_t *window, nkCursorType_t cursorType);
 void nkWindow_Destroy(nkWindow_t *window);
 
+/* points the window at the callbacks it calls, NULL for none, and sets the userData they can find their state
+   by. The delegate is not copied, so it has to outlive the window or the next call. With render threads the
+   draw callback runs on the window's render thread, so the delegate must not be changed while frames are drawn */
+void nkWindow_SetDelegate(nkWindow_t *window, const nkWindowDelegate_t *delegate, void *userData);
+
 bool nkWindow_IsPointerActionDown(nkWindow_t *window, nkPointerAction_t action);
 bool nkWindow_IsKeyDown(nkWindow_t *window, uint32_t keycode);
 
+/* marks the window dirty, it is rendered once on the next frame however many times this is called */
 void nkWindow_RequestRedraw(nkWindow_t *window);
 
+/* as nkWindow_RequestRedraw, but only rect (window coordinates) needs drawing. The next frame draws
+   the view tree and the draw callback once, clipped to the box around the damage */
+void nkWindow_RequestRedrawRect(nkWindow_t *window, nkRect_t rect);
+
 void nkWindow_RedrawViews(nkWindow_t *window);
+
+/* lays out the view tree now, for the current window size */
 void nkWindow_LayoutViews(nkWindow_t *window);
 
+/* marks the view tree as changed, it is laid out once before it is next hit-tested or drawn */
+void nkWindow_SetNeedsLayout(nkWindow_t *window);
+
 /* polls for events, returning true if application should stay open */
 bool nkWindow_PollEvents(void);
 
+/* queues a NK_EVENT_USER for the window's userEventCallback and wakes the event loop. Safe to call from
+   any thread while the window exists, events are delivered on the UI thread in the order they were posted.
+   Returns false if NK_POST_QUEUE_CAPACITY events are already waiting */
+bool nkWindow_PostEvent(nkWindow_t *window, uint32_t code, void *data);
+
+/* as nkWindow_PollEvents, but first sleeps until there is input, a frame to draw or a timer due, or until
+   timeoutSeconds have passed. A negative timeout waits indefinitely */
+bool nkWindow_WaitEvents(double timeoutSeconds);
+
+/* moves reading of platform events onto a backend thread which feeds a ring per window,
+   drained by nkWindow_PollEvents. Call before the first nkWindow_Create.
+   Returns false if the backend has no input thread, in which case nothing changes. */
+bool nkWindow_EnableInputThread(void);
+
+/* gives each window created afterwards a render thread of its own, with the window's GL context current
+   there rather than on the UI thread, so windows draw in parallel. Layout stays on the UI thread, which
+   hands each frame a snapshot of the laid out views: copies of the views themselves, not of what they
+   point to. The draw callback then runs on the render thread and is passed the render thread's copy
+   of the window. Call before the first nkWindow_Create.
+   Returns false if the backend has no render threads, in which case nothing changes. */
+bool nkWindow_EnableRenderThreads(void);
+
+/* creates the GL context of each window created afterwards in one share group, so its windows upload
+   one set of draw resources (shaders, glyph atlases, buffers) instead of a set each. The set is created
+   with the first window and kept until the last one is destroyed. Call before the first nkWindow_Create.
+   Returns false if the backend cannot share contexts, in which case nothing changes. */
+bool nkWindow_EnableSharedContexts(void);
+
+/* calls callback from the event loop after intervalSeconds, then every intervalSeconds if repeat is set,
+   measured from the previous deadline so a repeating timer does not drift. UI thread only.
+   Returns NK_TIMER_INVALID if the timer could not be added */
+nkTimer_t nkWindow_AddTimer(double intervalSeconds, bool repeat, nkTimerCallback_t callback, void *userData);
+
+/* stops a timer, including from its own callback. Returns false if it had already fired or was cancelled */
+bool nkWindow_CancelTimer(nkTimer_t timer);
+
+/* writes every input event reaching the window's dispatcher (pointer, scroll, keys, codepoints and
+   resizes) to path, with their timing, until nkWindow_StopRecording or the window is destroyed */
+bool nkWindow_StartRecording(nkWindow_t *window, const char *path);
+void nkWindow_StopRecording(nkWindow_t *window);
+
+/* plays a recording back into the window's dispatcher from the event loop, speed times as fast as it
+   was recorded. A speed of 0 or less gives each event a pump of its own with no waiting in between */
+bool nkWindow_Replay(nkWindow_t *window, const char *path, double speed);
+void nkWindow_StopReplay(nkWindow_t *window);
+
+/* how the window's presents wait for the display, NK_SWAP_INTERVAL_ON until set. Applied from the next
+   frame. Where the backend has no adaptive sync it falls back to on, and where presents never wait for
+   the display (headless, software present on X11) this has no effect beyond how the frame rate cap waits */
+void nkWindow_SetSwapInterval(nkWindow_t *window, nkSwapInterval_t interval);
+
+/* caps the frames the window presents per second, 0 to uncap. With the swap interval off, each present
+   sleeps until just short of its deadline and spins the rest, so frames are paced to well under a millisecond */
+void nkWindow_SetMaxFrameRate(nkWindow_t *window, float framesPerSecond);
+
+/* the refresh rate in Hz of the display the window is on, 0 if it cannot be found */
+float nkWindow_GetRefreshRate(nkWindow_t *window);
+
+/* records trace points up to level from now on, NK_TRACE_LEVEL_OFF (the default) to record none. Each thread
+   writes its own ring of the last NK_TRACE_RING_CAPACITY events, without locks or I/O */
+void nkWindow_SetTraceLevel(int level);
+
+/* writes what every thread's ring holds to path as Chrome trace JSON, for chrome://tracing or Perfetto.
+   Threads may keep tracing meanwhile, events they overwrite during the export are left out */
+bool nkWindow_ExportTrace(const char *path);
+
+/* behind the NK_TRACE_ macros, which compile them out above NANOWIN_TRACE_LEVEL */
+void nkWindow_TraceInstant(int level, const char *category, const char *name);
+uint64_t nkWindow_TraceBegin(int level);
+void nkWindow_TraceEnd(const char *category, const char *name, uint64_t begin);
+
+/* seconds on a monotonic clock, the same clock that stamps nkEvent_t */
+double nkWindow_GetTime(void);
+
+void nkWindow_GetStats(nkWindow_t *window, nkWindowStats_t *stats);
+
+/* timings of the last NK_FRAME_HISTORY_COUNT frames by phase, with their percentiles */
+void nkWindow_GetFrameStats(nkWindow_t *window, nkFrameStats_t *stats);
+
+/* input to present latency over the window's lifetime */
+void nkWindow_GetInputLatency(nkWindow_t *window, nkLatencyHistogram_t *histogram);
+
+#if NANOWIN_HEADLESS
+/* feeds a synthetic event through the same dispatch path a platform event would take,
+   after nkWindow_EnableInputThread it may be called from one other thread per window */
+void nkWindow_InjectEvent(nkWindow_t *window, const nkEvent_t *event);
+
+/* returns the RGBA8 contents of the last presented frame, reading back from GL if needed */
+const uint8_t *nkWindow_GetFramebuffer(nkWindow_t *window, uint32_t *width, uint32_t *height);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,48 @@
+/***************************************************************
+**
+** NanoKit Test Header File
+**
+** File         :  nktest.h
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - checks shared by the
+**                 headless unit tests
+**
+***************************************************************/
+
+#ifndef NKTEST_H
+#define NKTEST_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/* a failed check is reported and counted, the test carries on so one run shows every failure */
+#define NK_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            nkTestFailures++; \
+        } \
+    } while (0)
+
+#define NK_TEST_RESULT()    ((nkTestFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE)
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static int nkTestFailures = 0;
+
+#endif /* NKTEST_H */
@@ -0,0 +1,223 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_coalesce.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - pointer motion and scroll
+**                 are merged into one dispatch per pump
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (32.0f)
+#define LOG_SIZE            (256U)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestMoves(nkWindow_t *window);
+static void TestScrolls(nkWindow_t *window);
+static void TestOrder(nkWindow_t *window);
+static void Inject(nkWindow_t *window, nkEvent_t event);
+static void ClearLog(void);
+static void Log(const char *format, ...);
+static void OnPointerMove(nkWindow_t *window, float x, float y);
+static void OnPointerActionBegin(nkWindow_t *window, nkPointerAction_t action, float x, float y);
+static void OnScroll(nkWindow_t *window, float deltaX, float deltaY);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/* the callbacks the window made, in order */
+static char callbackLog[LOG_SIZE];
+static size_t callbackLogLength = 0;
+
+static const nkWindowDelegate_t testDelegate =
+{
+    .pointerMoveCallback = OnPointerMove,
+    .pointerActionBeginCallback = OnPointerActionBegin,
+    .scrollCallback = OnScroll,
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+
+    if (!nkWindow_Create(&window, "test_coalesce", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    window.rootView = &rootView;
+    nkWindow_SetDelegate(&window, &testDelegate, NULL);
+    nkWindow_PollEvents();
+
+    TestMoves(&window);
+    TestScrolls(&window);
+    TestOrder(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestMoves(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    ClearLog();
+    nkWindow_GetStats(window, &before);
+
+    /* held back until the pump, each replacing the last but keeping the first one's time */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .timestamp = 1.0, .pointer = { 1.0f, 1.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .timestamp = 2.0, .pointer = { 2.0f, 1.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .timestamp = 3.0, .pointer = { 3.0f, 1.0f } });
+
+    NK_CHECK(callbackLogLength == 0);
+    NK_CHECK(window->pendingInput.type == NK_EVENT_POINTER_MOVE);
+    NK_CHECK(window->pendingInput.timestamp == 1.0);
+
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(strcmp(callbackLog, "M3 1 ") == 0);
+    NK_CHECK(after.pointerMovesMerged == before.pointerMovesMerged + 2U);
+    NK_CHECK(window->pendingInput.type == NK_EVENT_NONE);
+}
+
+static void TestScrolls(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    ClearLog();
+    nkWindow_GetStats(window, &before);
+
+    /* summed, so no distance is lost */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_SCROLL, .scroll = { 1.0f, 2.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_SCROLL, .scroll = { -3.0f, 2.0f } });
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(strcmp(callbackLog, "S-2 4 ") == 0);
+    NK_CHECK(after.scrollsMerged == before.scrollsMerged + 1U);
+}
+
+static void TestOrder(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    ClearLog();
+    nkWindow_GetStats(window, &before);
+
+    /* a scroll is not merged into a move, and a press is never merged, so each delivers what came before it */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .pointer = { 3.0f, 1.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_SCROLL, .scroll = { 0.0f, 2.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_ACTION_BEGIN, .pointerAction = { NK_POINTER_ACTION_PRIMARY, 3.0f, 1.0f } });
+
+    NK_CHECK(strcmp(callbackLog, "M3 1 S0 2 B3 1 ") == 0);
+
+    /* the moves after the press are merged among themselves */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .pointer = { 4.0f, 1.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .pointer = { 5.0f, 1.0f } });
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(strcmp(callbackLog, "M3 1 S0 2 B3 1 M5 1 ") == 0);
+    NK_CHECK(after.pointerMovesMerged == before.pointerMovesMerged + 1U);
+    NK_CHECK(after.scrollsMerged == before.scrollsMerged);
+}
+
+static void Inject(nkWindow_t *window, nkEvent_t event)
+{
+    nkWindow_InjectEvent(window, &event);
+}
+
+static void ClearLog(void)
+{
+    callbackLog[0] = '\0';
+    callbackLogLength = 0;
+}
+
+static void Log(const char *format, ...)
+{
+    if (callbackLogLength >= LOG_SIZE)
+    {
+        return;
+    }
+
+    va_list args;
+
+    va_start(args, format);
+    int written = vsnprintf(&callbackLog[callbackLogLength], LOG_SIZE - callbackLogLength, format, args);
+    va_end(args);
+
+    if (written > 0)
+    {
+        callbackLogLength += (size_t)written;
+    }
+}
+
+static void OnPointerMove(nkWindow_t *window, float x, float y)
+{
+    (void)window;
+
+    Log("M%.0f %.0f ", (double)x, (double)y);
+}
+
+static void OnPointerActionBegin(nkWindow_t *window, nkPointerAction_t action, float x, float y)
+{
+    (void)window;
+    (void)action;
+
+    Log("B%.0f %.0f ", (double)x, (double)y);
+}
+
+static void OnScroll(nkWindow_t *window, float deltaX, float deltaY)
+{
+    (void)window;
+
+    Log("S%.0f %.0f ", (double)deltaX, (double)deltaY);
+}
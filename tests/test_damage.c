@@ -0,0 +1,230 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_damage.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - damage rects are clipped,
+**                 merged and collapsed between frames
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (400.0f)
+#define WINDOW_HEIGHT       (100.0f)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestMerge(nkWindow_t *window);
+static void TestClip(nkWindow_t *window);
+static void TestCollapse(nkWindow_t *window);
+static void TestFull(nkWindow_t *window);
+static void TestOnePass(nkWindow_t *window);
+static void ClearDamage(nkWindow_t *window);
+static bool HasRect(const nkWindowDamage_t *damage, nkRect_t rect);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+
+    if (!nkWindow_Create(&window, "test_damage", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    rootView.frame = (nkRect_t){ 0.0f, 0.0f, WINDOW_WIDTH, WINDOW_HEIGHT };
+    window.rootView = &rootView;
+
+    TestMerge(&window);
+    TestClip(&window);
+    TestCollapse(&window);
+    TestFull(&window);
+    TestOnePass(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestMerge(nkWindow_t *window)
+{
+    ClearDamage(window);
+
+    /* apart, so kept apart */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 10.0f, 20.0f, 20.0f });
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 100.0f, 10.0f, 20.0f, 20.0f });
+
+    NK_CHECK(!window->damage.full);
+    NK_CHECK(window->damage.count == 2U);
+
+    /* sharing an edge counts as touching */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 30.0f, 10.0f, 10.0f, 20.0f });
+
+    NK_CHECK(window->damage.count == 2U);
+    NK_CHECK(HasRect(&window->damage, (nkRect_t){ 10.0f, 10.0f, 30.0f, 20.0f }));
+    NK_CHECK(HasRect(&window->damage, (nkRect_t){ 100.0f, 10.0f, 20.0f, 20.0f }));
+
+    /* one rect bridging both absorbs them, and the grown rect is merged again */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 35.0f, 20.0f, 70.0f, 5.0f });
+
+    NK_CHECK(window->damage.count == 1U);
+    NK_CHECK(HasRect(&window->damage, (nkRect_t){ 10.0f, 10.0f, 110.0f, 20.0f }));
+
+    /* a frame takes the damage, leaving none for the next */
+    nkWindow_PollEvents();
+
+    NK_CHECK(!window->damage.full);
+    NK_CHECK(window->damage.count == 0);
+}
+
+static void TestClip(nkWindow_t *window)
+{
+    ClearDamage(window);
+
+    /* wholly outside, nothing to draw */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ -50.0f, 10.0f, 40.0f, 10.0f });
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, WINDOW_HEIGHT, 10.0f, 10.0f });
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 10.0f, 0.0f, 10.0f });
+
+    NK_CHECK(window->damage.count == 0);
+
+    /* partly outside, cut to the window */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ -10.0f, -10.0f, 30.0f, 30.0f });
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ WINDOW_WIDTH - 10.0f, 50.0f, 30.0f, 80.0f });
+
+    NK_CHECK(window->damage.count == 2U);
+    NK_CHECK(HasRect(&window->damage, (nkRect_t){ 0.0f, 0.0f, 20.0f, 20.0f }));
+    NK_CHECK(HasRect(&window->damage, (nkRect_t){ WINDOW_WIDTH - 10.0f, 50.0f, 10.0f, WINDOW_HEIGHT - 50.0f }));
+}
+
+static void TestCollapse(nkWindow_t *window)
+{
+    ClearDamage(window);
+
+    for (uint32_t i = 0; i < NK_DAMAGE_RECT_COUNT; i++)
+    {
+        nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f + 40.0f * (float)i, 10.0f, 5.0f, 5.0f });
+    }
+
+    NK_CHECK(!window->damage.full);
+    NK_CHECK(window->damage.count == NK_DAMAGE_RECT_COUNT);
+
+    /* one more apart from the rest, and they are all drawn as their bounding box */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 300.0f, 60.0f, 10.0f, 10.0f });
+
+    NK_CHECK(!window->damage.full);
+    NK_CHECK(window->damage.count == 1U);
+    NK_CHECK(HasRect(&window->damage, (nkRect_t){ 10.0f, 10.0f, 300.0f, 60.0f }));
+}
+
+static void TestFull(nkWindow_t *window)
+{
+    ClearDamage(window);
+
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 10.0f, 20.0f, 20.0f });
+
+    /* grows to cover the window, so it becomes a full redraw */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ -5.0f, -5.0f, WINDOW_WIDTH + 10.0f, WINDOW_HEIGHT + 10.0f });
+
+    NK_CHECK(window->damage.full);
+    NK_CHECK(window->damage.count == 0);
+
+    /* nothing more to add once full */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 10.0f, 20.0f, 20.0f });
+
+    NK_CHECK(window->damage.full);
+    NK_CHECK(window->damage.count == 0);
+
+    nkWindow_PollEvents();
+
+    NK_CHECK(!window->damage.full);
+
+    /* a whole window request skips the rects */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 10.0f, 20.0f, 20.0f });
+    nkWindow_RequestRedraw(window);
+
+    NK_CHECK(window->damage.full);
+    NK_CHECK(window->damage.count == 0);
+}
+
+static void TestOnePass(nkWindow_t *window)
+{
+    ClearDamage(window);
+
+    if (!window->partialRedraw)
+    {
+        return; /* without a pbuffer every frame is a full one */
+    }
+
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* apart, but drawn in one pass over the box around both */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 10.0f, 20.0f, 20.0f });
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 100.0f, 50.0f, 20.0f, 20.0f });
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.partialFrames == before.partialFrames + 1U);
+    NK_CHECK(after.pixelsRendered == before.pixelsRendered + 110U * 60U);
+}
+
+static void ClearDamage(nkWindow_t *window)
+{
+    /* the frame that draws whatever is pending */
+    nkWindow_PollEvents();
+
+    NK_CHECK(!window->damage.full);
+    NK_CHECK(window->damage.count == 0);
+}
+
+static bool HasRect(const nkWindowDamage_t *damage, nkRect_t rect)
+{
+    for (uint32_t i = 0; i < damage->count; i++)
+    {
+        const nkRect_t *other = &damage->rects[i];
+
+        if (other->x == rect.x && other->y == rect.y && other->width == rect.width && other->height == rect.height)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,181 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_eventring.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - the input thread's event
+**                 ring keeps order, drops when full and hands over
+**                 between threads
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define THREAD_EVENT_COUNT  (100000U)   /* many times the capacity, so the ring wraps often */
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestEventRingOrder(void);
+static void TestEventRingFull(void);
+static void TestEventRingThreaded(void);
+static void *RingProducerMain(void *arg);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    TestEventRingOrder();
+    TestEventRingFull();
+    TestEventRingThreaded();
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestEventRingOrder(void)
+{
+    nkEventRing_t *ring = nkEventRing_Create();
+    nkEvent_t event;
+
+    NK_CHECK(ring != NULL);
+    NK_CHECK(!nkEventRing_Pop(ring, &event));
+
+    /* three laps in batches that do not divide the capacity, so head and tail wrap mid batch */
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    while (popped < NK_EVENT_RING_CAPACITY * 3U)
+    {
+        for (uint32_t i = 0; i < 100U; i++)
+        {
+            nkEvent_t in = { .type = NK_EVENT_KEY_DOWN, .key = { pushed++ } };
+
+            NK_CHECK(nkEventRing_Push(ring, &in));
+        }
+
+        NK_CHECK(nkEventRing_Count(ring) == 100U);
+
+        while (nkEventRing_Pop(ring, &event))
+        {
+            NK_CHECK(event.type == NK_EVENT_KEY_DOWN);
+            NK_CHECK(event.key.keycode == popped);
+            popped++;
+        }
+
+        NK_CHECK(nkEventRing_Count(ring) == 0);
+    }
+
+    NK_CHECK(nkEventRing_Dropped(ring) == 0);
+
+    nkEventRing_Destroy(ring);
+}
+
+static void TestEventRingFull(void)
+{
+    nkEventRing_t *ring = nkEventRing_Create();
+    nkEvent_t event = { .type = NK_EVENT_KEY_DOWN };
+
+    for (uint32_t i = 0; i < NK_EVENT_RING_CAPACITY; i++)
+    {
+        event.key.keycode = i;
+        NK_CHECK(nkEventRing_Push(ring, &event));
+    }
+
+    /* a full ring drops the newest event and counts it, the ones already queued are kept */
+    event.key.keycode = NK_EVENT_RING_CAPACITY;
+    NK_CHECK(!nkEventRing_Push(ring, &event));
+    NK_CHECK(!nkEventRing_Push(ring, &event));
+    NK_CHECK(nkEventRing_Dropped(ring) == 2U);
+    NK_CHECK(nkEventRing_Count(ring) == NK_EVENT_RING_CAPACITY);
+
+    NK_CHECK(nkEventRing_Pop(ring, &event));
+    NK_CHECK(event.key.keycode == 0);
+
+    /* one slot is free again */
+    event.key.keycode = NK_EVENT_RING_CAPACITY;
+    NK_CHECK(nkEventRing_Push(ring, &event));
+
+    for (uint32_t i = 1; i <= NK_EVENT_RING_CAPACITY; i++)
+    {
+        NK_CHECK(nkEventRing_Pop(ring, &event));
+        NK_CHECK(event.key.keycode == i);
+    }
+
+    NK_CHECK(!nkEventRing_Pop(ring, &event));
+
+    nkEventRing_Destroy(ring);
+}
+
+static void TestEventRingThreaded(void)
+{
+    nkEventRing_t *ring = nkEventRing_Create();
+    pthread_t thread;
+
+    NK_CHECK(pthread_create(&thread, NULL, RingProducerMain, ring) == 0);
+
+    /* the one producer and the one consumer, every event arrives once and in order */
+    uint32_t expected = 0;
+    nkEvent_t event;
+
+    while (expected < THREAD_EVENT_COUNT)
+    {
+        if (nkEventRing_Pop(ring, &event))
+        {
+            NK_CHECK(event.key.keycode == expected);
+            expected = event.key.keycode + 1U; /* resynchronise, so a failure is reported once */
+        }
+        else
+        {
+            sched_yield(); /* until the producer catches up */
+        }
+    }
+
+    pthread_join(thread, NULL);
+
+    NK_CHECK(!nkEventRing_Pop(ring, &event));
+
+    nkEventRing_Destroy(ring);
+}
+
+static void *RingProducerMain(void *arg)
+{
+    nkEventRing_t *ring = arg;
+
+    for (uint32_t i = 0; i < THREAD_EVENT_COUNT; i++)
+    {
+        nkEvent_t event = { .type = NK_EVENT_KEY_DOWN, .key = { i } };
+
+        /* the ring drops when full, retry so the consumer can check every event */
+        while (!nkEventRing_Push(ring, &event))
+        {
+            sched_yield(); /* until the consumer makes room */
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,186 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_framestats.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - frame history keeps the
+**                 last frames in order and ranks their phases
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (32.0f)
+#define SAMPLE_STEP         (1000U)     /* nanoseconds between the test frames' dispatch times */
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestEmpty(nkWindow_t *window);
+static void TestPercentiles(nkWindow_t *window);
+static void TestWrap(nkWindow_t *window);
+static void TestFewFrames(nkWindow_t *window);
+static void FinishFrames(nkWindow_t *window, uint32_t first, uint32_t count);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+
+    memset(&window, 0, sizeof(window));
+
+    if (!nkWindow_Create(&window, "test_framestats", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    /* never pumped, so the only frames are the ones finished here */
+    TestEmpty(&window);
+    TestPercentiles(&window);
+    TestWrap(&window);
+
+    nkWindow_Destroy(&window);
+
+    if (!nkWindow_Create(&window, "test_framestats", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    TestFewFrames(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestEmpty(nkWindow_t *window)
+{
+    static nkFrameStats_t stats;
+
+    memset(&stats, 0xFF, sizeof(stats));
+
+    /* nothing measured, and nothing allocated to measure it in */
+    nkWindow_GetFrameStats(window, &stats);
+
+    NK_CHECK(stats.frameCount == 0);
+    NK_CHECK(stats.total.p50 == 0 && stats.total.p99 == 0);
+    NK_CHECK(window->metrics == NULL);
+}
+
+static void TestPercentiles(nkWindow_t *window)
+{
+    static nkFrameStats_t stats;
+
+    /* 1 to 100 steps, finished out of order so the ranking has to sort them */
+    for (uint32_t i = 0; i < 100U; i++)
+    {
+        FinishFrames(window, (i * 37U) % 100U + 1U, 1U);
+    }
+
+    nkWindow_GetFrameStats(window, &stats);
+
+    NK_CHECK(stats.frameCount == 100U);
+
+    /* nearest rank, every percentile is one of the frames */
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p50 == 50U * SAMPLE_STEP);
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p95 == 95U * SAMPLE_STEP);
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p99 == 99U * SAMPLE_STEP);
+
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_LAYOUT].p99 == 0);
+
+    /* the total adds the present, which took a moment of its own */
+    NK_CHECK(stats.total.p50 >= stats.phases[NK_FRAME_PHASE_DISPATCH].p50);
+    NK_CHECK(stats.total.p99 >= stats.total.p95 && stats.total.p95 >= stats.total.p50);
+
+    for (uint32_t i = 0; i < stats.frameCount; i++)
+    {
+        uint64_t sum = 0;
+
+        for (uint32_t phase = 0; phase < NK_FRAME_PHASE_COUNT; phase++)
+        {
+            sum += stats.frames[i].phases[phase];
+        }
+
+        NK_CHECK(stats.frames[i].total == sum);
+    }
+}
+
+static void TestWrap(nkWindow_t *window)
+{
+    static nkFrameStats_t stats;
+
+    /* well past the history, so it holds only the newest frames, oldest first */
+    FinishFrames(window, 1001U, 2U * NK_FRAME_HISTORY_COUNT);
+
+    nkWindow_GetFrameStats(window, &stats);
+
+    NK_CHECK(stats.frameCount == NK_FRAME_HISTORY_COUNT);
+
+    uint32_t first = 1001U + NK_FRAME_HISTORY_COUNT;
+
+    for (uint32_t i = 0; i < NK_FRAME_HISTORY_COUNT; i++)
+    {
+        NK_CHECK(stats.frames[i].phases[NK_FRAME_PHASE_DISPATCH] == (uint64_t)(first + i) * SAMPLE_STEP);
+    }
+
+    /* none of the first test's frames are left to rank */
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p50 == (uint64_t)(first + NK_FRAME_HISTORY_COUNT / 2U - 1U) * SAMPLE_STEP);
+}
+
+static void TestFewFrames(nkWindow_t *window)
+{
+    static nkFrameStats_t stats;
+
+    /* too few frames to tell the tail apart, so p95 and p99 are both the slowest */
+    FinishFrames(window, 3U, 1U);
+    FinishFrames(window, 1U, 1U);
+    FinishFrames(window, 2U, 1U);
+
+    nkWindow_GetFrameStats(window, &stats);
+
+    NK_CHECK(stats.frameCount == 3U);
+    NK_CHECK(stats.frames[0].phases[NK_FRAME_PHASE_DISPATCH] == 3U * SAMPLE_STEP);
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p50 == 2U * SAMPLE_STEP);
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p95 == 3U * SAMPLE_STEP);
+    NK_CHECK(stats.phases[NK_FRAME_PHASE_DISPATCH].p99 == 3U * SAMPLE_STEP);
+}
+
+static void FinishFrames(nkWindow_t *window, uint32_t first, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        /* as if dispatch took that long, the present is timed for real */
+        window->frameTiming.phases[NK_FRAME_PHASE_DISPATCH] = (uint64_t)(first + i) * SAMPLE_STEP;
+
+        nkWindow_FinishFrame(window, nkWindow_GetTicks());
+    }
+}
@@ -0,0 +1,231 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_headless.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - headless windows start out
+**                 empty and survive being destroyed by callbacks
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (64.0f)
+#define WINDOW_COUNT        (3U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* what each window saw, and which windows its callbacks destroy */
+typedef struct
+{
+    nkWindow_t *destroyOnMove;
+    nkWindow_t *destroyOnClose;
+    uint32_t moves;
+    uint32_t closes;
+} nkWindowLog_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestCreate(void);
+static void TestDestroyNext(void);
+static void TestDestroySelfAndNext(void);
+static bool CreateWindows(nkWindow_t *windows, nkWindowLog_t *logs);
+static void Move(nkWindow_t *window);
+static void OnPointerMove(nkWindow_t *window, float x, float y);
+static void OnClose(nkWindow_t *window);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const nkWindowDelegate_t testDelegate =
+{
+    .pointerMoveCallback = OnPointerMove,
+    .closeCallback = OnClose,
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    TestCreate();
+    TestDestroyNext();
+    TestDestroySelfAndNext();
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestCreate(void)
+{
+    nkWindow_t window;
+
+    /* nothing is left over from whatever the memory held before */
+    memset(&window, 0xAA, sizeof(window));
+
+    NK_CHECK(nkWindow_Create(&window, "test_headless", WINDOW_WIDTH, WINDOW_HEIGHT));
+
+    NK_CHECK(window.rootView == NULL);
+    NK_CHECK(window.hotView == NULL);
+    NK_CHECK(window.activeView == NULL);
+    NK_CHECK(window.delegate == NULL);
+    NK_CHECK(window.userData == NULL);
+
+    /* with no views and no delegate, a move and a frame have nothing to hit-test or call */
+    Move(&window);
+    nkWindow_PollEvents();
+
+    NK_CHECK(window.hotView == NULL);
+
+    nkWindow_Destroy(&window);
+}
+
+static void TestDestroyNext(void)
+{
+    nkWindow_t windows[WINDOW_COUNT];
+    nkWindowLog_t logs[WINDOW_COUNT];
+
+    if (!CreateWindows(windows, logs))
+    {
+        return;
+    }
+
+    /* the first window's move destroys the one after it, which the pump was about to visit */
+    logs[0].destroyOnMove = &windows[1];
+
+    Move(&windows[0]);
+    Move(&windows[1]);
+    Move(&windows[2]);
+
+    nkWindow_PollEvents();
+
+    NK_CHECK(logs[0].moves == 1U);
+    NK_CHECK(logs[1].moves == 0);
+    NK_CHECK(logs[2].moves == 1U);
+    NK_CHECK(logs[1].closes == 1U);
+
+    /* a second destroy does nothing, the close callback is not called again */
+    nkWindow_Destroy(&windows[1]);
+
+    NK_CHECK(logs[1].closes == 1U);
+
+    nkWindow_Destroy(&windows[2]);
+    nkWindow_Destroy(&windows[0]);
+
+    NK_CHECK(logs[0].closes == 1U);
+    NK_CHECK(logs[2].closes == 1U);
+    NK_CHECK(!nkWindow_PollEvents());
+}
+
+static void TestDestroySelfAndNext(void)
+{
+    nkWindow_t windows[WINDOW_COUNT];
+    nkWindowLog_t logs[WINDOW_COUNT];
+
+    if (!CreateWindows(windows, logs))
+    {
+        return;
+    }
+
+    /* the first window destroys itself from its move callback, and the second from its close callback */
+    logs[0].destroyOnMove = &windows[0];
+    logs[0].destroyOnClose = &windows[1];
+
+    Move(&windows[0]);
+    Move(&windows[1]);
+    Move(&windows[2]);
+
+    nkWindow_PollEvents();
+
+    NK_CHECK(logs[0].closes == 1U);
+    NK_CHECK(logs[1].closes == 1U);
+    NK_CHECK(logs[1].moves == 0);
+    NK_CHECK(logs[2].moves == 1U);
+    NK_CHECK(logs[2].closes == 0);
+
+    nkWindow_Destroy(&windows[2]);
+
+    NK_CHECK(!nkWindow_PollEvents());
+}
+
+static bool CreateWindows(nkWindow_t *windows, nkWindowLog_t *logs)
+{
+    for (uint32_t i = 0; i < WINDOW_COUNT; i++)
+    {
+        memset(&logs[i], 0, sizeof(logs[i]));
+
+        if (!nkWindow_Create(&windows[i], "test_headless", WINDOW_WIDTH, WINDOW_HEIGHT))
+        {
+            fprintf(stderr, "Failed to create a headless window!\n");
+            NK_CHECK(false);
+            return false;
+        }
+
+        nkWindow_SetDelegate(&windows[i], &testDelegate, &logs[i]);
+    }
+
+    return true;
+}
+
+static void Move(nkWindow_t *window)
+{
+    nkEvent_t event = { .type = NK_EVENT_POINTER_MOVE, .pointer = { 10.0f, 10.0f } };
+
+    /* held back for merging, so it is delivered by the next pump */
+    nkWindow_InjectEvent(window, &event);
+}
+
+static void OnPointerMove(nkWindow_t *window, float x, float y)
+{
+    nkWindowLog_t *log = window->userData;
+
+    (void)x;
+    (void)y;
+
+    log->moves++;
+
+    if (log->destroyOnMove != NULL)
+    {
+        nkWindow_Destroy(log->destroyOnMove);
+    }
+}
+
+static void OnClose(nkWindow_t *window)
+{
+    nkWindowLog_t *log = window->userData;
+
+    log->closes++;
+
+    if (log->destroyOnClose != NULL)
+    {
+        nkWindow_Destroy(log->destroyOnClose);
+    }
+}
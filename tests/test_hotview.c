@@ -0,0 +1,249 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_hotview.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - pointer moves inside the
+**                 hot view or during a drag skip the search
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (400.0f)
+#define WINDOW_HEIGHT       (100.0f)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestHotHits(nkWindow_t *window, nkView_t *view);
+static void TestLayoutChange(nkWindow_t *window, nkView_t *view);
+static void TestCapture(nkWindow_t *window, nkView_t *view, nkView_t *other);
+static void Move(nkWindow_t *window, nkPoint_t point);
+static void Press(nkWindow_t *window, nkEventType_t type, nkPoint_t point);
+static nkView_t *FindView(nkView_t *view, nkPoint_t point);
+static nkPoint_t GetCenter(const nkView_t *view);
+static bool RectsOverlap(nkRect_t a, nkRect_t b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+    nkView_t left;
+    nkView_t leftChild;
+    nkView_t right;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+    memset(&left, 0, sizeof(left));
+    memset(&leftChild, 0, sizeof(leftChild));
+    memset(&right, 0, sizeof(right));
+
+    if (!nkWindow_Create(&window, "test_hotview", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    nkView_AddChildView(&rootView, &left);
+    nkView_AddChildView(&left, &leftChild);
+    nkView_AddChildView(&rootView, &right);
+
+    window.rootView = &rootView;
+    nkWindow_PollEvents();
+
+    /* the frames are whatever the layout made of them, every check is against a walk of those */
+    if (right.frame.width < 4.0f || right.frame.height < 4.0f || RectsOverlap(left.frame, right.frame))
+    {
+        fprintf(stderr, "The layout stacks the views, nothing to test!\n");
+        nkWindow_Destroy(&window);
+        return NK_TEST_RESULT();
+    }
+
+    TestHotHits(&window, &right);
+    TestLayoutChange(&window, &right);
+    TestCapture(&window, &right, &left);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestHotHits(nkWindow_t *window, nkView_t *view)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+    nkPoint_t center = GetCenter(view);
+
+    nkWindow_GetStats(window, &before);
+
+    /* the first move into the view searches for it */
+    Move(window, center);
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(window->hotView == view);
+    NK_CHECK(after.pointerHitTests == before.pointerHitTests + 1U);
+    NK_CHECK(after.pointerHotHits == before.pointerHotHits);
+
+    /* moves that stay inside it do not */
+    Move(window, (nkPoint_t){ center.x + 1.0f, center.y });
+    Move(window, (nkPoint_t){ center.x - 1.0f, center.y + 1.0f });
+
+    nkWindow_GetStats(window, &before);
+
+    NK_CHECK(window->hotView == view);
+    NK_CHECK(before.pointerHitTests == after.pointerHitTests);
+    NK_CHECK(before.pointerHotHits == after.pointerHotHits + 2U);
+
+    /* leaving it searches again, and finds what a walk does */
+    nkPoint_t outside = { view->frame.x - 1.0f, center.y };
+
+    Move(window, outside);
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(window->hotView == FindView(window->rootView, outside));
+    NK_CHECK(after.pointerHitTests == before.pointerHitTests + 1U);
+}
+
+static void TestLayoutChange(nkWindow_t *window, nkView_t *view)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+    nkPoint_t center = GetCenter(view);
+
+    Move(window, center);
+
+    nkWindow_GetStats(window, &before);
+
+    /* the same place, but the views may have moved under it */
+    nkWindow_SetNeedsLayout(window);
+    Move(window, (nkPoint_t){ center.x + 1.0f, center.y });
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.layoutsPerformed == before.layoutsPerformed + 1U);
+    NK_CHECK(after.pointerHitTests == before.pointerHitTests + 1U);
+    NK_CHECK(after.pointerHotHits == before.pointerHotHits);
+    NK_CHECK(window->hotView == view);
+}
+
+static void TestCapture(nkWindow_t *window, nkView_t *view, nkView_t *other)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+    nkPoint_t center = GetCenter(view);
+
+    Move(window, center);
+    Press(window, NK_EVENT_POINTER_ACTION_BEGIN, center);
+
+    if (window->activeView != view)
+    {
+        fprintf(stderr, "The view did not take the press, nothing captured!\n");
+        Press(window, NK_EVENT_POINTER_ACTION_END, center);
+        return;
+    }
+
+    nkWindow_GetStats(window, &before);
+
+    /* dragged out over another view, still without a search */
+    Move(window, (nkPoint_t){ center.x + 1.0f, center.y });
+    Move(window, GetCenter(other));
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(window->activeView == view);
+    NK_CHECK(after.pointerCaptureHits == before.pointerCaptureHits + 2U);
+    NK_CHECK(after.pointerHitTests == before.pointerHitTests);
+
+    Press(window, NK_EVENT_POINTER_ACTION_END, GetCenter(other));
+
+    /* released, the next move searches from scratch */
+    nkPoint_t point = { GetCenter(other).x + 1.0f, GetCenter(other).y };
+
+    Move(window, point);
+
+    nkWindow_GetStats(window, &before);
+
+    NK_CHECK(window->activeView == NULL);
+    NK_CHECK(before.pointerHitTests == after.pointerHitTests + 1U);
+    NK_CHECK(window->hotView == FindView(window->rootView, point));
+}
+
+static void Move(nkWindow_t *window, nkPoint_t point)
+{
+    nkEvent_t event = { .type = NK_EVENT_POINTER_MOVE, .pointer = { point.x, point.y } };
+
+    nkWindow_InjectEvent(window, &event);
+    nkWindow_PollEvents();
+}
+
+static void Press(nkWindow_t *window, nkEventType_t type, nkPoint_t point)
+{
+    nkEvent_t event = { .type = type, .pointerAction = { NK_POINTER_ACTION_PRIMARY, point.x, point.y } };
+
+    nkWindow_InjectEvent(window, &event);
+    nkWindow_PollEvents();
+}
+
+static nkView_t *FindView(nkView_t *view, nkPoint_t point)
+{
+    /* the walk from the root, into the first child containing the point */
+    nkRect_t frame = view->frame;
+
+    if (point.x < frame.x || point.y < frame.y || point.x >= frame.x + frame.width || point.y >= frame.y + frame.height)
+    {
+        return NULL;
+    }
+
+    for (nkView_t *child = view->child; child != NULL; child = child->sibling)
+    {
+        nkView_t *found = FindView(child, point);
+
+        if (found != NULL)
+        {
+            return found;
+        }
+    }
+
+    return view;
+}
+
+static nkPoint_t GetCenter(const nkView_t *view)
+{
+    return (nkPoint_t){ view->frame.x + view->frame.width * 0.5f, view->frame.y + view->frame.height * 0.5f };
+}
+
+static bool RectsOverlap(nkRect_t a, nkRect_t b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
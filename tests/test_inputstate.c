@@ -0,0 +1,240 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_inputstate.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - keys and pointer actions
+**                 held down are tracked one bit each
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (32.0f)
+#define KEYCODE_LAST        (0x00FFU)   /* the last keycode with a bit */
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestKeys(nkWindow_t *window);
+static void TestOutOfRange(nkWindow_t *window);
+static void TestPointerActions(nkWindow_t *window);
+static void TestFocusLoss(nkWindow_t *window);
+static void TestInCallback(nkWindow_t *window);
+static void PressKey(nkWindow_t *window, uint32_t keycode, bool down);
+static void PressAction(nkWindow_t *window, nkPointerAction_t action, bool down);
+static void OnKeyDown(nkWindow_t *window, uint32_t keycode);
+static void OnPointerActionBegin(nkWindow_t *window, nkPointerAction_t action, float x, float y);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/* what the callbacks saw of their own input */
+static bool keyDownInCallback = false;
+static bool actionDownInCallback = false;
+
+static const nkWindowDelegate_t testDelegate =
+{
+    .keyDownCallback = OnKeyDown,
+    .pointerActionBeginCallback = OnPointerActionBegin,
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+
+    if (!nkWindow_Create(&window, "test_inputstate", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    window.rootView = &rootView;
+    nkWindow_PollEvents();
+
+    /* nothing is down in a new window */
+    NK_CHECK(!nkWindow_IsKeyDown(&window, NK_KEYCODE_SPACE));
+    NK_CHECK(!nkWindow_IsPointerActionDown(&window, NK_POINTER_ACTION_PRIMARY));
+
+    TestKeys(&window);
+    TestOutOfRange(&window);
+    TestPointerActions(&window);
+    TestFocusLoss(&window);
+
+    nkWindow_SetDelegate(&window, &testDelegate, NULL);
+
+    TestInCallback(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestKeys(nkWindow_t *window)
+{
+    /* either side of a word boundary, one further on and the last bit */
+    PressKey(window, 31U, true);
+    PressKey(window, 32U, true);
+    PressKey(window, NK_KEYCODE_F24, true);
+    PressKey(window, KEYCODE_LAST, true);
+
+    NK_CHECK(nkWindow_IsKeyDown(window, 31U));
+    NK_CHECK(nkWindow_IsKeyDown(window, 32U));
+    NK_CHECK(nkWindow_IsKeyDown(window, NK_KEYCODE_F24));
+    NK_CHECK(nkWindow_IsKeyDown(window, KEYCODE_LAST));
+    NK_CHECK(!nkWindow_IsKeyDown(window, 30U));
+    NK_CHECK(!nkWindow_IsKeyDown(window, 33U));
+    NK_CHECK(!nkWindow_IsKeyDown(window, NK_KEYCODE_F23));
+
+    /* a release clears its own key and no other */
+    PressKey(window, 32U, false);
+
+    NK_CHECK(nkWindow_IsKeyDown(window, 31U));
+    NK_CHECK(!nkWindow_IsKeyDown(window, 32U));
+
+    /* and a second press of a held key, from auto-repeat, is still one key down */
+    PressKey(window, 31U, true);
+    PressKey(window, 31U, false);
+
+    NK_CHECK(!nkWindow_IsKeyDown(window, 31U));
+
+    PressKey(window, NK_KEYCODE_F24, false);
+    PressKey(window, KEYCODE_LAST, false);
+
+    NK_CHECK(!nkWindow_IsKeyDown(window, NK_KEYCODE_F24));
+    NK_CHECK(!nkWindow_IsKeyDown(window, KEYCODE_LAST));
+}
+
+static void TestOutOfRange(nkWindow_t *window)
+{
+    uint32_t before[sizeof(window->keyState) / sizeof(uint32_t)];
+
+    memcpy(before, window->keyState, sizeof(before));
+
+    /* past the bitmap, they are delivered but cannot be tracked, nor spill into other keys */
+    PressKey(window, KEYCODE_LAST + 1U, true);
+    PressKey(window, UINT32_MAX, true);
+
+    NK_CHECK(!nkWindow_IsKeyDown(window, KEYCODE_LAST + 1U));
+    NK_CHECK(!nkWindow_IsKeyDown(window, UINT32_MAX));
+    NK_CHECK(memcmp(before, window->keyState, sizeof(before)) == 0);
+
+    NK_CHECK(!nkWindow_IsKeyDown(NULL, NK_KEYCODE_SPACE));
+    NK_CHECK(!nkWindow_IsPointerActionDown(NULL, NK_POINTER_ACTION_PRIMARY));
+}
+
+static void TestPointerActions(nkWindow_t *window)
+{
+    PressAction(window, NK_POINTER_ACTION_PRIMARY, true);
+    PressAction(window, NK_POINTER_ACTION_SECONDARY, true);
+
+    NK_CHECK(nkWindow_IsPointerActionDown(window, NK_POINTER_ACTION_PRIMARY));
+    NK_CHECK(nkWindow_IsPointerActionDown(window, NK_POINTER_ACTION_SECONDARY));
+    NK_CHECK(!nkWindow_IsPointerActionDown(window, NK_POINTER_ACTION_TERTIARY));
+
+    /* released one at a time, each clearing only its own bit */
+    PressAction(window, NK_POINTER_ACTION_PRIMARY, false);
+
+    NK_CHECK(!nkWindow_IsPointerActionDown(window, NK_POINTER_ACTION_PRIMARY));
+    NK_CHECK(nkWindow_IsPointerActionDown(window, NK_POINTER_ACTION_SECONDARY));
+
+    PressAction(window, NK_POINTER_ACTION_SECONDARY, false);
+
+    NK_CHECK(window->pointerActionState == 0);
+}
+
+static void TestFocusLoss(nkWindow_t *window)
+{
+    PressKey(window, NK_KEYCODE_F1, true);
+    PressKey(window, KEYCODE_LAST, true);
+    PressAction(window, NK_POINTER_ACTION_EXTENDED_2, true);
+
+    /* gaining focus keeps what is down */
+    nkEvent_t focus = { .type = NK_EVENT_FOCUS_CHANGE, .focus = NK_WINDOW_FOCUS_FOCUSED };
+
+    nkWindow_InjectEvent(window, &focus);
+
+    NK_CHECK(nkWindow_IsKeyDown(window, NK_KEYCODE_F1));
+
+    /* losing it lets go of everything, the releases would go to another window */
+    nkWindow_SetFocus(window, NK_WINDOW_FOCUS_UNFOCUSED);
+
+    NK_CHECK(!nkWindow_IsKeyDown(window, NK_KEYCODE_F1));
+    NK_CHECK(!nkWindow_IsKeyDown(window, KEYCODE_LAST));
+    NK_CHECK(!nkWindow_IsPointerActionDown(window, NK_POINTER_ACTION_EXTENDED_2));
+
+    nkWindow_SetFocus(window, NK_WINDOW_FOCUS_FOCUSED);
+}
+
+static void TestInCallback(nkWindow_t *window)
+{
+    /* a callback asking about its own input already sees it down */
+    PressKey(window, NK_KEYCODE_SPACE, true);
+    PressAction(window, NK_POINTER_ACTION_PRIMARY, true);
+
+    NK_CHECK(keyDownInCallback);
+    NK_CHECK(actionDownInCallback);
+
+    PressKey(window, NK_KEYCODE_SPACE, false);
+    PressAction(window, NK_POINTER_ACTION_PRIMARY, false);
+}
+
+static void PressKey(nkWindow_t *window, uint32_t keycode, bool down)
+{
+    nkEvent_t event = { .type = down ? NK_EVENT_KEY_DOWN : NK_EVENT_KEY_UP, .key = { keycode } };
+
+    nkWindow_InjectEvent(window, &event);
+}
+
+static void PressAction(nkWindow_t *window, nkPointerAction_t action, bool down)
+{
+    nkEvent_t event = { .type = down ? NK_EVENT_POINTER_ACTION_BEGIN : NK_EVENT_POINTER_ACTION_END, .pointerAction = { action, 1.0f, 1.0f } };
+
+    nkWindow_InjectEvent(window, &event);
+}
+
+static void OnKeyDown(nkWindow_t *window, uint32_t keycode)
+{
+    keyDownInCallback = nkWindow_IsKeyDown(window, keycode);
+}
+
+static void OnPointerActionBegin(nkWindow_t *window, nkPointerAction_t action, float x, float y)
+{
+    (void)x;
+    (void)y;
+
+    actionDownInCallback = nkWindow_IsPointerActionDown(window, action);
+}
@@ -0,0 +1,118 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_keycodes.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - the platform key tables
+**                 map both ways
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define KEYCODE_LIMIT       (0x100U)    /* past the last NK_KEYCODE_ */
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestRoundTrips(void);
+static void TestKnownKeys(void);
+static void TestOutOfRange(void);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    TestRoundTrips();
+    TestKnownKeys();
+    TestOutOfRange();
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestRoundTrips(void)
+{
+    uint32_t virtualKeys = 0;
+    uint32_t keysyms = 0;
+    uint32_t codes = 0;
+
+    /* every keycode a table sends out comes back as the same keycode */
+    for (uint32_t keycode = 1; keycode < KEYCODE_LIMIT; keycode++)
+    {
+        uint32_t virtualKey = nkKeycode_ToVirtualKey(keycode);
+        uint32_t keysym = nkKeycode_ToKeysym(keycode);
+        const char *code = nkKeycode_ToCode(keycode);
+
+        if (virtualKey != 0)
+        {
+            NK_CHECK(nkKeycode_FromVirtualKey(virtualKey) == keycode);
+            virtualKeys++;
+        }
+
+        if (keysym != 0)
+        {
+            NK_CHECK(nkKeycode_FromKeysym(keysym) == keycode);
+            keysyms++;
+        }
+
+        if (code != NULL)
+        {
+            NK_CHECK(nkKeycode_FromCode(code) == keycode);
+            codes++;
+        }
+    }
+
+    NK_CHECK(virtualKeys > 0);
+    NK_CHECK(keysyms > 0);
+    NK_CHECK(codes > 0);
+}
+
+static void TestKnownKeys(void)
+{
+    /* VK_ESCAPE, XK_Escape and the DOM code */
+    NK_CHECK(nkKeycode_FromVirtualKey(0x1BU) == NK_KEYCODE_ESCAPE);
+    NK_CHECK(nkKeycode_FromKeysym(0xFF1BU) == NK_KEYCODE_ESCAPE);
+    NK_CHECK(nkKeycode_FromCode("Escape") == NK_KEYCODE_ESCAPE);
+
+    /* VK_F1, XK_F1 */
+    NK_CHECK(nkKeycode_FromVirtualKey(0x70U) == NK_KEYCODE_F1);
+    NK_CHECK(nkKeycode_FromKeysym(0xFFBEU) == NK_KEYCODE_F1);
+    NK_CHECK(nkKeycode_FromCode("F1") == NK_KEYCODE_F1);
+
+    NK_CHECK(nkKeycode_FromKeysym(0x20U) == NK_KEYCODE_SPACE);
+    NK_CHECK(nkKeycode_FromCode("Space") == NK_KEYCODE_SPACE);
+}
+
+static void TestOutOfRange(void)
+{
+    NK_CHECK(nkKeycode_FromVirtualKey(0xFFFFFFFFU) == 0);
+    NK_CHECK(nkKeycode_ToVirtualKey(0xFFFFFFFFU) == 0);
+    NK_CHECK(nkKeycode_FromKeysym(0x1000000U) == 0);
+    NK_CHECK(nkKeycode_ToKeysym(0xFFFFFFFFU) == 0);
+    NK_CHECK(nkKeycode_FromCode(NULL) == 0);
+    NK_CHECK(nkKeycode_FromCode("NotAKey") == 0);
+    NK_CHECK(nkKeycode_ToCode(0xFFFFFFFFU) == NULL);
+}
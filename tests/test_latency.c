@@ -0,0 +1,211 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_latency.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - input latency lands in the
+**                 bucket of its oldest input, once per frame
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (32.0f)
+#define HALF_BUCKET         (NK_LATENCY_BUCKET_WIDTH * 0.5)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestBuckets(nkWindow_t *window);
+static void TestOutOfRange(nkWindow_t *window);
+static void TestNoInput(nkWindow_t *window);
+static void TestFrame(nkWindow_t *window);
+static void TestUndrawn(nkWindow_t *window);
+static void FinishFrameAfter(nkWindow_t *window, double latency);
+static void Inject(nkWindow_t *window, nkEvent_t event);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+
+    if (!nkWindow_Create(&window, "test_latency", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    window.rootView = &rootView;
+    nkWindow_PollEvents();
+
+    TestBuckets(&window);
+    TestOutOfRange(&window);
+    TestNoInput(&window);
+    TestFrame(&window);
+    TestUndrawn(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestBuckets(nkWindow_t *window)
+{
+    nkLatencyHistogram_t before;
+    nkLatencyHistogram_t after;
+
+    nkWindow_GetInputLatency(window, &before);
+
+    /* half way into each bucket, so the moment the frame takes to finish cannot tip it into the next */
+    FinishFrameAfter(window, 0.0 * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+    FinishFrameAfter(window, 3.0 * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+    FinishFrameAfter(window, 3.0 * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+    FinishFrameAfter(window, 10.0 * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+
+    nkWindow_GetInputLatency(window, &after);
+
+    NK_CHECK(after.count == before.count + 4U);
+    NK_CHECK(after.buckets[0] == before.buckets[0] + 1U);
+    NK_CHECK(after.buckets[3] == before.buckets[3] + 2U);
+    NK_CHECK(after.buckets[10] == before.buckets[10] + 1U);
+    NK_CHECK(after.max >= 10.0 * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+    NK_CHECK(after.max < 11.0 * NK_LATENCY_BUCKET_WIDTH);
+    NK_CHECK(after.sum - before.sum >= 16.0 * NK_LATENCY_BUCKET_WIDTH + 4.0 * HALF_BUCKET);
+}
+
+static void TestOutOfRange(nkWindow_t *window)
+{
+    nkLatencyHistogram_t before;
+    nkLatencyHistogram_t after;
+
+    nkWindow_GetInputLatency(window, &before);
+
+    /* anything slower than the histogram goes in its last bucket */
+    FinishFrameAfter(window, 1.0);
+    FinishFrameAfter(window, (double)NK_LATENCY_BUCKET_COUNT * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+
+    /* a timestamp from after the frame cannot have waited on it */
+    FinishFrameAfter(window, -1.0);
+
+    nkWindow_GetInputLatency(window, &after);
+
+    NK_CHECK(after.count == before.count + 3U);
+    NK_CHECK(after.buckets[NK_LATENCY_BUCKET_COUNT - 1U] == before.buckets[NK_LATENCY_BUCKET_COUNT - 1U] + 2U);
+    NK_CHECK(after.buckets[0] == before.buckets[0] + 1U);
+    NK_CHECK(after.max >= 1.0);
+    NK_CHECK(after.sum >= before.sum + 1.0);
+}
+
+static void TestNoInput(nkWindow_t *window)
+{
+    nkLatencyHistogram_t before;
+    nkLatencyHistogram_t after;
+
+    nkWindow_GetInputLatency(window, &before);
+
+    /* a frame no input asked for, an animation say, has no latency to count */
+    nkWindow_FinishFrame(window, nkWindow_GetTicks());
+
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    nkWindow_GetInputLatency(window, &after);
+
+    NK_CHECK(after.count == before.count);
+}
+
+static void TestFrame(nkWindow_t *window)
+{
+    nkLatencyHistogram_t before;
+    nkLatencyHistogram_t after;
+
+    nkWindow_GetInputLatency(window, &before);
+
+    double now = nkWindow_GetTime();
+
+    /* merged into one move that keeps the oldest time, the frame answering both counts once from the first */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .timestamp = now - 5.0 * NK_LATENCY_BUCKET_WIDTH - HALF_BUCKET, .pointer = { 1.0f, 1.0f } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .timestamp = now - HALF_BUCKET, .pointer = { 2.0f, 1.0f } });
+
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    nkWindow_GetInputLatency(window, &after);
+
+    NK_CHECK(after.count == before.count + 1U);
+    NK_CHECK(after.max >= 5.0 * NK_LATENCY_BUCKET_WIDTH + HALF_BUCKET);
+
+    uint64_t counted = 0;
+
+    for (uint32_t i = 5U; i < NK_LATENCY_BUCKET_COUNT; i++)
+    {
+        counted += after.buckets[i] - before.buckets[i];
+    }
+
+    NK_CHECK(counted == 1U);
+    NK_CHECK(window->frameTiming.inputOldest == 0.0);
+}
+
+static void TestUndrawn(nkWindow_t *window)
+{
+    nkLatencyHistogram_t before;
+    nkLatencyHistogram_t after;
+
+    nkWindow_GetInputLatency(window, &before);
+
+    /* input that changed nothing has no frame to wait for, and is not blamed on the next one */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_KEY_DOWN, .timestamp = nkWindow_GetTime() - 1.0, .key = { .keycode = NK_KEYCODE_SPACE } });
+    nkWindow_PollEvents();
+
+    NK_CHECK(window->frameTiming.inputOldest == 0.0);
+
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    nkWindow_GetInputLatency(window, &after);
+
+    NK_CHECK(after.count == before.count);
+}
+
+static void FinishFrameAfter(nkWindow_t *window, double latency)
+{
+    /* as if the frame answered input that reached the platform that long ago */
+    window->frameTiming.inputOldest = nkWindow_GetTime() - latency;
+
+    nkWindow_FinishFrame(window, nkWindow_GetTicks());
+}
+
+static void Inject(nkWindow_t *window, nkEvent_t event)
+{
+    nkWindow_InjectEvent(window, &event);
+}
@@ -0,0 +1,180 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_layout.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - layout is deferred to one
+**                 per frame and skipped when nothing changed
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (400.0f)
+#define WINDOW_HEIGHT       (100.0f)
+#define DRAG_STEPS          (10U)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestSameSize(nkWindow_t *window);
+static void TestResizeDrag(nkWindow_t *window);
+static void TestHitTestFirst(nkWindow_t *window);
+static void TestNeedsLayout(nkWindow_t *window);
+static void Resize(nkWindow_t *window, float width, float height);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+    nkView_t children[2];
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+    memset(children, 0, sizeof(children));
+
+    if (!nkWindow_Create(&window, "test_layout", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    nkView_AddChildView(&rootView, &children[0]);
+    nkView_AddChildView(&rootView, &children[1]);
+
+    window.rootView = &rootView;
+    nkWindow_PollEvents();
+
+    TestSameSize(&window);
+    TestResizeDrag(&window);
+    TestHitTestFirst(&window);
+    TestNeedsLayout(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestSameSize(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* a move, or a resize reported twice, changes nothing to lay out */
+    Resize(window, window->width, window->height);
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.layoutsSkipped == before.layoutsSkipped + 1U);
+    NK_CHECK(after.layoutsPerformed == before.layoutsPerformed);
+}
+
+static void TestResizeDrag(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* a drag delivers many sizes between frames, only the last is laid out */
+    for (uint32_t i = 1; i <= DRAG_STEPS; i++)
+    {
+        Resize(window, WINDOW_WIDTH + (float)i, WINDOW_HEIGHT);
+    }
+
+    /* nothing laid out until the pump */
+    NK_CHECK(window->layoutSize.width == WINDOW_WIDTH);
+
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.layoutsPerformed == before.layoutsPerformed + 1U);
+    NK_CHECK(after.layoutsSkipped == before.layoutsSkipped + DRAG_STEPS - 1U);
+    NK_CHECK(window->layoutSize.width == WINDOW_WIDTH + (float)DRAG_STEPS);
+    NK_CHECK(window->rootView->frame.width == WINDOW_WIDTH + (float)DRAG_STEPS);
+
+    /* and the frame after has nothing left to lay out */
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &before);
+
+    NK_CHECK(before.layoutsPerformed == after.layoutsPerformed);
+}
+
+static void TestHitTestFirst(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* a move after a resize lays out to hit-test, and the frame reuses that layout */
+    Resize(window, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    nkEvent_t move = { .type = NK_EVENT_POINTER_MOVE, .pointer = { 10.0f, 10.0f } };
+
+    nkWindow_InjectEvent(window, &move);
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.layoutsPerformed == before.layoutsPerformed + 1U);
+    NK_CHECK(window->rootView->frame.width == WINDOW_WIDTH);
+}
+
+static void TestNeedsLayout(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* the tree changed at the same size, which no size check can see */
+    nkWindow_SetNeedsLayout(window);
+    nkWindow_SetNeedsLayout(window);
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.layoutsPerformed == before.layoutsPerformed + 1U);
+    NK_CHECK(!window->layoutDirty);
+}
+
+static void Resize(nkWindow_t *window, float width, float height)
+{
+    nkEvent_t event = { .type = NK_EVENT_RESIZE, .resize = { width, height } };
+
+    nkWindow_InjectEvent(window, &event);
+}
@@ -0,0 +1,169 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_pacing.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - a frame rate cap holds
+**                 presents to its period without drifting
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (64.0f)
+#define FRAME_RATE          (100.0f)
+#define PERIOD              (0.01)      /* seconds, at FRAME_RATE */
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestUncapped(nkWindow_t *window);
+static void TestDelay(nkWindow_t *window);
+static void TestNoDrift(nkWindow_t *window);
+static void TestLateFrame(nkWindow_t *window);
+static void WaitFor(double seconds);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+
+    memset(&window, 0, sizeof(window));
+
+    if (!nkWindow_Create(&window, "test_pacing", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    /* presents go out at once, so the cap is met exactly rather than on a blank */
+    nkWindow_SetSwapInterval(&window, NK_SWAP_INTERVAL_OFF);
+
+    TestUncapped(&window);
+    TestDelay(&window);
+    TestNoDrift(&window);
+    TestLateFrame(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestUncapped(nkWindow_t *window)
+{
+    nkWindow_SetMaxFrameRate(window, 0.0f);
+
+    nkWindow_PaceFrame(window);
+    nkWindow_PaceFrame(window);
+
+    NK_CHECK(nkWindow_GetPaceDelay(window) == 0.0);
+
+    /* a negative rate is no cap either */
+    nkWindow_SetMaxFrameRate(window, -30.0f);
+
+    NK_CHECK(window->maxFrameRate == 0.0f);
+    NK_CHECK(nkWindow_GetPaceDelay(window) == 0.0);
+}
+
+static void TestDelay(nkWindow_t *window)
+{
+    nkWindow_SetMaxFrameRate(window, FRAME_RATE);
+
+    /* the first frame under a new cap goes out at once, and sets the deadline a period on */
+    NK_CHECK(nkWindow_GetPaceDelay(window) == 0.0);
+
+    double start = nkWindow_GetTime();
+
+    nkWindow_PaceFrame(window);
+
+    double delay = nkWindow_GetPaceDelay(window);
+
+    NK_CHECK(nkWindow_GetTime() - start < PERIOD);
+    NK_CHECK(delay > 0.0 && delay <= PERIOD);
+
+    /* the next one waits out the delay, and no more */
+    nkWindow_PaceFrame(window);
+
+    NK_CHECK(nkWindow_GetTime() - start >= PERIOD);
+
+    delay = nkWindow_GetPaceDelay(window);
+
+    NK_CHECK(delay > 0.0 && delay <= PERIOD);
+}
+
+static void TestNoDrift(nkWindow_t *window)
+{
+    nkWindow_SetMaxFrameRate(window, FRAME_RATE);
+    nkWindow_PaceFrame(window);
+
+    /* deadlines follow each other, so ten frames take ten periods from the first, whatever each wait overslept */
+    double start = nkWindow_GetTime();
+    double deadline = start + nkWindow_GetPaceDelay(window) + 9.0 * PERIOD;
+
+    for (uint32_t i = 0; i < 10U; i++)
+    {
+        nkWindow_PaceFrame(window);
+    }
+
+    NK_CHECK(nkWindow_GetTime() >= deadline);
+
+    /* the eleventh deadline is a period after the tenth, however late the tenth was met */
+    NK_CHECK(nkWindow_GetPaceDelay(window) <= PERIOD);
+}
+
+static void TestLateFrame(nkWindow_t *window)
+{
+    nkWindow_SetMaxFrameRate(window, FRAME_RATE);
+    nkWindow_PaceFrame(window);
+
+    /* three periods late, so the cap starts over rather than letting the next frames out back to back */
+    WaitFor(3.0 * PERIOD);
+
+    double start = nkWindow_GetTime();
+
+    nkWindow_PaceFrame(window);
+
+    NK_CHECK(nkWindow_GetTime() - start < PERIOD);
+    NK_CHECK(nkWindow_GetPaceDelay(window) > PERIOD * 0.5);
+
+    /* lifting the cap drops the deadline */
+    nkWindow_SetMaxFrameRate(window, 0.0f);
+
+    NK_CHECK(nkWindow_GetPaceDelay(window) == 0.0);
+}
+
+static void WaitFor(double seconds)
+{
+    double end = nkWindow_GetTime() + seconds;
+
+    while (nkWindow_GetTime() < end)
+    {
+        /* spin, the waits are milliseconds */
+    }
+}
@@ -0,0 +1,192 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_postqueue.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - the posted event queue
+**                 keeps each poster's order and refuses when full
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define THREAD_EVENT_COUNT  (100000U)   /* per producer, many times the capacity so the queue wraps often */
+#define PRODUCER_COUNT      (4U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    nkPostQueue_t *queue;
+    uint32_t producer;
+} nkProducer_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestPostQueueOrder(void);
+static void TestPostQueueFull(void);
+static void TestPostQueueThreaded(void);
+static void *QueueProducerMain(void *arg);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    TestPostQueueOrder();
+    TestPostQueueFull();
+    TestPostQueueThreaded();
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestPostQueueOrder(void)
+{
+    nkPostQueue_t *queue = nkPostQueue_Create();
+    nkEvent_t event;
+
+    NK_CHECK(queue != NULL);
+    NK_CHECK(!nkPostQueue_Pop(queue, &event));
+
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    while (popped < NK_POST_QUEUE_CAPACITY * 3U)
+    {
+        for (uint32_t i = 0; i < 100U; i++)
+        {
+            nkEvent_t in = { .type = NK_EVENT_USER, .user = { pushed++, &event } };
+
+            NK_CHECK(nkPostQueue_Push(queue, &in));
+        }
+
+        while (nkPostQueue_Pop(queue, &event))
+        {
+            NK_CHECK(event.type == NK_EVENT_USER);
+            NK_CHECK(event.user.code == popped);
+            NK_CHECK(event.user.data == &event);
+            popped++;
+        }
+    }
+
+    nkPostQueue_Destroy(queue);
+}
+
+static void TestPostQueueFull(void)
+{
+    nkPostQueue_t *queue = nkPostQueue_Create();
+    nkEvent_t event = { .type = NK_EVENT_USER };
+
+    for (uint32_t i = 0; i < NK_POST_QUEUE_CAPACITY; i++)
+    {
+        event.user.code = i;
+        NK_CHECK(nkPostQueue_Push(queue, &event));
+    }
+
+    /* a full queue refuses the post, so the poster can tell it was not delivered */
+    NK_CHECK(!nkPostQueue_Push(queue, &event));
+
+    for (uint32_t i = 0; i < NK_POST_QUEUE_CAPACITY; i++)
+    {
+        NK_CHECK(nkPostQueue_Pop(queue, &event));
+        NK_CHECK(event.user.code == i);
+    }
+
+    NK_CHECK(!nkPostQueue_Pop(queue, &event));
+
+    nkPostQueue_Destroy(queue);
+}
+
+static void TestPostQueueThreaded(void)
+{
+    nkPostQueue_t *queue = nkPostQueue_Create();
+    nkProducer_t producers[PRODUCER_COUNT];
+    pthread_t threads[PRODUCER_COUNT];
+
+    for (uint32_t i = 0; i < PRODUCER_COUNT; i++)
+    {
+        producers[i] = (nkProducer_t){ queue, i };
+        NK_CHECK(pthread_create(&threads[i], NULL, QueueProducerMain, &producers[i]) == 0);
+    }
+
+    /* producers interleave, but each one's events must arrive once and in the order it posted them */
+    uint32_t expected[PRODUCER_COUNT] = { 0 };
+    uint32_t received = 0;
+    nkEvent_t event;
+
+    while (received < THREAD_EVENT_COUNT * PRODUCER_COUNT)
+    {
+        if (!nkPostQueue_Pop(queue, &event))
+        {
+            sched_yield(); /* until a producer catches up */
+            continue;
+        }
+
+        uint32_t producer = event.user.code >> 24;
+        uint32_t sequence = event.user.code & 0xFFFFFFU;
+
+        NK_CHECK(producer < PRODUCER_COUNT);
+
+        if (producer < PRODUCER_COUNT)
+        {
+            NK_CHECK(sequence == expected[producer]);
+            expected[producer] = sequence + 1U;
+        }
+
+        received++;
+    }
+
+    for (uint32_t i = 0; i < PRODUCER_COUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+        NK_CHECK(expected[i] == THREAD_EVENT_COUNT);
+    }
+
+    NK_CHECK(!nkPostQueue_Pop(queue, &event));
+
+    nkPostQueue_Destroy(queue);
+}
+
+static void *QueueProducerMain(void *arg)
+{
+    nkProducer_t *producer = arg;
+
+    for (uint32_t i = 0; i < THREAD_EVENT_COUNT; i++)
+    {
+        nkEvent_t event = { .type = NK_EVENT_USER, .user = { (producer->producer << 24) | i, NULL } };
+
+        while (!nkPostQueue_Push(producer->queue, &event))
+        {
+            sched_yield(); /* until the consumer makes room */
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,336 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_record.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - a recording replays the
+**                 same callbacks it recorded
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (400.0f)
+#define WINDOW_HEIGHT       (100.0f)
+#define RECORDING_PATH      "test_record.nkr"
+#define LOG_SIZE            (8192U)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* the callbacks a window made, written out as text so two runs compare with strcmp */
+typedef struct
+{
+    char text[LOG_SIZE];
+    size_t length;
+    bool enabled;
+} nkCallbackLog_t;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void PlayInput(nkWindow_t *window);
+static void TestCatchUp(nkWindow_t *window);
+static void TestPendingOrder(nkWindow_t *window);
+static void ReplayInto(nkWindow_t *window, nkCallbackLog_t *log, double speed);
+static void WaitFor(double seconds);
+static void Inject(nkWindow_t *window, nkEvent_t event);
+static void Log(nkWindow_t *window, const char *format, ...);
+static void OnPointerMove(nkWindow_t *window, float x, float y);
+static void OnPointerActionBegin(nkWindow_t *window, nkPointerAction_t action, float x, float y);
+static void OnPointerActionEnd(nkWindow_t *window, nkPointerAction_t action, float x, float y);
+static void OnScroll(nkWindow_t *window, float deltaX, float deltaY);
+static void OnKeyDown(nkWindow_t *window, uint32_t keycode);
+static void OnKeyUp(nkWindow_t *window, uint32_t keycode);
+static void OnCodepointInput(nkWindow_t *window, uint32_t codepoint);
+static void OnResize(nkWindow_t *window, float width, float height);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const nkWindowDelegate_t testDelegate =
+{
+    .resizeCallback = OnResize,
+    .pointerMoveCallback = OnPointerMove,
+    .pointerActionBeginCallback = OnPointerActionBegin,
+    .pointerActionEndCallback = OnPointerActionEnd,
+    .scrollCallback = OnScroll,
+    .keyDownCallback = OnKeyDown,
+    .keyUpCallback = OnKeyUp,
+    .codepointInputCallback = OnCodepointInput,
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    static nkCallbackLog_t recorded;
+    static nkCallbackLog_t replayed;
+    nkWindow_t window;
+    nkView_t rootView;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+
+    if (!nkWindow_Create(&window, "test_record", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    window.rootView = &rootView;
+    nkWindow_PollEvents();
+
+    nkWindow_SetDelegate(&window, &testDelegate, &recorded);
+    recorded.enabled = true;
+
+    NK_CHECK(nkWindow_StartRecording(&window, RECORDING_PATH));
+    PlayInput(&window);
+    nkWindow_StopRecording(&window);
+
+    recorded.enabled = false;
+    NK_CHECK(recorded.length > 0);
+
+    /* back to where the recording started, without logging it */
+    nkWindow_SetSize(&window, WINDOW_WIDTH, WINDOW_HEIGHT);
+    nkWindow_PollEvents();
+
+    nkWindow_SetDelegate(&window, &testDelegate, &replayed);
+    replayed.enabled = true;
+
+    /* one event per pump, so nothing recorded apart is coalesced on the way back */
+    NK_CHECK(nkWindow_Replay(&window, RECORDING_PATH, 0.0));
+
+    while (window.replay != NULL)
+    {
+        nkWindow_PollEvents();
+    }
+
+    replayed.enabled = false;
+
+    NK_CHECK(strcmp(recorded.text, replayed.text) == 0);
+
+    if (strcmp(recorded.text, replayed.text) != 0)
+    {
+        fprintf(stderr, "recorded: %s\nreplayed: %s\n", recorded.text, replayed.text);
+    }
+
+    TestCatchUp(&window);
+    TestPendingOrder(&window);
+
+    /* a missing recording is refused */
+    NK_CHECK(!nkWindow_Replay(&window, "test_record_missing.nkr", 0.0));
+
+    nkWindow_Destroy(&window);
+    remove(RECORDING_PATH);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void PlayInput(nkWindow_t *window)
+{
+    /* coordinates on the recording's 1/256 grid, both near zero and large enough to need
+       several varint bytes, in both directions so the deltas change sign */
+    for (uint32_t i = 0; i < 32U; i++)
+    {
+        float x = 10.5f + (float)i * 11.25f;
+        float y = 90.0f - (float)i * 2.75f;
+
+        Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .pointer = { x, y } });
+
+        if (i % 8U == 3U)
+        {
+            Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_ACTION_BEGIN, .pointerAction = { NK_POINTER_ACTION_PRIMARY, x, y } });
+            Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_ACTION_END, .pointerAction = { NK_POINTER_ACTION_PRIMARY, x, y } });
+        }
+
+        if (i % 8U == 5U)
+        {
+            Inject(window, (nkEvent_t){ .type = NK_EVENT_SCROLL, .scroll = { -1.5f, 120.0f } });
+        }
+    }
+
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_KEY_DOWN, .key = { NK_KEYCODE_ESCAPE } });
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_KEY_UP, .key = { NK_KEYCODE_ESCAPE } });
+
+    /* outside the basic plane */
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_CODEPOINT_INPUT, .codepoint = { 0x1F600U } });
+
+    nkWindow_SetSize(window, 300.0f, 90.0f);
+    nkWindow_PollEvents();
+
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_POINTER_MOVE, .pointer = { 0.0f, 0.0f } });
+}
+
+static void TestCatchUp(nkWindow_t *window)
+{
+    static nkCallbackLog_t log;
+
+    /* three keys 10 ms apart, which are never merged */
+    NK_CHECK(nkWindow_StartRecording(window, RECORDING_PATH));
+
+    for (uint32_t i = 0; i < 3U; i++)
+    {
+        Inject(window, (nkEvent_t){ .type = NK_EVENT_KEY_DOWN, .key = { NK_KEYCODE_F1 + i } });
+        WaitFor(0.01);
+    }
+
+    nkWindow_StopRecording(window);
+
+    /* at real speed, but pumped only once all of them are due, so they all come in that one pump */
+    ReplayInto(window, &log, 1.0);
+    WaitFor(0.05);
+    nkWindow_PollEvents();
+
+    char expected[64];
+
+    snprintf(expected, sizeof(expected), "down %u\ndown %u\ndown %u\n",
+        (unsigned int)NK_KEYCODE_F1, (unsigned int)NK_KEYCODE_F1 + 1U, (unsigned int)NK_KEYCODE_F1 + 2U);
+
+    NK_CHECK(strcmp(log.text, expected) == 0);
+    NK_CHECK(window->replay == NULL);
+
+    log.enabled = false;
+}
+
+static void TestPendingOrder(nkWindow_t *window)
+{
+    static nkCallbackLog_t log;
+
+    NK_CHECK(nkWindow_StartRecording(window, RECORDING_PATH));
+    Inject(window, (nkEvent_t){ .type = NK_EVENT_KEY_DOWN, .key = { NK_KEYCODE_ESCAPE } });
+    nkWindow_StopRecording(window);
+
+    ReplayInto(window, &log, 0.0);
+
+    /* held back for merging when the replayed key arrives, and it came first, so it is delivered first */
+    nkEvent_t move = { .type = NK_EVENT_POINTER_MOVE, .pointer = { 5.0f, 6.0f } };
+
+    nkWindow_InjectEvent(window, &move);
+    nkWindow_PollEvents();
+
+    char expected[64];
+
+    snprintf(expected, sizeof(expected), "move 5.0000 6.0000\ndown %u\n", (unsigned int)NK_KEYCODE_ESCAPE);
+
+    NK_CHECK(strcmp(log.text, expected) == 0);
+
+    log.enabled = false;
+}
+
+static void ReplayInto(nkWindow_t *window, nkCallbackLog_t *log, double speed)
+{
+    log->length = 0;
+    log->text[0] = '\0';
+    log->enabled = true;
+
+    nkWindow_SetDelegate(window, &testDelegate, log);
+    NK_CHECK(nkWindow_Replay(window, RECORDING_PATH, speed));
+}
+
+static void WaitFor(double seconds)
+{
+    double end = nkWindow_GetTime() + seconds;
+
+    while (nkWindow_GetTime() < end)
+    {
+        /* spin, the waits are milliseconds */
+    }
+}
+
+static void Inject(nkWindow_t *window, nkEvent_t event)
+{
+    /* a pump each, so the recording sees every event rather than the coalesced ones */
+    nkWindow_InjectEvent(window, &event);
+    nkWindow_PollEvents();
+}
+
+static void Log(nkWindow_t *window, const char *format, ...)
+{
+    nkCallbackLog_t *log = window->userData;
+
+    if (!log->enabled || log->length >= LOG_SIZE)
+    {
+        return;
+    }
+
+    va_list args;
+
+    va_start(args, format);
+    int written = vsnprintf(&log->text[log->length], LOG_SIZE - log->length, format, args);
+    va_end(args);
+
+    if (written > 0)
+    {
+        log->length += (size_t)written;
+    }
+}
+
+static void OnPointerMove(nkWindow_t *window, float x, float y)
+{
+    Log(window, "move %.4f %.4f\n", (double)x, (double)y);
+}
+
+static void OnPointerActionBegin(nkWindow_t *window, nkPointerAction_t action, float x, float y)
+{
+    Log(window, "begin %d %.4f %.4f\n", (int)action, (double)x, (double)y);
+}
+
+static void OnPointerActionEnd(nkWindow_t *window, nkPointerAction_t action, float x, float y)
+{
+    Log(window, "end %d %.4f %.4f\n", (int)action, (double)x, (double)y);
+}
+
+static void OnScroll(nkWindow_t *window, float deltaX, float deltaY)
+{
+    Log(window, "scroll %.4f %.4f\n", (double)deltaX, (double)deltaY);
+}
+
+static void OnKeyDown(nkWindow_t *window, uint32_t keycode)
+{
+    Log(window, "down %u\n", keycode);
+}
+
+static void OnKeyUp(nkWindow_t *window, uint32_t keycode)
+{
+    Log(window, "up %u\n", keycode);
+}
+
+static void OnCodepointInput(nkWindow_t *window, uint32_t codepoint)
+{
+    Log(window, "codepoint %u\n", codepoint);
+}
+
+static void OnResize(nkWindow_t *window, float width, float height)
+{
+    Log(window, "resize %.4f %.4f\n", (double)width, (double)height);
+}
@@ -0,0 +1,199 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_redraw.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - redraw requests between
+**                 frames are absorbed into one frame
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (32.0f)
+#define REQUEST_COUNT       (10U)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestAbsorb(nkWindow_t *window);
+static void TestMixed(nkWindow_t *window);
+static void TestIdle(nkWindow_t *window);
+static void TestRequestWhileDrawing(nkWindow_t *window);
+static void OnDraw(nkWindow_t *window);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static uint32_t drawCalls = 0;
+static bool redrawWhileDrawing = false;
+
+static const nkWindowDelegate_t testDelegate =
+{
+    .drawCallback = OnDraw,
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkView_t rootView;
+
+    memset(&window, 0, sizeof(window));
+    memset(&rootView, 0, sizeof(rootView));
+
+    if (!nkWindow_Create(&window, "test_redraw", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    window.rootView = &rootView;
+    nkWindow_SetDelegate(&window, &testDelegate, NULL);
+
+    /* the first frame, which every new window needs */
+    nkWindow_PollEvents();
+
+    TestAbsorb(&window);
+    TestMixed(&window);
+    TestIdle(&window);
+    TestRequestWhileDrawing(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestAbsorb(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* the first schedules a frame, the rest find it scheduled */
+    for (uint32_t i = 0; i < REQUEST_COUNT; i++)
+    {
+        nkWindow_RequestRedraw(window);
+    }
+
+    NK_CHECK(window->redrawRequested);
+
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.redrawRequests == before.redrawRequests + REQUEST_COUNT);
+    NK_CHECK(after.redrawsAbsorbed == before.redrawsAbsorbed + REQUEST_COUNT - 1U);
+    NK_CHECK(after.framesRendered == before.framesRendered + 1U);
+    NK_CHECK(!window->redrawRequested);
+}
+
+static void TestMixed(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* a damage rect schedules the frame as a whole window request does */
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 1.0f, 1.0f, 4.0f, 4.0f });
+    nkWindow_RequestRedraw(window);
+    nkWindow_RequestRedrawRect(window, (nkRect_t){ 10.0f, 1.0f, 4.0f, 4.0f });
+
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.redrawRequests == before.redrawRequests + 3U);
+    NK_CHECK(after.redrawsAbsorbed == before.redrawsAbsorbed + 2U);
+    NK_CHECK(after.framesRendered == before.framesRendered + 1U);
+}
+
+static void TestIdle(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* nothing requested, nothing drawn */
+    nkWindow_PollEvents();
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(after.framesRendered == before.framesRendered);
+}
+
+static void TestRequestWhileDrawing(nkWindow_t *window)
+{
+    if (!window->partialRedraw)
+    {
+        return; /* without GL there is no draw callback to ask from */
+    }
+
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+
+    nkWindow_GetStats(window, &before);
+
+    /* asked for during a frame, so it is not absorbed into the frame being drawn but schedules the next */
+    drawCalls = 0;
+    redrawWhileDrawing = true;
+
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    redrawWhileDrawing = false;
+
+    NK_CHECK(drawCalls == 1U);
+    NK_CHECK(window->redrawRequested);
+
+    nkWindow_PollEvents();
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(drawCalls == 2U);
+    NK_CHECK(after.framesRendered == before.framesRendered + 2U);
+    NK_CHECK(after.redrawsAbsorbed == before.redrawsAbsorbed);
+    NK_CHECK(!window->redrawRequested);
+}
+
+static void OnDraw(nkWindow_t *window)
+{
+    drawCalls++;
+
+    if (redrawWhileDrawing)
+    {
+        nkWindow_RequestRedraw(window);
+    }
+}
@@ -0,0 +1,227 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_renderthread.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - render threads draw from a
+**                 snapshot of the views, and finish every frame
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (32.0f)
+#define CHILD_COUNT         (3U)
+#define FRAME_COUNT         (10U)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestSnapshot(nkWindow_t *window);
+static void TestFinish(nkWindow_t *window);
+static void TestFramebuffer(nkWindow_t *window);
+static void OnDraw(nkWindow_t *window);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static nkView_t rootView;
+static nkView_t children[CHILD_COUNT];
+static nkView_t addedView;
+
+/* what the draw callback last saw, written on the render thread and read once it finished */
+static uint32_t drawCalls = 0;
+static nkWindow_t *drawnWindow = NULL;
+static nkView_t *drawnRoot = NULL;
+static uint32_t drawnChildCount = 0;
+static bool drawnLinksInSnapshot = false;
+static nkRect_t drawnFirstFrame;
+
+static const nkWindowDelegate_t testDelegate =
+{
+    .drawCallback = OnDraw,
+};
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+
+    memset(&window, 0, sizeof(window));
+
+    NK_CHECK(nkWindow_EnableRenderThreads());
+
+    if (!nkWindow_Create(&window, "test_renderthread", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    /* too late once a window exists */
+    NK_CHECK(!nkWindow_EnableRenderThreads());
+
+    if (window.renderThread == NULL)
+    {
+        /* without GL there is no context to hand a thread, frames are drawn inline */
+        nkWindow_Destroy(&window);
+        return NK_TEST_RESULT();
+    }
+
+    for (uint32_t i = 0; i < CHILD_COUNT; i++)
+    {
+        nkView_AddChildView(&rootView, &children[i]);
+    }
+
+    window.rootView = &rootView;
+    nkWindow_SetDelegate(&window, &testDelegate, NULL);
+    nkWindow_PollEvents();
+
+    TestSnapshot(&window);
+    TestFinish(&window);
+    TestFramebuffer(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestSnapshot(nkWindow_t *window)
+{
+    nkRect_t submitted = children[0].frame;
+
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    /* changed on the UI thread while the frame may still be drawing, which only the next frame may see */
+    children[0].frame.x += 1000.0f;
+    nkView_AddChildView(&rootView, &addedView);
+
+    nkRenderThread_Finish(window->renderThread);
+
+    NK_CHECK(drawnWindow != NULL && drawnWindow != window);
+    NK_CHECK(drawnRoot != NULL && drawnRoot != &rootView);
+    NK_CHECK(drawnChildCount == CHILD_COUNT);
+    NK_CHECK(drawnLinksInSnapshot);
+    NK_CHECK(memcmp(&drawnFirstFrame, &submitted, sizeof(nkRect_t)) == 0);
+
+    /* the next frame snapshots the tree as it is now */
+    nkWindow_SetNeedsLayout(window);
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+    nkRenderThread_Finish(window->renderThread);
+
+    NK_CHECK(drawnChildCount == CHILD_COUNT + 1U);
+}
+
+static void TestFinish(nkWindow_t *window)
+{
+    nkWindowStats_t before;
+    nkWindowStats_t after;
+    nkFrameStats_t frameStats;
+
+    nkWindow_GetStats(window, &before);
+
+    drawCalls = 0;
+
+    /* up to two frames are in flight when the loop ends, reading the stats waits them out */
+    for (uint32_t i = 0; i < FRAME_COUNT; i++)
+    {
+        nkWindow_RequestRedraw(window);
+        nkWindow_PollEvents();
+    }
+
+    nkWindow_GetStats(window, &after);
+
+    NK_CHECK(drawCalls == FRAME_COUNT);
+    NK_CHECK(after.framesRendered == before.framesRendered + FRAME_COUNT);
+
+    /* and their timing, counted by the render thread into the window's own history */
+    nkWindow_GetFrameStats(window, &frameStats);
+
+    NK_CHECK(frameStats.frameCount >= FRAME_COUNT);
+    NK_CHECK(frameStats.frames[frameStats.frameCount - 1U].phases[NK_FRAME_PHASE_PRESENT] > 0);
+
+    /* once finished, the render thread's copy is left as the last frame drew it */
+    nkWindow_t *target = nkRenderThread_Finish(window->renderThread);
+
+    NK_CHECK(target == drawnWindow);
+    NK_CHECK(target->rootView == drawnRoot);
+}
+
+static void TestFramebuffer(nkWindow_t *window)
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /* read back on the render thread, and only returned once the frame showing the change is drawn */
+    window->backgroundColor = (nkColor_t){ 0.0f, 1.0f, 0.0f, 1.0f };
+    nkWindow_RequestRedraw(window);
+    nkWindow_PollEvents();
+
+    const uint8_t *pixels = nkWindow_GetFramebuffer(window, &width, &height);
+
+    NK_CHECK(pixels != NULL);
+    NK_CHECK(width == (uint32_t)WINDOW_WIDTH && height == (uint32_t)WINDOW_HEIGHT);
+
+    if (pixels != NULL)
+    {
+        NK_CHECK(pixels[0] == 0 && pixels[1] == 255 && pixels[2] == 0);
+    }
+}
+
+static void OnDraw(nkWindow_t *window)
+{
+    drawCalls++;
+    drawnWindow = window;
+    drawnRoot = window->rootView;
+    drawnChildCount = 0;
+    drawnLinksInSnapshot = true;
+
+    if (drawnRoot == NULL)
+    {
+        return;
+    }
+
+    for (nkView_t *child = drawnRoot->child; child != NULL; child = child->sibling)
+    {
+        /* a link back into the UI thread's tree would let it change under the frame */
+        if (child->parent != drawnRoot)
+        {
+            drawnLinksInSnapshot = false;
+        }
+
+        drawnChildCount++;
+    }
+
+    if (drawnRoot->child != NULL)
+    {
+        drawnFirstFrame = drawnRoot->child->frame;
+    }
+}
@@ -0,0 +1,160 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_sharedraw.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - windows in a share group
+**                 share draw resources but not vertex arrays
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (64.0f)
+#define WINDOW_HEIGHT       (64.0f)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestSharedObjects(nkWindow_t *first, nkWindow_t *second);
+static void TestReferenceCount(nkWindow_t *first, nkWindow_t *second);
+static void CheckVertexArray(nkWindow_t *window, const nkWindow_t *first);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t first;
+    nkWindow_t second;
+
+    memset(&first, 0, sizeof(first));
+    memset(&second, 0, sizeof(second));
+
+    NK_CHECK(nkWindow_EnableSharedContexts());
+
+    if (!nkWindow_Create(&first, "test_sharedraw", WINDOW_WIDTH, WINDOW_HEIGHT) ||
+        !nkWindow_Create(&second, "test_sharedraw", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    /* too late once windows exist */
+    NK_CHECK(!nkWindow_EnableSharedContexts());
+
+    if (nkOffscreen_MakeCurrent(&first))
+    {
+        TestSharedObjects(&first, &second);
+        TestReferenceCount(&first, &second);
+    }
+    else
+    {
+        /* built without EGL, there is no group to share */
+        nkWindow_Destroy(&second);
+        nkWindow_Destroy(&first);
+    }
+
+    NK_CHECK(!nkSharedDraw_Release());
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestSharedObjects(nkWindow_t *first, nkWindow_t *second)
+{
+    /* the program was created once, under the same name in both */
+    NK_CHECK(first->drawContext.program == second->drawContext.program);
+
+    NK_CHECK(nkOffscreen_MakeCurrent(first));
+    NK_CHECK(glIsProgram(first->drawContext.program));
+    NK_CHECK(glIsVertexArray(first->drawContext.vao));
+
+    /* the second window's vertex array was made in its own context, with the first one's layout */
+    CheckVertexArray(second, first);
+}
+
+static void TestReferenceCount(nkWindow_t *first, nkWindow_t *second)
+{
+    nkDrawContext_t extra;
+
+    /* a third reference, made in the second window's context so its vertex array lives there */
+    NK_CHECK(nkOffscreen_MakeCurrent(second));
+    nkSharedDraw_Acquire(&extra);
+
+    NK_CHECK(extra.program == first->drawContext.program);
+    NK_CHECK(glIsVertexArray(extra.vao));
+    NK_CHECK(extra.vao != second->drawContext.vao);
+
+    glDeleteVertexArrays(1, &extra.vao);
+
+    /* three references, so releasing the extra one keeps the group */
+    NK_CHECK(!nkSharedDraw_Release());
+
+    nkWindow_Destroy(first);
+
+    /* the group outlives the window that created it */
+    NK_CHECK(nkOffscreen_MakeCurrent(second));
+    NK_CHECK(glIsProgram(second->drawContext.program));
+
+    /* the last window let the group go, so nothing is left to release */
+    nkWindow_Destroy(second);
+
+    NK_CHECK(!nkSharedDraw_Release());
+}
+
+static void CheckVertexArray(nkWindow_t *window, const nkWindow_t *first)
+{
+    GLint firstLayout[2][3];
+    GLint layout[2][3];
+
+    NK_CHECK(nkOffscreen_MakeCurrent((nkWindow_t *)first));
+    glBindVertexArray(first->drawContext.vao);
+
+    for (GLuint i = 0; i < 2U; i++)
+    {
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &firstLayout[i][0]);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &firstLayout[i][1]);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &firstLayout[i][2]);
+    }
+
+    glBindVertexArray(0);
+
+    NK_CHECK(nkOffscreen_MakeCurrent(window));
+    NK_CHECK(glIsVertexArray(window->drawContext.vao));
+
+    glBindVertexArray(window->drawContext.vao);
+
+    for (GLuint i = 0; i < 2U; i++)
+    {
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &layout[i][0]);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &layout[i][1]);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &layout[i][2]);
+    }
+
+    glBindVertexArray(0);
+
+    NK_CHECK(memcmp(firstLayout, layout, sizeof(layout)) == 0);
+}
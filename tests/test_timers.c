@@ -0,0 +1,227 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_timers.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - the timer heap fires in
+**                 deadline order and cancels
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define HEAP_TIMER_COUNT    (100U)      /* enough that the heap grows past its first allocation */
+#define HEAP_STEP           (0.001)     /* seconds between the heap test's deadlines */
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static uint32_t fired[HEAP_TIMER_COUNT];
+static uint32_t firedCount = 0;
+static nkTimer_t repeatingTimer = NK_TIMER_INVALID;
+static nkTimer_t oneShotTimer = NK_TIMER_INVALID;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestDeadlineOrder(void);
+static void TestHeapOrder(void);
+static void TestRepeatCancel(void);
+static void TestOneShotCancel(void);
+static void TestTimeout(void);
+static void RecordFired(void *userData);
+static void CancelOnThird(void *userData);
+static void CancelSelf(void *userData);
+static void WaitUntil(double time);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    TestDeadlineOrder();
+    TestHeapOrder();
+    TestRepeatCancel();
+    TestOneShotCancel();
+    TestTimeout();
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestDeadlineOrder(void)
+{
+    static const double intervals[] = { 0.04, 0.01, 0.03, 0.02, 0.05 };
+    nkTimer_t timers[5];
+    double start = nkWindow_GetTime();
+
+    firedCount = 0;
+
+    for (uint32_t i = 0; i < 5U; i++)
+    {
+        timers[i] = nkWindow_AddTimer(intervals[i], false, RecordFired, (void *)(uintptr_t)i);
+        NK_CHECK(timers[i] != NK_TIMER_INVALID);
+    }
+
+    NK_CHECK(nkWindow_CancelTimer(timers[2]));
+    NK_CHECK(!nkWindow_CancelTimer(timers[2]));
+
+    /* nothing is due yet */
+    nkWindow_ServiceTimers();
+    NK_CHECK(firedCount == 0);
+
+    /* all due in one service, still run earliest deadline first */
+    WaitUntil(start + 0.06);
+    nkWindow_ServiceTimers();
+
+    NK_CHECK(firedCount == 4U);
+    NK_CHECK(fired[0] == 1U && fired[1] == 3U && fired[2] == 0U && fired[3] == 4U);
+
+    /* one shot timers are gone once fired */
+    NK_CHECK(!nkWindow_CancelTimer(timers[0]));
+
+    nkWindow_ServiceTimers();
+    NK_CHECK(firedCount == 4U);
+}
+
+static void TestHeapOrder(void)
+{
+    double start = nkWindow_GetTime();
+
+    firedCount = 0;
+
+    /* 37 is coprime with the count, so the deadlines are added in a scrambled order */
+    for (uint32_t i = 0; i < HEAP_TIMER_COUNT; i++)
+    {
+        uint32_t slot = (i * 37U) % HEAP_TIMER_COUNT;
+
+        NK_CHECK(nkWindow_AddTimer(HEAP_STEP * (double)(slot + 1U), false, RecordFired, (void *)(uintptr_t)slot) != NK_TIMER_INVALID);
+    }
+
+    WaitUntil(start + HEAP_STEP * (double)(HEAP_TIMER_COUNT + 1U));
+    nkWindow_ServiceTimers();
+
+    NK_CHECK(firedCount == HEAP_TIMER_COUNT);
+
+    for (uint32_t i = 0; i < firedCount; i++)
+    {
+        NK_CHECK(fired[i] == i);
+    }
+}
+
+static void TestRepeatCancel(void)
+{
+    uint32_t calls = 0;
+    double start = nkWindow_GetTime();
+
+    /* a repeating timer that cancels itself from its own callback */
+    repeatingTimer = nkWindow_AddTimer(0.001, true, CancelOnThird, &calls);
+    NK_CHECK(repeatingTimer != NK_TIMER_INVALID);
+
+    while (nkWindow_GetTime() - start < 0.02)
+    {
+        nkWindow_ServiceTimers();
+    }
+
+    NK_CHECK(calls == 3U);
+    NK_CHECK(!nkWindow_CancelTimer(repeatingTimer));
+}
+
+static void TestOneShotCancel(void)
+{
+    uint32_t calls = 0;
+    double start = nkWindow_GetTime();
+
+    /* a one shot timer has fired by the time its callback runs, so there is nothing left to cancel */
+    oneShotTimer = nkWindow_AddTimer(0.001, false, CancelSelf, &calls);
+    NK_CHECK(oneShotTimer != NK_TIMER_INVALID);
+
+    WaitUntil(start + 0.002);
+    nkWindow_ServiceTimers();
+
+    NK_CHECK(calls == 1U);
+    NK_CHECK(!nkWindow_CancelTimer(oneShotTimer));
+}
+
+static void TestTimeout(void)
+{
+    /* with no timers a wait keeps its timeout */
+    NK_CHECK(nkWindow_GetTimerTimeout(0.5) == 0.5);
+
+    nkTimer_t timer = nkWindow_AddTimer(0.25, false, RecordFired, NULL);
+
+    /* a wait is shortened to the next deadline, including an unbounded one */
+    double timeout = nkWindow_GetTimerTimeout(0.5);
+
+    NK_CHECK(timeout > 0.0 && timeout <= 0.25);
+
+    timeout = nkWindow_GetTimerTimeout(-1.0);
+
+    NK_CHECK(timeout > 0.0 && timeout <= 0.25);
+
+    /* and a shorter one is kept */
+    NK_CHECK(nkWindow_GetTimerTimeout(0.01) == 0.01);
+
+    NK_CHECK(nkWindow_CancelTimer(timer));
+    NK_CHECK(nkWindow_GetTimerTimeout(0.5) == 0.5);
+}
+
+static void RecordFired(void *userData)
+{
+    if (firedCount < HEAP_TIMER_COUNT)
+    {
+        fired[firedCount] = (uint32_t)(uintptr_t)userData;
+    }
+
+    firedCount++;
+}
+
+static void CancelOnThird(void *userData)
+{
+    uint32_t *calls = userData;
+
+    if (++(*calls) == 3U)
+    {
+        NK_CHECK(nkWindow_CancelTimer(repeatingTimer));
+        NK_CHECK(!nkWindow_CancelTimer(repeatingTimer));
+    }
+}
+
+static void CancelSelf(void *userData)
+{
+    uint32_t *calls = userData;
+
+    (*calls)++;
+
+    NK_CHECK(!nkWindow_CancelTimer(oneShotTimer));
+}
+
+static void WaitUntil(double time)
+{
+    while (nkWindow_GetTime() < time)
+    {
+        /* spin, the deadlines are milliseconds apart */
+    }
+}
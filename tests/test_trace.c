@@ -0,0 +1,395 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_trace.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - trace rings export as
+**                 valid Chrome trace JSON
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+
+#include <nanowin.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define TRACE_PATH          "test_trace.json"
+#define TRACE_SIZE_MAX      (1024U * 1024U)
+#define EMPTY_TRACE         "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n"
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestOff(void);
+static void TestEvents(void);
+static void TestEscapes(void);
+static void TestWrap(void);
+static void TestBadPath(void);
+static bool ExportAndRead(void);
+static uint32_t CountEvents(const char *phase);
+static bool IsValidJson(const char *text);
+static const char *SkipSpace(const char *c);
+static const char *ParseValue(const char *c, uint32_t depth);
+static const char *ParseString(const char *c);
+static const char *ParseNumber(const char *c);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/* the last export, read back */
+static char trace[TRACE_SIZE_MAX];
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    /* no windows, so the only events are the ones traced here, all on this thread's ring */
+    TestOff();
+    TestEvents();
+    TestEscapes();
+    TestWrap();
+    TestBadPath();
+
+    nkWindow_SetTraceLevel(NK_TRACE_LEVEL_OFF);
+    remove(TRACE_PATH);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestOff(void)
+{
+    /* off by default, so nothing is recorded and the export is an empty but complete trace */
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_ERROR, "test", "ignored");
+    nkWindow_TraceInstant(NK_TRACE_LEVEL_ERROR, "test", "ignored");
+
+    NK_CHECK(nkWindow_TraceBegin(NK_TRACE_LEVEL_ERROR) == 0);
+    NK_CHECK(ExportAndRead());
+    NK_CHECK(strcmp(trace, EMPTY_TRACE) == 0);
+    NK_CHECK(IsValidJson(trace));
+}
+
+static void TestEvents(void)
+{
+    nkWindow_SetTraceLevel(NK_TRACE_LEVEL_INFO);
+
+    uint64_t begin = NK_TRACE_BEGIN(NK_TRACE_LEVEL_INFO);
+
+    NK_TRACE_INSTANT(NK_TRACE_LEVEL_WARNING, "test", "instant");
+
+    /* more detailed than the level set, whether or not it is compiled in */
+    nkWindow_TraceInstant(NK_TRACE_LEVEL_DEBUG, "test", "ignored");
+    NK_CHECK(nkWindow_TraceBegin(NK_TRACE_LEVEL_DEBUG) == 0);
+
+    NK_TRACE_END(NK_TRACE_LEVEL_INFO, "test", "span", begin);
+
+    NK_CHECK(ExportAndRead());
+    NK_CHECK(IsValidJson(trace));
+
+    NK_CHECK(CountEvents("\"ph\":\"i\"") == 1U);
+    NK_CHECK(CountEvents("\"ph\":\"X\"") == 1U);
+    NK_CHECK(strstr(trace, "{\"name\":\"instant\",\"cat\":\"test\",\"ph\":\"i\",\"s\":\"t\",\"ts\":") != NULL);
+    NK_CHECK(strstr(trace, "{\"name\":\"span\",\"cat\":\"test\",\"ph\":\"X\",\"ts\":") != NULL);
+    NK_CHECK(strstr(trace, "ignored") == NULL);
+
+    /* written oldest first, and the span spans the instant, so its duration is there */
+    const char *instant = strstr(trace, "\"instant\"");
+    const char *span = strstr(trace, "\"span\"");
+
+    NK_CHECK(instant != NULL && span != NULL && instant < span);
+    NK_CHECK(strstr(trace, ",\"dur\":") != NULL);
+}
+
+static void TestEscapes(void)
+{
+    /* names are written as given, so anything JSON reserves is escaped */
+    nkWindow_TraceInstant(NK_TRACE_LEVEL_ERROR, "quote\"back\\slash", "new\nline\ttab");
+    nkWindow_TraceInstant(NK_TRACE_LEVEL_ERROR, NULL, "");
+
+    NK_CHECK(ExportAndRead());
+    NK_CHECK(IsValidJson(trace));
+
+    NK_CHECK(strstr(trace, "\"cat\":\"quote\\\"back\\\\slash\"") != NULL);
+    NK_CHECK(strstr(trace, "\"name\":\"new\\u000aline\\u0009tab\"") != NULL);
+    NK_CHECK(strstr(trace, "{\"name\":\"\",\"cat\":\"\",") != NULL);
+}
+
+static void TestWrap(void)
+{
+    /* the ring keeps only the newest events, and the export is still whole */
+    for (uint32_t i = 0; i < NK_TRACE_RING_CAPACITY + 10U; i++)
+    {
+        nkWindow_TraceInstant(NK_TRACE_LEVEL_INFO, "test", "wrap");
+    }
+
+    NK_CHECK(ExportAndRead());
+    NK_CHECK(IsValidJson(trace));
+
+    /* less the oldest, whose slot is the next the thread writes and may be mid-write during an export */
+    NK_CHECK(CountEvents("\"ph\":") == NK_TRACE_RING_CAPACITY - 1U);
+    NK_CHECK(strstr(trace, "\"span\"") == NULL);
+}
+
+static void TestBadPath(void)
+{
+    NK_CHECK(!nkWindow_ExportTrace("no_such_directory/" TRACE_PATH));
+}
+
+static bool ExportAndRead(void)
+{
+    trace[0] = '\0';
+
+    if (!nkWindow_ExportTrace(TRACE_PATH))
+    {
+        return false;
+    }
+
+    FILE *file = fopen(TRACE_PATH, "rb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    size_t length = fread(trace, 1, TRACE_SIZE_MAX - 1U, file);
+
+    trace[length] = '\0';
+
+    fclose(file);
+
+    return length > 0 && length < TRACE_SIZE_MAX - 1U;
+}
+
+static uint32_t CountEvents(const char *phase)
+{
+    uint32_t count = 0;
+
+    for (const char *c = strstr(trace, phase); c != NULL; c = strstr(c + 1, phase))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+static bool IsValidJson(const char *text)
+{
+    const char *end = ParseValue(text, 0);
+
+    return end != NULL && *SkipSpace(end) == '\0';
+}
+
+static const char *SkipSpace(const char *c)
+{
+    while (*c == ' ' || *c == '\t' || *c == '\n' || *c == '\r')
+    {
+        c++;
+    }
+
+    return c;
+}
+
+static const char *ParseValue(const char *c, uint32_t depth)
+{
+    c = SkipSpace(c);
+
+    if (depth > 16U)
+    {
+        return NULL; /* a trace is never nested this deep */
+    }
+
+    if (*c == '{' || *c == '[')
+    {
+        char close = (*c == '{') ? '}' : ']';
+        bool object = (*c == '{');
+
+        c = SkipSpace(c + 1);
+
+        if (*c == close)
+        {
+            return c + 1;
+        }
+
+        for (;;)
+        {
+            if (object)
+            {
+                c = ParseString(SkipSpace(c));
+
+                if (c == NULL || *(c = SkipSpace(c)) != ':')
+                {
+                    return NULL;
+                }
+
+                c++;
+            }
+
+            c = ParseValue(c, depth + 1U);
+
+            if (c == NULL)
+            {
+                return NULL;
+            }
+
+            c = SkipSpace(c);
+
+            if (*c == close)
+            {
+                return c + 1;
+            }
+
+            if (*c != ',')
+            {
+                return NULL;
+            }
+
+            c++;
+        }
+    }
+
+    if (*c == '"')
+    {
+        return ParseString(c);
+    }
+
+    if (strncmp(c, "true", 4) == 0 || strncmp(c, "null", 4) == 0)
+    {
+        return c + 4;
+    }
+
+    if (strncmp(c, "false", 5) == 0)
+    {
+        return c + 5;
+    }
+
+    return ParseNumber(c);
+}
+
+static const char *ParseString(const char *c)
+{
+    if (*c != '"')
+    {
+        return NULL;
+    }
+
+    for (c++; *c != '"'; c++)
+    {
+        if ((unsigned char)*c < 0x20U)
+        {
+            return NULL; /* control characters have to be escaped */
+        }
+
+        if (*c == '\\')
+        {
+            c++;
+
+            if (*c == 'u')
+            {
+                for (uint32_t i = 1; i <= 4U; i++)
+                {
+                    if (strchr("0123456789abcdefABCDEF", c[i]) == NULL || c[i] == '\0')
+                    {
+                        return NULL;
+                    }
+                }
+
+                c += 4;
+            }
+            else if (*c == '\0' || strchr("\"\\/bfnrt", *c) == NULL)
+            {
+                return NULL;
+            }
+        }
+    }
+
+    return c + 1;
+}
+
+static const char *ParseNumber(const char *c)
+{
+    const char *start = c;
+
+    if (*c == '-')
+    {
+        c++;
+    }
+
+    if (*c < '0' || *c > '9')
+    {
+        return NULL;
+    }
+
+    /* no leading zeros, then an optional fraction and exponent */
+    if (*c == '0')
+    {
+        c++;
+    }
+    else
+    {
+        while (*c >= '0' && *c <= '9')
+        {
+            c++;
+        }
+    }
+
+    if (*c == '.')
+    {
+        c++;
+
+        if (*c < '0' || *c > '9')
+        {
+            return NULL;
+        }
+
+        while (*c >= '0' && *c <= '9')
+        {
+            c++;
+        }
+    }
+
+    if (*c == 'e' || *c == 'E')
+    {
+        c++;
+
+        if (*c == '+' || *c == '-')
+        {
+            c++;
+        }
+
+        if (*c < '0' || *c > '9')
+        {
+            return NULL;
+        }
+
+        while (*c >= '0' && *c <= '9')
+        {
+            c++;
+        }
+    }
+
+    return (c > start) ? c : NULL;
+}
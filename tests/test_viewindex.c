@@ -0,0 +1,261 @@
+/***************************************************************
+**
+** NanoKit Test Source File
+**
+** File         :  test_viewindex.c
+** Module       :  nanowin
+** Author       :  SH
+** Created      :  2026-10-17 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  NanoKit Window API - the view index finds the
+**                 same view a full walk of the tree does
+**
+***************************************************************/
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include "nktest.h"
+#include "nanowin_internal.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define WINDOW_WIDTH        (640.0f)
+#define WINDOW_HEIGHT       (480.0f)
+#define POINT_COUNT         (4000U)
+#define VIEW_COUNT_MAX      (1000U)
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void TestRandomTree(nkViewIndex_t *index, uint32_t viewCount);
+static void TestEdges(nkViewIndex_t *index);
+static void TestNotBuilt(nkViewIndex_t *index);
+static void TestWindow(nkWindow_t *window);
+static void BuildTree(uint32_t viewCount);
+static uint32_t CountMismatches(nkViewIndex_t *index, float x, float y);
+static nkView_t *FindView(nkView_t *root, float x, float y);
+static bool Contains(nkRect_t frame, float x, float y);
+static float RandomFloat(float min, float max);
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static nkView_t views[VIEW_COUNT_MAX];
+static uint32_t randomState = 1U;
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(void)
+{
+    nkWindow_t window;
+    nkViewIndex_t *index = nkViewIndex_Create();
+
+    if (index == NULL)
+    {
+        fprintf(stderr, "Failed to create a view index!\n");
+        return EXIT_FAILURE;
+    }
+
+    /* one view, a cell's worth, and enough for a fine grid, all into the same index */
+    TestRandomTree(index, 1U);
+    TestRandomTree(index, 10U);
+    TestRandomTree(index, VIEW_COUNT_MAX);
+    TestEdges(index);
+    TestNotBuilt(index);
+
+    nkViewIndex_Destroy(index);
+
+    memset(&window, 0, sizeof(window));
+
+    if (!nkWindow_Create(&window, "test_viewindex", WINDOW_WIDTH, WINDOW_HEIGHT))
+    {
+        fprintf(stderr, "Failed to create a headless window!\n");
+        return EXIT_FAILURE;
+    }
+
+    TestWindow(&window);
+
+    nkWindow_Destroy(&window);
+
+    return NK_TEST_RESULT();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void TestRandomTree(nkViewIndex_t *index, uint32_t viewCount)
+{
+    BuildTree(viewCount);
+
+    NK_CHECK(nkViewIndex_Build(index, &views[0], WINDOW_WIDTH, WINDOW_HEIGHT));
+
+    uint32_t mismatches = 0;
+
+    for (uint32_t i = 0; i < POINT_COUNT; i++)
+    {
+        mismatches += CountMismatches(index, RandomFloat(0.0f, WINDOW_WIDTH), RandomFloat(0.0f, WINDOW_HEIGHT));
+    }
+
+    /* on the edges, where a view ends and the next begins */
+    for (uint32_t i = 0; i < viewCount; i++)
+    {
+        nkRect_t frame = views[i].frame;
+
+        mismatches += CountMismatches(index, frame.x, frame.y);
+        mismatches += CountMismatches(index, frame.x + frame.width, frame.y + frame.height);
+        mismatches += CountMismatches(index, frame.x + frame.width * 0.5f, frame.y + frame.height);
+    }
+
+    NK_CHECK(mismatches == 0);
+}
+
+static void TestEdges(nkViewIndex_t *index)
+{
+    BuildTree(3U);
+
+    /* the root filling the window, a child hanging off its far corner, and one wholly outside it */
+    views[0].frame = (nkRect_t){ 0.0f, 0.0f, WINDOW_WIDTH, WINDOW_HEIGHT };
+    views[1].frame = (nkRect_t){ WINDOW_WIDTH - 10.0f, WINDOW_HEIGHT - 10.0f, 100.0f, 100.0f };
+    views[2].frame = (nkRect_t){ -100.0f, -100.0f, 50.0f, 50.0f };
+
+    NK_CHECK(nkViewIndex_Build(index, &views[0], WINDOW_WIDTH, WINDOW_HEIGHT));
+
+    NK_CHECK(nkViewIndex_Find(index, &views[0], WINDOW_WIDTH - 1.0f, WINDOW_HEIGHT - 1.0f) == &views[1]);
+    NK_CHECK(nkViewIndex_Find(index, &views[0], WINDOW_WIDTH - 11.0f, WINDOW_HEIGHT - 1.0f) == &views[0]);
+    NK_CHECK(nkViewIndex_Find(index, &views[0], 0.0f, 0.0f) == &views[0]);
+
+    /* off the window there is nothing indexed to answer with */
+    NK_CHECK(nkViewIndex_Find(index, &views[0], WINDOW_WIDTH, 1.0f) == NULL);
+    NK_CHECK(nkViewIndex_Find(index, &views[0], -80.0f, -80.0f) == NULL);
+
+    /* a root that misses the point is all the walk can return */
+    views[0].frame = (nkRect_t){ 100.0f, 100.0f, 10.0f, 10.0f };
+    views[1].frame = (nkRect_t){ 0.0f, 0.0f, 50.0f, 50.0f };
+
+    NK_CHECK(nkViewIndex_Build(index, &views[0], WINDOW_WIDTH, WINDOW_HEIGHT));
+    NK_CHECK(nkViewIndex_Find(index, &views[0], 10.0f, 10.0f) == &views[0]);
+}
+
+static void TestNotBuilt(nkViewIndex_t *index)
+{
+    BuildTree(2U);
+
+    NK_CHECK(nkViewIndex_Build(index, &views[0], WINDOW_WIDTH, WINDOW_HEIGHT));
+
+    /* built for another tree, or for nothing, it leaves the walk to the caller */
+    NK_CHECK(nkViewIndex_Find(index, &views[1], 1.0f, 1.0f) == NULL);
+    NK_CHECK(!nkViewIndex_Build(index, NULL, WINDOW_WIDTH, WINDOW_HEIGHT));
+    NK_CHECK(nkViewIndex_Find(index, &views[0], 1.0f, 1.0f) == NULL);
+    NK_CHECK(!nkViewIndex_Build(index, &views[0], 0.0f, WINDOW_HEIGHT));
+    NK_CHECK(nkViewIndex_Find(NULL, &views[0], 1.0f, 1.0f) == NULL);
+}
+
+static void TestWindow(nkWindow_t *window)
+{
+    BuildTree(VIEW_COUNT_MAX);
+
+    /* laid out by the window this time, and reached through pointer moves */
+    window->rootView = &views[0];
+    nkWindow_SetNeedsLayout(window);
+    nkWindow_PollEvents();
+
+    uint32_t mismatches = 0;
+
+    for (uint32_t i = 0; i < POINT_COUNT / 4U; i++)
+    {
+        nkEvent_t move = { .type = NK_EVENT_POINTER_MOVE, .pointer = { RandomFloat(0.0f, WINDOW_WIDTH), RandomFloat(0.0f, WINDOW_HEIGHT) } };
+
+        nkWindow_InjectEvent(window, &move);
+        nkWindow_PollEvents();
+
+        if (window->hotView != FindView(&views[0], move.pointer.x, move.pointer.y))
+        {
+            mismatches++;
+        }
+    }
+
+    NK_CHECK(mismatches == 0);
+
+    window->rootView = NULL;
+}
+
+static void BuildTree(uint32_t viewCount)
+{
+    memset(views, 0, sizeof(views));
+
+    views[0].frame = (nkRect_t){ 0.0f, 0.0f, WINDOW_WIDTH, WINDOW_HEIGHT };
+
+    /* each view under any one before it, anywhere, some reaching past their parent or the window */
+    for (uint32_t i = 1; i < viewCount; i++)
+    {
+        float width = RandomFloat(0.0f, WINDOW_WIDTH * 0.3f);
+        float height = RandomFloat(0.0f, WINDOW_HEIGHT * 0.3f);
+
+        views[i].frame = (nkRect_t){ RandomFloat(-0.1f * WINDOW_WIDTH, WINDOW_WIDTH), RandomFloat(-0.1f * WINDOW_HEIGHT, WINDOW_HEIGHT), width, height };
+
+        nkView_AddChildView(&views[(uint32_t)RandomFloat(0.0f, (float)i)], &views[i]);
+    }
+}
+
+static uint32_t CountMismatches(nkViewIndex_t *index, float x, float y)
+{
+    if (x < 0.0f || y < 0.0f || x >= WINDOW_WIDTH || y >= WINDOW_HEIGHT)
+    {
+        return (nkViewIndex_Find(index, &views[0], x, y) == NULL) ? 0U : 1U;
+    }
+
+    return (nkViewIndex_Find(index, &views[0], x, y) == FindView(&views[0], x, y)) ? 0U : 1U;
+}
+
+static nkView_t *FindView(nkView_t *root, float x, float y)
+{
+    if (!Contains(root->frame, x, y))
+    {
+        return root;
+    }
+
+    /* into the first child holding the point, as the index promises to */
+    for (nkView_t *view = root; ;)
+    {
+        nkView_t *child = view->child;
+
+        while (child != NULL && !Contains(child->frame, x, y))
+        {
+            child = child->sibling;
+        }
+
+        if (child == NULL)
+        {
+            return view;
+        }
+
+        view = child;
+    }
+}
+
+static bool Contains(nkRect_t frame, float x, float y)
+{
+    return x >= frame.x && x < frame.x + frame.width && y >= frame.y && y < frame.y + frame.height;
+}
+
+static float RandomFloat(float min, float max)
+{
+    /* a fixed sequence, so a mismatch comes back on every run */
+    randomState = randomState * 1103515245U + 12345U;
+
+    return min + (max - min) * (float)((randomState >> 8) & 0xFFFFU) / 65536.0f;
+}